@@ -0,0 +1,393 @@
+#include "arrow_column.hpp"
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace mc {
+
+    namespace impl {
+        /// Exported data, shared by every node of an exported array
+        struct arrow_export_ {
+            money_column column;
+            std::vector<std::uint64_t> decimals; ///< Two little-endian words per decimal128 amount
+        };
+
+        /// Codes of all known currencies as the buffers of an Arrow UTF-8 array
+        struct arrow_codes_ {
+            std::int32_t offsets[max_currency_count + 1];
+            char data[max_currency_count * 3];
+            std::size_t size;  ///< Number of codes filled in
+            std::mutex mutex;  ///< Serializes appending codes
+        };
+
+        /**
+         * Gets the code table, first appending the currencies registered
+         * since the last export. Entries are never rewritten, so arrays
+         * exported earlier keep reading their shorter prefix safely.
+         */
+        const arrow_codes_& arrow_codes_table_(std::size_t known) {
+            static arrow_codes_ table;
+            std::lock_guard<std::mutex> lock(table.mutex);
+            for (; table.size < known; ++table.size) {
+                std::memcpy(table.data + table.size * 3, to_code(static_cast<currency>(table.size)).data(), 3);
+                table.offsets[table.size + 1] = static_cast<std::int32_t>((table.size + 1) * 3);
+            }
+            return table;
+        }
+
+        /// Storage of one exported array and its children, owned through private_data
+        struct arrow_array_node_ {
+            std::shared_ptr<const arrow_export_> data;
+            const void* buffers[3];
+            ArrowArray* child_pointers[2];
+            ArrowArray children[2];
+            ArrowArray dictionary;
+        };
+
+        /// Storage of one exported schema and its children, owned through private_data
+        struct arrow_schema_node_ {
+            ArrowSchema* child_pointers[2];
+            ArrowSchema children[2];
+            ArrowSchema dictionary;
+        };
+
+        void release_array_(ArrowArray* array) {
+            for (std::int64_t i = 0; i < array->n_children; ++i) {
+                if (array->children[i]->release != nullptr) {
+                    array->children[i]->release(array->children[i]);
+                }
+            }
+            if (array->dictionary != nullptr && array->dictionary->release != nullptr) {
+                array->dictionary->release(array->dictionary);
+            }
+            delete static_cast<arrow_array_node_*>(array->private_data);
+            array->release = nullptr;
+        }
+
+        void release_schema_(ArrowSchema* schema) {
+            for (std::int64_t i = 0; i < schema->n_children; ++i) {
+                if (schema->children[i]->release != nullptr) {
+                    schema->children[i]->release(schema->children[i]);
+                }
+            }
+            if (schema->dictionary != nullptr && schema->dictionary->release != nullptr) {
+                schema->dictionary->release(schema->dictionary);
+            }
+            delete static_cast<arrow_schema_node_*>(schema->private_data);
+            schema->release = nullptr;
+        }
+
+        arrow_array_node_* init_array_(ArrowArray& array, std::shared_ptr<const arrow_export_> data,
+                std::size_t length, std::int64_t buffers, std::int64_t children) {
+            arrow_array_node_* node = new arrow_array_node_{};
+            node->data = std::move(data);
+            node->child_pointers[0] = &node->children[0];
+            node->child_pointers[1] = &node->children[1];
+            array = ArrowArray{static_cast<std::int64_t>(length), 0, 0, buffers, children, node->buffers,
+                children > 0 ? node->child_pointers : nullptr, nullptr, release_array_, node};
+            return node;
+        }
+
+        arrow_schema_node_* init_schema_(ArrowSchema& schema, const char* format, const char* name, std::int64_t children) {
+            arrow_schema_node_* node = new arrow_schema_node_{};
+            node->child_pointers[0] = &node->children[0];
+            node->child_pointers[1] = &node->children[1];
+            schema = ArrowSchema{format, name, nullptr, 0, children,
+                children > 0 ? node->child_pointers : nullptr, nullptr, release_schema_, node};
+            return node;
+        }
+
+        /// Checks for a "d:precision,2" or "d:precision,2,128" format, a decimal128 of cents
+        bool is_cents_decimal_(std::string_view format) noexcept {
+            if (format.substr(0, 2) != "d:") {
+                return false;
+            }
+            std::size_t i = 2;
+            while (i < format.size() && format[i] >= '0' && format[i] <= '9') {
+                ++i;
+            }
+            const std::string_view rest = format.substr(i);
+            return i > 2 && (rest == ",2" || rest == ",2,128");
+        }
+
+        [[noreturn]] void unsupported_(const std::string& reason) {
+            throw std::invalid_argument("unsupported arrow money column: " + reason);
+        }
+
+        bool has_nulls_(const ArrowArray& array) noexcept {
+            return array.n_buffers > 0 && array.buffers[0] != nullptr && array.null_count != 0;
+        }
+
+        template<typename T>
+        T load_(const void* data, std::size_t index) noexcept {
+            T value;
+            std::memcpy(&value, static_cast<const char*>(data) + index * sizeof (T), sizeof (T));
+            return value;
+        }
+
+        /// Translates dictionary indices of type T into currency indices
+        template<typename T>
+        void translate_(const void* indices, std::size_t first, std::size_t count,
+                const std::vector<std::uint8_t>& dictionary, std::uint8_t* out) {
+            for (std::size_t i = 0; i < count; ++i) {
+                const T index = load_<T>(indices, first + i);
+                if (index < 0 || static_cast<std::uint64_t>(index) >= dictionary.size()) {
+                    unsupported_("currency index out of range");
+                }
+                out[i] = dictionary[static_cast<std::size_t>(index)];
+            }
+        }
+
+        /// Translates unsigned dictionary indices of type T into currency indices
+        template<typename T>
+        void translate_unsigned_(const void* indices, std::size_t first, std::size_t count,
+                const std::vector<std::uint8_t>& dictionary, std::uint8_t* out) {
+            for (std::size_t i = 0; i < count; ++i) {
+                const T index = load_<T>(indices, first + i);
+                if (index >= dictionary.size()) {
+                    unsupported_("currency index out of range");
+                }
+                out[i] = dictionary[index];
+            }
+        }
+
+        /// Resolves the currency codes of a UTF-8 dictionary, with 32-bit or 64-bit offsets
+        template<typename Offset>
+        std::vector<std::uint8_t> resolve_dictionary_(const ArrowArray& dictionary) {
+            if (dictionary.n_buffers != 3 || has_nulls_(dictionary)) {
+                unsupported_("currency dictionary must be UTF-8 strings without nulls");
+            }
+            std::vector<std::uint8_t> result(static_cast<std::size_t>(dictionary.length));
+            const char* data = static_cast<const char*>(dictionary.buffers[2]);
+            for (std::size_t i = 0; i < result.size(); ++i) {
+                const std::size_t entry = static_cast<std::size_t>(dictionary.offset) + i;
+                const Offset begin = load_<Offset>(dictionary.buffers[1], entry);
+                const Offset end = load_<Offset>(dictionary.buffers[1], entry + 1);
+                mc::currency c;
+                if (end < begin || !find_currency(std::string_view(data + begin, static_cast<std::size_t>(end - begin)), c)) {
+                    unsupported_("unknown currency code in dictionary");
+                }
+                result[i] = static_cast<std::uint8_t>(c);
+            }
+            return result;
+        }
+    }
+
+    void export_arrow(money_column column, ArrowSchema* schema, ArrowArray* array, arrow_amount amounts) {
+        const bool decimal = amounts == arrow_amount::decimal128;
+        auto data = std::make_shared<impl::arrow_export_>();
+        data->column = std::move(column);
+        const std::size_t length = data->column.size();
+        if (decimal) {
+            data->decimals.resize(length * 2);
+            for (std::size_t i = 0; i < length; ++i) {
+                const std::int64_t amount = data->column.amount(i);
+                data->decimals[i * 2] = static_cast<std::uint64_t>(amount);
+                data->decimals[i * 2 + 1] = amount < 0 ? ~std::uint64_t(0) : 0;
+            }
+        }
+        const std::size_t known = known_currency_count();
+        const impl::arrow_codes_& codes = impl::arrow_codes_table_(known);
+
+        impl::arrow_schema_node_* types = impl::init_schema_(*schema, "+s", "", 2);
+        try {
+            impl::init_schema_(types->children[0], decimal ? "d:19,2" : "l", "amount", 0);
+            impl::arrow_schema_node_* currency_type = impl::init_schema_(types->children[1], "C", "currency", 0);
+            impl::init_schema_(currency_type->dictionary, "u", "", 0);
+            types->children[1].dictionary = &currency_type->dictionary;
+        } catch (...) {
+            schema->release(schema);
+            throw;
+        }
+
+        impl::arrow_array_node_* root = impl::init_array_(*array, data, length, 1, 2);
+        try {
+            impl::arrow_array_node_* amount_node = impl::init_array_(root->children[0], data, length, 2, 0);
+            amount_node->buffers[1] = decimal
+                    ? static_cast<const void*>(data->decimals.data())
+                    : static_cast<const void*>(data->column.amounts());
+            impl::arrow_array_node_* currency_node = impl::init_array_(root->children[1], data, length, 2, 0);
+            currency_node->buffers[1] = data->column.currencies();
+            impl::arrow_array_node_* codes_node = impl::init_array_(currency_node->dictionary, nullptr, known, 3, 0);
+            codes_node->buffers[1] = codes.offsets;
+            codes_node->buffers[2] = codes.data;
+            root->children[1].dictionary = &currency_node->dictionary;
+        } catch (...) {
+            array->release(array);
+            schema->release(schema);
+            throw;
+        }
+    }
+
+    arrow_column::arrow_column(ArrowSchema* schema, ArrowArray* array) :
+    _schema(*schema), _array(*array), _size(0), _amounts(nullptr), _currencies(nullptr) {
+        schema->release = nullptr;
+        array->release = nullptr;
+        try {
+            if (_schema.release == nullptr || _array.release == nullptr) {
+                impl::unsupported_("released structures");
+            }
+            if (std::strcmp(_schema.format, "+s") != 0 || _schema.n_children != _array.n_children || impl::has_nulls_(_array)) {
+                impl::unsupported_("expected a struct array without nulls");
+            }
+            const ArrowSchema* amount_type = nullptr;
+            const ArrowSchema* currency_type = nullptr;
+            const ArrowArray* amount_data = nullptr;
+            const ArrowArray* currency_data = nullptr;
+            for (std::int64_t i = 0; i < _schema.n_children; ++i) {
+                const char* name = _schema.children[i]->name;
+                if (name != nullptr && std::strcmp(name, "amount") == 0) {
+                    amount_type = _schema.children[i];
+                    amount_data = _array.children[i];
+                } else if (name != nullptr && std::strcmp(name, "currency") == 0) {
+                    currency_type = _schema.children[i];
+                    currency_data = _array.children[i];
+                }
+            }
+            if (amount_type == nullptr || currency_type == nullptr) {
+                impl::unsupported_("expected amount and currency fields");
+            }
+            _size = static_cast<std::size_t>(_array.length);
+            const std::size_t first = static_cast<std::size_t>(_array.offset);
+            if (amount_data->length < _array.offset + _array.length || currency_data->length < _array.offset + _array.length) {
+                impl::unsupported_("fields shorter than the struct");
+            }
+
+            // amounts: int64 in place, or decimal128 with scale 2 converted
+            if (impl::has_nulls_(*amount_data) || amount_data->n_buffers != 2) {
+                impl::unsupported_("amounts must be a primitive array without nulls");
+            }
+            const std::size_t amount_first = first + static_cast<std::size_t>(amount_data->offset);
+            const std::string_view amount_format(amount_type->format);
+            if (amount_format == "l") {
+                const std::int64_t* amounts = static_cast<const std::int64_t*>(amount_data->buffers[1]) + amount_first;
+                if (reinterpret_cast<std::uintptr_t>(amounts) % alignof(std::int64_t) == 0) {
+                    _amounts = amounts;
+                } else {
+                    _converted_amounts.resize(_size);
+                    std::memcpy(_converted_amounts.data(), amounts, _size * sizeof (std::int64_t));
+                    _amounts = _converted_amounts.data();
+                }
+            } else if (impl::is_cents_decimal_(amount_format)) {
+                _converted_amounts.resize(_size);
+                for (std::size_t i = 0; i < _size; ++i) {
+                    const std::uint64_t low = impl::load_<std::uint64_t>(amount_data->buffers[1], (amount_first + i) * 2);
+                    const std::uint64_t high = impl::load_<std::uint64_t>(amount_data->buffers[1], (amount_first + i) * 2 + 1);
+                    if (high != (low >> 63 ? ~std::uint64_t(0) : 0)) {
+                        throw std::overflow_error("decimal amount does not fit into 64 bits");
+                    }
+                    _converted_amounts[i] = static_cast<std::int64_t>(low);
+                }
+                _amounts = _converted_amounts.data();
+            } else {
+                impl::unsupported_("amounts must be int64 or decimal128 with scale 2");
+            }
+
+            // currencies: dictionary indices, in place when they already are currency indices
+            if (currency_type->dictionary == nullptr || currency_data->dictionary == nullptr
+                    || impl::has_nulls_(*currency_data) || currency_data->n_buffers != 2) {
+                impl::unsupported_("currencies must be dictionary-encoded without nulls");
+            }
+            const std::string_view dictionary_format(currency_type->dictionary->format);
+            std::vector<std::uint8_t> dictionary;
+            if (dictionary_format == "u") {
+                dictionary = impl::resolve_dictionary_<std::int32_t>(*currency_data->dictionary);
+            } else if (dictionary_format == "U") {
+                dictionary = impl::resolve_dictionary_<std::int64_t>(*currency_data->dictionary);
+            } else {
+                impl::unsupported_("currency dictionary must be UTF-8 strings");
+            }
+            const std::size_t currency_first = first + static_cast<std::size_t>(currency_data->offset);
+            const void* indices = currency_data->buffers[1];
+            const std::string_view index_format(currency_type->format);
+
+            bool in_place = index_format == "C";
+            for (std::size_t i = 0; in_place && i < dictionary.size(); ++i) {
+                in_place = dictionary[i] == i;
+            }
+            if (in_place) {
+                const std::uint8_t* currencies = static_cast<const std::uint8_t*>(indices) + currency_first;
+                std::uint8_t largest = 0;
+                for (std::size_t i = 0; i < _size; ++i) {
+                    largest = currencies[i] > largest ? currencies[i] : largest;
+                }
+                if (_size > 0 && largest >= dictionary.size()) {
+                    impl::unsupported_("currency index out of range");
+                }
+                _currencies = currencies;
+            } else {
+                _converted_currencies.resize(_size);
+                std::uint8_t* out = _converted_currencies.data();
+                if (index_format == "c") {
+                    impl::translate_<std::int8_t>(indices, currency_first, _size, dictionary, out);
+                } else if (index_format == "C") {
+                    impl::translate_unsigned_<std::uint8_t>(indices, currency_first, _size, dictionary, out);
+                } else if (index_format == "s") {
+                    impl::translate_<std::int16_t>(indices, currency_first, _size, dictionary, out);
+                } else if (index_format == "S") {
+                    impl::translate_unsigned_<std::uint16_t>(indices, currency_first, _size, dictionary, out);
+                } else if (index_format == "i") {
+                    impl::translate_<std::int32_t>(indices, currency_first, _size, dictionary, out);
+                } else if (index_format == "I") {
+                    impl::translate_unsigned_<std::uint32_t>(indices, currency_first, _size, dictionary, out);
+                } else if (index_format == "l") {
+                    impl::translate_<std::int64_t>(indices, currency_first, _size, dictionary, out);
+                } else if (index_format == "L") {
+                    impl::translate_unsigned_<std::uint64_t>(indices, currency_first, _size, dictionary, out);
+                } else {
+                    impl::unsupported_("currency indices must be integers");
+                }
+                _currencies = out;
+            }
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+
+    arrow_column::~arrow_column() {
+        release();
+    }
+
+    void arrow_column::release() noexcept {
+        if (_array.release != nullptr) {
+            _array.release(&_array);
+        }
+        if (_schema.release != nullptr) {
+            _schema.release(&_schema);
+        }
+    }
+
+    std::size_t arrow_column::size() const noexcept {
+        return _size;
+    }
+
+    const std::int64_t* arrow_column::amounts() const noexcept {
+        return _amounts;
+    }
+
+    const std::uint8_t* arrow_column::currencies() const noexcept {
+        return _currencies;
+    }
+
+    std::int64_t arrow_column::amount(std::size_t index) const noexcept {
+        return _amounts[index];
+    }
+
+    mc::currency arrow_column::currency(std::size_t index) const noexcept {
+        return static_cast<mc::currency>(_currencies[index]);
+    }
+
+    void arrow_column::to_column(money_column& out) const {
+        const std::size_t first = out.size();
+        out.resize(first + _size);
+        if (_size > 0) {
+            std::memcpy(out.amounts() + first, _amounts, _size * sizeof (std::int64_t));
+            std::memcpy(out.currencies() + first, _currencies, _size);
+        }
+    }
+}
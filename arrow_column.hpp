@@ -0,0 +1,177 @@
+/**
+ * @file arrow_column.hpp
+ * @brief Exchange of money columns through the Arrow C Data Interface.
+ *
+ * A money column is exported as an Arrow struct array with two children:
+ * "amount", holding the amounts in smallest currency units as int64 (or as
+ * decimal128 with scale 2), and "currency", dictionary-encoded as uint8
+ * indices into the codes of all known currencies. The int64 amounts and the
+ * currency indices are handed out without copying. Only the ArrowSchema and
+ * ArrowArray structures of the interface are used, the library does not
+ * depend on Arrow.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef ARROW_COLUMN_HPP
+#define ARROW_COLUMN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "money_column.hpp"
+
+extern "C" {
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+    /**
+     * @brief Type description of an Arrow array, as defined by the Arrow C Data Interface.
+     */
+    struct ArrowSchema {
+        const char* format;
+        const char* name;
+        const char* metadata;
+        int64_t flags;
+        int64_t n_children;
+        struct ArrowSchema** children;
+        struct ArrowSchema* dictionary;
+        void (*release)(struct ArrowSchema*);
+        void* private_data;
+    };
+
+    /**
+     * @brief Data of an Arrow array, as defined by the Arrow C Data Interface.
+     */
+    struct ArrowArray {
+        int64_t length;
+        int64_t null_count;
+        int64_t offset;
+        int64_t n_buffers;
+        int64_t n_children;
+        const void** buffers;
+        struct ArrowArray** children;
+        struct ArrowArray* dictionary;
+        void (*release)(struct ArrowArray*);
+        void* private_data;
+    };
+
+#endif /* ARROW_C_DATA_INTERFACE */
+
+}
+
+namespace mc {
+
+    /**
+     * @brief Arrow type of exported amounts.
+     */
+    enum class arrow_amount : std::uint8_t {
+        int64,     ///< 64-bit integers in smallest currency units, shared without copying
+        decimal128 ///< 128-bit decimals with precision 19 and scale 2, converted on export
+    };
+
+    /**
+     * @brief Exports a money column as an Arrow struct array.
+     *
+     * The column is moved into the exported array, which keeps it alive
+     * until the consumer calls the release callbacks, so its buffers are
+     * shared without copying. Every child can be moved out and released
+     * independently.
+     *
+     * @param column The column to export, pass it with std::move to avoid a copy
+     * @param schema Receives the type description
+     * @param array Receives the data
+     * @param amounts Arrow type of the amounts
+     */
+    void export_arrow(money_column column, ArrowSchema* schema, ArrowArray* array, arrow_amount amounts = arrow_amount::int64);
+
+    /**
+     * @brief A money column imported from the Arrow C Data Interface.
+     *
+     * Takes ownership of an Arrow struct array with an "amount" child of
+     * type int64 or decimal128 with scale 2, and a dictionary-encoded
+     * "currency" child with integer indices into UTF-8 currency codes. The
+     * amounts are read in place when they are int64, and the currency
+     * indices are read in place when they are 8-bit and the dictionary lists
+     * the currencies in enum order, as export_arrow() does; other layouts
+     * are converted once on import.
+     */
+    class arrow_column {
+        ArrowSchema _schema;                      ///< Owned type description
+        ArrowArray _array;                        ///< Owned data
+        std::size_t _size;                        ///< Number of values
+        const std::int64_t* _amounts;             ///< Amounts, in place or in _converted_amounts
+        const std::uint8_t* _currencies;          ///< Currency indices, in place or in _converted_currencies
+        std::vector<std::int64_t> _converted_amounts;    ///< Amounts converted from decimals
+        std::vector<std::uint8_t> _converted_currencies; ///< Currency indices translated through the dictionary
+
+        void release() noexcept;
+    public:
+        /**
+         * @brief Takes ownership of an exported Arrow struct array.
+         *
+         * The source structures are marked released. They are released by
+         * the destructor, or before throwing if the layout is not supported.
+         *
+         * @param schema The type description
+         * @param array The data
+         * @throws std::invalid_argument if the layout is not a money column or holds nulls
+         * @throws std::overflow_error if a decimal amount does not fit into 64 bits
+         */
+        arrow_column(ArrowSchema* schema, ArrowArray* array);
+
+        arrow_column(const arrow_column&) = delete;
+        arrow_column& operator=(const arrow_column&) = delete;
+
+        /**
+         * @brief Releases the Arrow structures.
+         */
+        ~arrow_column();
+
+        /**
+         * @brief Gets the number of values.
+         * @return The number of values
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * @brief Gets the amount array.
+         * @return Pointer to the first amount
+         */
+        const std::int64_t* amounts() const noexcept;
+
+        /**
+         * @brief Gets the currency index array.
+         * @return Pointer to the currency index of the first value
+         */
+        const std::uint8_t* currencies() const noexcept;
+
+        /**
+         * @brief Gets the amount of a value.
+         * @param index Index of the value
+         * @return The amount in smallest currency units
+         */
+        std::int64_t amount(std::size_t index) const noexcept;
+
+        /**
+         * @brief Gets the currency of a value.
+         * @param index Index of the value
+         * @return The currency
+         */
+        mc::currency currency(std::size_t index) const noexcept;
+
+        /**
+         * @brief Copies the values into a money column.
+         * @param out Receives the values, appended to its current contents
+         */
+        void to_column(money_column& out) const;
+    };
+}
+
+#endif /* ARROW_COLUMN_HPP */
@@ -0,0 +1,74 @@
+#include "atomic_money.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+namespace mc {
+
+    atomic_money::atomic_money(mc::currency c) noexcept :
+    _amount(0), _currency(c) {
+
+    }
+
+    atomic_money::atomic_money(const money& m) :
+    _amount(0), _currency(m.currency()) {
+        if (m.amount() > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+            throw std::overflow_error("amount does not fit into atomic_money");
+        }
+        _amount.store(static_cast<std::int64_t>(m.amount()), std::memory_order_relaxed);
+    }
+
+    mc::currency atomic_money::currency() const noexcept {
+        return _currency;
+    }
+
+    std::int64_t atomic_money::amount() const noexcept {
+        return _amount.load(std::memory_order_acquire);
+    }
+
+    money atomic_money::load() const {
+        const std::int64_t value = amount();
+        if (value < 0) {
+            throw std::logic_error("negative balance!");
+        }
+        return money::from_amount(_currency, static_cast<std::uint64_t>(value));
+    }
+
+    std::int64_t atomic_money::fetch_add(std::int64_t delta) noexcept {
+        return _amount.fetch_add(delta, std::memory_order_acq_rel);
+    }
+
+    std::int64_t atomic_money::fetch_add(const money& m) {
+        if (_currency != m.currency()) {
+            throw std::logic_error("incompatible currencies!");
+        }
+        if (m.amount() > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+            throw std::overflow_error("amount does not fit into atomic_money");
+        }
+        return fetch_add(static_cast<std::int64_t>(m.amount()));
+    }
+
+    bool atomic_money::try_debit(std::uint64_t amount, std::int64_t floor) noexcept {
+        std::int64_t current = _amount.load(std::memory_order_relaxed);
+        do {
+            if (current < floor) {
+                return false;
+            }
+            // current - floor fits into an unsigned value even when floor is negative
+            const std::uint64_t available = static_cast<std::uint64_t>(current) - static_cast<std::uint64_t>(floor);
+            if (amount > available) {
+                return false;
+            }
+        } while (!_amount.compare_exchange_weak(current,
+                static_cast<std::int64_t>(static_cast<std::uint64_t>(current) - amount),
+                std::memory_order_acq_rel, std::memory_order_relaxed));
+        return true;
+    }
+
+    bool atomic_money::try_debit(const money& m, std::int64_t floor) {
+        if (_currency != m.currency()) {
+            throw std::logic_error("incompatible currencies!");
+        }
+        return try_debit(m.amount(), floor);
+    }
+}
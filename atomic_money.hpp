@@ -0,0 +1,102 @@
+/**
+ * @file atomic_money.hpp
+ * @brief Lock-free monetary balance for concurrent updates.
+ *
+ * The amount is kept in a single std::atomic<std::int64_t> of smallest
+ * currency units and the currency is fixed at construction, so balances
+ * shared between threads can be updated without a mutex.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef ATOMIC_MONEY_HPP
+#define ATOMIC_MONEY_HPP
+
+#include <atomic>
+#include <cstdint>
+#include "money.hpp"
+
+namespace mc {
+
+    /**
+     * @brief A monetary balance that can be updated concurrently without locks.
+     *
+     * All operations are linearizable. The balance may only become negative
+     * when try_debit() is given a negative floor (an overdraft limit).
+     */
+    class atomic_money {
+        std::atomic<std::int64_t> _amount; ///< Balance in smallest currency units
+        const mc::currency _currency;      ///< Currency fixed at construction
+    public:
+        /**
+         * @brief Constructs a zero balance in the specified currency.
+         * @param curr The currency of the balance
+         */
+        explicit atomic_money(mc::currency curr) noexcept;
+
+        /**
+         * @brief Constructs a balance from a money object.
+         * @param initial The initial balance, its currency becomes the balance currency
+         * @throws std::overflow_error if the amount does not fit into a signed 64-bit value
+         */
+        explicit atomic_money(const money& initial);
+
+        atomic_money(const atomic_money&) = delete;
+        atomic_money& operator=(const atomic_money&) = delete;
+
+        /**
+         * @brief Gets the currency of the balance.
+         * @return The currency enumeration value
+         */
+        mc::currency currency() const noexcept;
+
+        /**
+         * @brief Gets the balance in smallest currency units.
+         * @return The balance, negative when overdrawn
+         */
+        std::int64_t amount() const noexcept;
+
+        /**
+         * @brief Loads the balance into a money object.
+         * @return A money object with the current balance
+         * @throws std::logic_error if the balance is negative
+         */
+        money load() const;
+
+        /**
+         * @brief Atomically adds a signed amount of smallest currency units.
+         * @param delta The amount to add, negative to subtract unconditionally
+         * @return The balance before the addition
+         */
+        std::int64_t fetch_add(std::int64_t delta) noexcept;
+
+        /**
+         * @brief Atomically adds a money object to the balance.
+         * @param value The amount to add
+         * @return The balance before the addition, in smallest currency units
+         * @throws std::logic_error if currencies don't match
+         * @throws std::overflow_error if the amount does not fit into a signed 64-bit value
+         */
+        std::int64_t fetch_add(const money& value);
+
+        /**
+         * @brief Atomically subtracts an amount unless the balance would drop below a floor.
+         * @param amount The amount to subtract in smallest currency units
+         * @param floor The lowest allowed balance, negative for an overdraft limit
+         * @return true if the amount was subtracted, false if the balance was left unchanged
+         */
+        bool try_debit(std::uint64_t amount, std::int64_t floor = 0) noexcept;
+
+        /**
+         * @brief Atomically subtracts a money object unless the balance would drop below a floor.
+         * @param value The amount to subtract
+         * @param floor The lowest allowed balance, negative for an overdraft limit
+         * @return true if the amount was subtracted, false if the balance was left unchanged
+         * @throws std::logic_error if currencies don't match
+         */
+        bool try_debit(const money& value, std::int64_t floor = 0);
+    };
+}
+
+#endif /* ATOMIC_MONEY_HPP */
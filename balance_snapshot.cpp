@@ -0,0 +1,158 @@
+#include "balance_snapshot.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <io.h>
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace mc {
+
+    namespace impl {
+        /// Number of records converted per write while checkpointing
+        constexpr std::size_t snapshot_chunk_ = 1 << 16;
+
+        constexpr char snapshot_magic_[8] = {'M', 'C', 'S', 'N', 'A', 'P', 'S', 'H'};
+        constexpr std::uint32_t snapshot_version_ = 1;
+
+#if defined(_WIN32)
+        bool sync_file_(std::FILE* file) noexcept {
+            return ::_commit(::_fileno(file)) == 0;
+        }
+
+        bool replace_file_(const std::string& from, const std::string& to) noexcept {
+            return ::MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+        }
+
+        void sync_directory_(const std::string&) noexcept {
+        }
+#else
+        bool sync_file_(std::FILE* file) noexcept {
+            return ::fsync(::fileno(file)) == 0;
+        }
+
+        bool replace_file_(const std::string& from, const std::string& to) noexcept {
+            return std::rename(from.c_str(), to.c_str()) == 0;
+        }
+
+        /// Makes a rename in the directory of path durable
+        void sync_directory_(const std::string& path) noexcept {
+            const std::size_t slash = path.find_last_of('/');
+            const std::string dir = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+            const int fd = ::open(dir.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd >= 0) {
+                ::fsync(fd);
+                ::close(fd);
+            }
+        }
+#endif
+    }
+
+    balance_snapshot::balance_snapshot(const std::string& path) :
+    _file(path), _header(), _records(nullptr) {
+        if (_file.size() < sizeof (_header)) {
+            throw std::runtime_error("not a snapshot file: " + path);
+        }
+        std::memcpy(&_header, _file.data(), sizeof (_header));
+        if (std::memcmp(_header.magic, impl::snapshot_magic_, sizeof (_header.magic)) != 0
+                || _header.version != impl::snapshot_version_
+                || _header.record_size != sizeof (snapshot_record)) {
+            throw std::runtime_error("not a snapshot file: " + path);
+        }
+        if ((_file.size() - sizeof (_header)) / sizeof (snapshot_record) != _header.accounts
+                || (_file.size() - sizeof (_header)) % sizeof (snapshot_record) != 0) {
+            throw std::runtime_error("truncated snapshot file: " + path);
+        }
+        _records = reinterpret_cast<const snapshot_record*>(_file.data() + sizeof (_header));
+    }
+
+    std::size_t balance_snapshot::size() const noexcept {
+        return static_cast<std::size_t>(_header.accounts);
+    }
+
+    std::uint64_t balance_snapshot::journal_sequence() const noexcept {
+        return _header.journal_sequence;
+    }
+
+    const snapshot_record* balance_snapshot::records() const noexcept {
+        return _records;
+    }
+
+    mc::currency balance_snapshot::currency(account_id account) const {
+        if (account >= size()) {
+            throw std::out_of_range("unknown account!");
+        }
+        return static_cast<mc::currency>(_records[account].currency);
+    }
+
+    std::int64_t balance_snapshot::balance(account_id account) const {
+        if (account >= size()) {
+            throw std::out_of_range("unknown account!");
+        }
+        return _records[account].amount;
+    }
+
+    void balance_snapshot::restore(ledger& book) const {
+        if (book.size() != 0) {
+            throw std::logic_error("ledger is not empty!");
+        }
+        const std::size_t count = size();
+        const std::size_t currencies = known_currency_count();
+        for (std::size_t i = 0; i < count; ++i) {
+            if (_records[i].currency >= currencies) {
+                throw std::runtime_error("corrupted snapshot file: unknown currency in record " + std::to_string(i));
+            }
+        }
+        book._balances.resize(count);
+        book._currencies.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            book._balances[i] = _records[i].amount;
+            book._currencies[i] = static_cast<mc::currency>(_records[i].currency);
+        }
+    }
+
+    void balance_snapshot::write(const std::string& path, const ledger& book, std::uint64_t journal_sequence) {
+        const std::string shadow = path + ".tmp";
+        std::FILE* out = std::fopen(shadow.c_str(), "wb");
+        if (out == nullptr) {
+            throw std::runtime_error("cannot write snapshot file: " + shadow);
+        }
+
+        snapshot_header header{};
+        std::memcpy(header.magic, impl::snapshot_magic_, sizeof (header.magic));
+        header.version = impl::snapshot_version_;
+        header.record_size = sizeof (snapshot_record);
+        header.accounts = book._balances.size();
+        header.journal_sequence = journal_sequence;
+        bool written = std::fwrite(&header, sizeof (header), 1, out) == 1;
+
+        std::vector<snapshot_record> chunk(std::min(book._balances.size(), impl::snapshot_chunk_));
+        for (std::size_t begin = 0; written && begin < book._balances.size(); begin += chunk.size()) {
+            const std::size_t count = std::min(chunk.size(), book._balances.size() - begin);
+            for (std::size_t i = 0; i < count; ++i) {
+                chunk[i] = snapshot_record{};
+                chunk[i].amount = book._balances[begin + i];
+                chunk[i].currency = static_cast<std::uint8_t>(book._currencies[begin + i]);
+            }
+            written = std::fwrite(chunk.data(), sizeof (snapshot_record), count, out) == count;
+        }
+        // the shadow file must be on disk before it replaces the previous snapshot
+        written = written && std::fflush(out) == 0 && impl::sync_file_(out);
+        written = std::fclose(out) == 0 && written;
+        if (!written || !impl::replace_file_(shadow, path)) {
+            std::remove(shadow.c_str());
+            throw std::runtime_error("cannot write snapshot file: " + shadow);
+        }
+        impl::sync_directory_(path);
+    }
+}
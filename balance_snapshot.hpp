@@ -0,0 +1,132 @@
+/**
+ * @file balance_snapshot.hpp
+ * @brief Memory-mapped checkpoints of ledger balances.
+ *
+ * A snapshot file is a header followed by a fixed-stride array of balance
+ * records indexed by account ID, so loading it is a mapping and a header
+ * check rather than a parse. Checkpoints are written to a shadow file that
+ * is synced and then renamed over the previous snapshot, so a crash during
+ * a checkpoint leaves either the old or the new snapshot in place.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef BALANCE_SNAPSHOT_HPP
+#define BALANCE_SNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include "ledger.hpp"
+#include "mapped_file.hpp"
+
+namespace mc {
+
+    /**
+     * @brief Balance of one account as stored in a snapshot, in host byte order.
+     *
+     * Unlike money, the record has no virtual table and can be mapped
+     * straight from the file.
+     */
+    struct snapshot_record {
+        std::int64_t amount;      ///< Balance in smallest currency units
+        std::uint8_t currency;    ///< Index of the account currency
+        std::uint8_t reserved[7]; ///< Zero padding
+    };
+
+    static_assert(sizeof(snapshot_record) == 16, "snapshot records must be 16 bytes");
+    static_assert(std::is_trivially_copyable<snapshot_record>::value, "snapshot records are mapped from files");
+
+    /**
+     * @brief Header at the start of every snapshot file.
+     */
+    struct snapshot_header {
+        char magic[8];                  ///< Always "MCSNAPSH"
+        std::uint32_t version;          ///< Format version, currently 1
+        std::uint32_t record_size;      ///< Size of one record in bytes
+        std::uint64_t accounts;         ///< Number of records
+        std::uint64_t journal_sequence; ///< Journal records already included in the balances
+        std::uint64_t reserved[4];      ///< Zero padding up to 64 bytes
+    };
+
+    static_assert(sizeof(snapshot_header) == 64, "snapshot headers must be 64 bytes");
+
+    /**
+     * @brief A read-only view of a snapshot file.
+     */
+    class balance_snapshot {
+        mapped_file _file;               ///< Mapped snapshot file
+        snapshot_header _header;         ///< Copy of the validated header
+        const snapshot_record* _records; ///< Start of the record array in the mapping
+    public:
+        /**
+         * @brief Maps a snapshot file and checks its header.
+         * @param path Path to the snapshot file
+         * @throws std::runtime_error if the file cannot be mapped, is not a
+         *         snapshot or is truncated
+         */
+        explicit balance_snapshot(const std::string& path);
+
+        /**
+         * @brief Gets the number of accounts.
+         * @return The number of accounts
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * @brief Gets the number of journal records included in the balances.
+         *
+         * Replay resumes after this many records.
+         *
+         * @return The journal sequence number of the checkpoint
+         */
+        std::uint64_t journal_sequence() const noexcept;
+
+        /**
+         * @brief Gets the record array.
+         * @return Pointer to the record of account 0
+         */
+        const snapshot_record* records() const noexcept;
+
+        /**
+         * @brief Gets the currency of an account.
+         * @param account The account ID
+         * @return The currency of the account
+         * @throws std::out_of_range if the account does not exist
+         */
+        mc::currency currency(account_id account) const;
+
+        /**
+         * @brief Gets the balance of an account.
+         * @param account The account ID
+         * @return The balance in smallest currency units
+         * @throws std::out_of_range if the account does not exist
+         */
+        std::int64_t balance(account_id account) const;
+
+        /**
+         * @brief Opens the snapshot accounts in an empty ledger.
+         * @param book The ledger to restore
+         * @throws std::logic_error if the ledger already has accounts
+         * @throws std::runtime_error if a record has an unknown currency, the ledger is left empty
+         */
+        void restore(ledger& book) const;
+
+        /**
+         * @brief Writes a checkpoint of a ledger.
+         *
+         * The snapshot is written to path + ".tmp", synced, and renamed to
+         * path, replacing the previous snapshot atomically.
+         *
+         * @param path Path to the snapshot file
+         * @param book The ledger to checkpoint
+         * @param journal_sequence Number of journal records included in the balances
+         * @throws std::runtime_error if the snapshot cannot be written
+         */
+        static void write(const std::string& path, const ledger& book, std::uint64_t journal_sequence = 0);
+    };
+}
+
+#endif /* BALANCE_SNAPSHOT_HPP */
@@ -0,0 +1,67 @@
+#include <catch2/catch_all.hpp>
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "atomic_money.hpp"
+#include "money.hpp"
+
+namespace {
+    const int operations_per_thread = 100000;
+
+    /// Runs the operation on the given number of threads and waits for them
+    template <typename Operation>
+    void run_threads(int threads, Operation operation) {
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&operation] {
+                for (int i = 0; i < operations_per_thread; ++i) {
+                    operation(i);
+                }
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+}
+
+TEST_CASE("Contended balance updates", "[!benchmark][atomic_money]") {
+    const mc::money one_cent = mc::money::from_amount(mc::currency::USD, 1);
+
+    for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+        const std::string suffix = ", " + std::to_string(threads) + " threads x "
+                + std::to_string(operations_per_thread) + " ops";
+
+        BENCHMARK_ADVANCED("mutex + money credit/debit" + suffix)(Catch::Benchmark::Chronometer meter) {
+            mc::money balance = mc::money::from_amount(mc::currency::USD, 1000000);
+            std::mutex lock;
+            meter.measure([&] {
+                run_threads(threads, [&](int i) {
+                    std::lock_guard<std::mutex> guard(lock);
+                    if (i % 2 == 0) {
+                        balance += one_cent;
+                    } else if (balance.amount() >= one_cent.amount()) {
+                        balance -= one_cent;
+                    }
+                });
+            });
+        };
+
+        BENCHMARK_ADVANCED("atomic_money fetch_add/try_debit" + suffix)(Catch::Benchmark::Chronometer meter) {
+            mc::atomic_money balance(mc::money::from_amount(mc::currency::USD, 1000000));
+            meter.measure([&] {
+                run_threads(threads, [&](int i) {
+                    if (i % 2 == 0) {
+                        balance.fetch_add(1);
+                    } else {
+                        balance.try_debit(1);
+                    }
+                });
+            });
+        };
+    }
+}
@@ -0,0 +1,45 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstdio>
+#include <string>
+
+#include "balance_snapshot.hpp"
+#include "currency.hpp"
+#include "ledger.hpp"
+
+namespace {
+    void run_snapshot(std::size_t accounts) {
+        const std::string path = "money_benchmarks_snapshot.bin";
+        const std::string suffix = ", " + std::to_string(accounts) + " accounts";
+        mc::ledger book;
+        for (std::size_t i = 0; i < accounts; ++i) {
+            book.open_account(mc::currency::USD);
+        }
+
+        BENCHMARK("balance_snapshot::write" + suffix) {
+            mc::balance_snapshot::write(path, book, 1);
+            return accounts;
+        };
+
+        BENCHMARK("balance_snapshot load" + suffix) {
+            const mc::balance_snapshot snapshot(path);
+            return snapshot.size();
+        };
+
+        BENCHMARK("balance_snapshot load and restore" + suffix) {
+            const mc::balance_snapshot snapshot(path);
+            mc::ledger restored;
+            snapshot.restore(restored);
+            return restored.size();
+        };
+        std::remove(path.c_str());
+    }
+}
+
+TEST_CASE("Snapshot checkpoint and load, 1M accounts", "[!benchmark][snapshot]") {
+    run_snapshot(1000000);
+}
+
+TEST_CASE("Snapshot checkpoint and load, 50M accounts", "[!benchmark][snapshot][.large]") {
+    run_snapshot(50000000);
+}
@@ -0,0 +1,75 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "column_file.hpp"
+#include "currency.hpp"
+#include "mapped_file.hpp"
+#include "money_column.hpp"
+
+TEST_CASE("Column file scan versus flat file", "[!benchmark][column]") {
+    const std::size_t count = 10000000;
+    const std::string path = "money_benchmarks_column.bin";
+    const std::string flat_path = "money_benchmarks_flat.bin";
+
+    // transactions in time order: a few currencies in runs, small amounts, rare large EUR payments
+    mc::money_column column;
+    column.reserve(count);
+    std::uint64_t state = 88172645463325252ULL;
+    const mc::currency currencies[] = {mc::currency::USD, mc::currency::EUR, mc::currency::MDL, mc::currency::GBP};
+    for (std::size_t i = 0; i < count; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        const mc::currency c = currencies[(i / 5000 + (state >> 60)) % 4];
+        const bool large = c == mc::currency::EUR && (i >> 20) == 3 && state % 64 == 0;
+        column.push_back(c, large ? 1500000 + static_cast<std::int64_t>(state % 100000) : static_cast<std::int64_t>(state % 100000));
+    }
+
+    mc::write_column_file(path, column);
+    {
+        std::ofstream out(flat_path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(column.amounts()), count * sizeof (std::int64_t));
+        out.write(reinterpret_cast<const char*>(column.currencies()), count);
+    }
+    const mc::column_file file(path);
+    const mc::mapped_file flat(flat_path);
+    WARN("flat bytes: " << flat.size() << ", column file bytes: " << mc::mapped_file(path).size());
+
+    mc::column_filter filter;
+    filter.match_currency = true;
+    filter.currency = mc::currency::EUR;
+    filter.min_amount = 1000001;
+
+    BENCHMARK("flat file filter, EUR over 10000.00, 10M rows") {
+        const char* amounts = flat.data();
+        const std::uint8_t* codes = reinterpret_cast<const std::uint8_t*>(flat.data() + count * sizeof (std::int64_t));
+        mc::money_column out;
+        for (std::size_t i = 0; i < count; ++i) {
+            std::int64_t amount;
+            std::memcpy(&amount, amounts + i * sizeof (amount), sizeof (amount));
+            if (codes[i] == static_cast<std::uint8_t>(filter.currency) && amount >= filter.min_amount) {
+                out.push_back(filter.currency, amount);
+            }
+        }
+        return out.size();
+    };
+
+    BENCHMARK("column file scan, EUR over 10000.00, 10M rows") {
+        mc::money_column out;
+        return file.scan(filter, out);
+    };
+
+    BENCHMARK("column file full read, 10M rows") {
+        mc::money_column out;
+        file.read(out);
+        return out.size();
+    };
+
+    std::remove(path.c_str());
+    std::remove(flat_path.c_str());
+}
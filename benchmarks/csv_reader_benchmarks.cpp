@@ -0,0 +1,65 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "csv_reader.hpp"
+#include "currency.hpp"
+#include "mapped_file.hpp"
+#include "money_column.hpp"
+
+TEST_CASE("CSV reader versus iostreams", "[!benchmark][csv]") {
+    const std::size_t count = 4000000;
+    const std::string path = "money_benchmarks_rows.csv";
+    {
+        const char* codes[] = {"USD", "EUR", "MDL", "GBP", "RON"};
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "id,amount,currency\n";
+        std::uint64_t state = 88172645463325252ULL;
+        for (std::size_t i = 0; i < count; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            out << 100000 + i << ',' << state % 1000000 << '.' << state / 7 % 90 + 10 << ',' << codes[state / 11 % 5] << '\n';
+        }
+    }
+    const std::size_t bytes = mc::mapped_file(path).size();
+    WARN("CSV bytes: " << bytes << ", rows: " << count);
+
+    BENCHMARK("iostreams and to_currency, 4M rows") {
+        std::ifstream in(path);
+        std::string line;
+        std::getline(in, line);
+        mc::money_column out;
+        while (std::getline(in, line)) {
+            std::istringstream fields(line);
+            std::string id;
+            std::string amount;
+            std::string code;
+            std::getline(fields, id, ',');
+            std::getline(fields, amount, ',');
+            std::getline(fields, code);
+            out.push_back(mc::to_currency(code), static_cast<std::int64_t>(std::stod(amount) * 100 + 0.5));
+        }
+        return out.size();
+    };
+
+    BENCHMARK("csv_reader chunks, 4M rows") {
+        mc::csv_reader reader(path);
+        mc::csv_chunk chunk;
+        std::size_t rows = 0;
+        while (reader.next(chunk)) {
+            rows += chunk.ids.size();
+        }
+        return rows;
+    };
+
+    BENCHMARK("read_csv, all hardware threads, 4M rows") {
+        mc::csv_chunk out;
+        return mc::read_csv(path, out);
+    };
+
+    std::remove(path.c_str());
+}
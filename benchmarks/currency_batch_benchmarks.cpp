@@ -0,0 +1,49 @@
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <vector>
+
+#include "currency.hpp"
+#include "currency_batch.hpp"
+
+TEST_CASE("Batch currency conversion versus to_currency", "[!benchmark][currency_batch]") {
+    const std::size_t count = 1000000;
+    const std::size_t stride = 4;
+    std::vector<char> codes(count * stride, ',');
+    std::uint64_t state = 88172645463325252ULL;
+    for (std::size_t i = 0; i < count; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        const std::string_view code = mc::to_code(static_cast<mc::currency>(state % 20));
+        std::copy(code.begin(), code.end(), codes.begin() + i * stride);
+    }
+    std::vector<std::uint8_t> out(count);
+    std::vector<mc::bitmask> invalid((count + 63) / 64);
+
+    BENCHMARK("to_currency per row, 1M codes") {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            sum += static_cast<std::size_t>(mc::to_currency(std::string(codes.data() + i * stride, 3)));
+        }
+        return sum;
+    };
+
+    BENCHMARK("find_currency per row, 1M codes") {
+        std::size_t sum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            mc::currency c;
+            mc::find_currency(std::string_view(codes.data() + i * stride, 3), c);
+            sum += static_cast<std::size_t>(c);
+        }
+        return sum;
+    };
+
+    BENCHMARK("to_currency_batch_scalar, 1M codes") {
+        return mc::to_currency_batch_scalar(codes.data(), stride, count, out.data(), invalid.data());
+    };
+
+    BENCHMARK("to_currency_batch, 1M codes") {
+        return mc::to_currency_batch(codes.data(), stride, count, out.data(), invalid.data());
+    };
+}
@@ -0,0 +1,46 @@
+#include <catch2/catch_all.hpp>
+
+#include <map>
+#include <vector>
+
+#include "currency.hpp"
+#include "currency_info.hpp"
+
+TEST_CASE("Numeric code lookup versus a map", "[!benchmark][currency_info]") {
+    const std::size_t count = 1000000;
+    std::map<std::uint16_t, mc::currency> by_numeric;
+    std::vector<std::uint16_t> numerics;
+    for (std::size_t i = 0; i < mc::currency_count; ++i) {
+        const mc::currency c = static_cast<mc::currency>(i);
+        if (mc::to_numeric(c) != 0) {
+            by_numeric.emplace(mc::to_numeric(c), c);
+            numerics.push_back(mc::to_numeric(c));
+        }
+    }
+    std::vector<std::uint16_t> codes(count);
+    std::uint64_t state = 88172645463325252ULL;
+    for (std::uint16_t& code : codes) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        code = numerics[state % numerics.size()];
+    }
+
+    BENCHMARK("std::map lookup, 1M codes") {
+        std::size_t sum = 0;
+        for (std::uint16_t code : codes) {
+            sum += static_cast<std::size_t>(by_numeric.find(code)->second);
+        }
+        return sum;
+    };
+
+    BENCHMARK("from_numeric, 1M codes") {
+        std::size_t sum = 0;
+        for (std::uint16_t code : codes) {
+            mc::currency c = mc::currency::AED;
+            mc::from_numeric(code, c);
+            sum += static_cast<std::size_t>(c);
+        }
+        return sum;
+    };
+}
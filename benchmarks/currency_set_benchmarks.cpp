@@ -0,0 +1,44 @@
+#include <catch2/catch_all.hpp>
+
+#include <set>
+#include <vector>
+
+#include "currency.hpp"
+#include "currency_set.hpp"
+#include "money_column.hpp"
+
+TEST_CASE("Currency set filter versus std::set lookups", "[!benchmark][currency_set]") {
+    const std::size_t count = 10000000;
+    mc::money_column column;
+    column.reserve(count);
+    std::uint64_t state = 88172645463325252ULL;
+    for (std::size_t i = 0; i < count; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        column.push_back(static_cast<mc::currency>(state % mc::currency_count), static_cast<std::int64_t>(i));
+    }
+    const mc::currency_set set = mc::eur_pegged_currencies | mc::currency_set{mc::currency::EUR};
+    const std::set<mc::currency> tree(set.begin(), set.end());
+    std::vector<mc::bitmask> selection((count + 63) / 64);
+
+    BENCHMARK("std::set lookup per row, 10M rows") {
+        std::size_t selected = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            selected += tree.count(column.currency(i));
+        }
+        return selected;
+    };
+
+    BENCHMARK("currency_set::contains per row, 10M rows") {
+        std::size_t selected = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            selected += set.contains(column.currency(i));
+        }
+        return selected;
+    };
+
+    BENCHMARK("filter into a selection bitmap, 10M rows") {
+        return mc::filter(column, set, selection.data());
+    };
+}
@@ -0,0 +1,80 @@
+#include <catch2/catch_all.hpp>
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hold_balance.hpp"
+#include "money.hpp"
+
+namespace {
+    const int cycles_per_thread = 100000;
+
+    /// Runs the authorization cycle on the given number of threads and waits for them
+    template <typename Cycle>
+    void run_threads(unsigned threads, Cycle cycle) {
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&cycle] {
+                for (int i = 0; i < cycles_per_thread; ++i) {
+                    cycle(i);
+                }
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+}
+
+TEST_CASE("Authorization hold throughput", "[!benchmark][hold_balance]") {
+    const unsigned hardware = std::thread::hardware_concurrency() == 0 ? 1 : std::thread::hardware_concurrency();
+    const mc::money one_cent = mc::money::from_amount(mc::currency::USD, 1);
+
+    for (unsigned threads = 1; threads <= hardware * 2; threads *= 2) {
+        const std::string suffix = ", " + std::to_string(threads) + " threads x "
+                + std::to_string(cycles_per_thread) + " reserve + capture/release";
+
+        BENCHMARK_ADVANCED("mutex + two money objects" + suffix)(Catch::Benchmark::Chronometer meter) {
+            mc::money available = mc::money::from_amount(mc::currency::USD, 1000000000);
+            mc::money held(mc::currency::USD);
+            std::mutex lock;
+            meter.measure([&] {
+                run_threads(threads, [&](int i) {
+                    {
+                        std::lock_guard<std::mutex> guard(lock);
+                        try {
+                            available -= one_cent;
+                            held += one_cent;
+                        } catch (const std::logic_error&) {
+                            return;
+                        }
+                    }
+                    std::lock_guard<std::mutex> guard(lock);
+                    held -= one_cent;
+                    if (i % 2 == 0) {
+                        available += one_cent;
+                    }
+                });
+            });
+        };
+
+        BENCHMARK_ADVANCED("hold_balance" + suffix)(Catch::Benchmark::Chronometer meter) {
+            mc::hold_balance balance(mc::currency::USD, 1000000000);
+            meter.measure([&] {
+                run_threads(threads, [&](int i) {
+                    if (!balance.reserve(1)) {
+                        return;
+                    }
+                    if (i % 2 == 0) {
+                        balance.release(1);
+                    } else {
+                        balance.capture(1);
+                    }
+                });
+            });
+        };
+    }
+}
@@ -0,0 +1,105 @@
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "currency.hpp"
+#include "journal.hpp"
+#include "ledger.hpp"
+
+namespace {
+    const std::string path = "money_benchmarks_journal.bin";
+
+    /// Appends records from producers that each wait until their record is durable
+    std::size_t run_durable_appends(const mc::journal_options& options, std::size_t producers, std::size_t records) {
+        std::remove(path.c_str());
+        mc::journal_writer journal(path, options);
+        std::vector<std::thread> threads;
+        for (std::size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&journal, p, producers, records] {
+                for (std::size_t i = p; i < records; i += producers) {
+                    const mc::leg value{static_cast<mc::account_id>(i % 1000), mc::currency::USD, 100};
+                    journal.wait_durable(journal.append(value));
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        return static_cast<std::size_t>(journal.durable());
+    }
+}
+
+TEST_CASE("Journal durable append throughput", "[!benchmark][journal]") {
+    const std::size_t producers = 64;
+    const std::size_t records = 2000;
+
+    mc::journal_options single;
+    single.max_batch = 1;
+    BENCHMARK("fsync per record, " + std::to_string(producers) + " producers, " + std::to_string(records) + " records") {
+        return run_durable_appends(single, producers, records);
+    };
+
+    mc::journal_options grouped;
+    grouped.max_batch = producers;
+    grouped.max_latency = std::chrono::microseconds(500);
+    BENCHMARK("group commit, " + std::to_string(producers) + " producers, " + std::to_string(records) + " records") {
+        return run_durable_appends(grouped, producers, records);
+    };
+    std::remove(path.c_str());
+}
+
+namespace {
+    /// Writes journal segments of pseudo-random postings, then replays them serially and in parallel
+    void run_replay(std::size_t records) {
+        const std::size_t accounts = 1000000;
+        const std::size_t segments = 4;
+        std::vector<std::string> paths;
+        for (std::size_t s = 0; s < segments; ++s) {
+            paths.push_back("money_benchmarks_segment_" + std::to_string(s) + ".bin");
+            std::remove(paths.back().c_str());
+            mc::journal_options options;
+            options.sync = false;
+            options.max_batch = 1 << 16;
+            mc::journal_writer journal(paths.back(), options);
+            for (std::size_t i = s; i < records; i += segments) {
+                journal.append(mc::leg{static_cast<mc::account_id>(i * 2654435761u % accounts), mc::currency::USD, 1});
+            }
+        }
+        mc::ledger book;
+        for (std::size_t i = 0; i < accounts; ++i) {
+            book.open_account(mc::currency::USD);
+        }
+        const std::string suffix = ", " + std::to_string(records) + " records";
+
+        BENCHMARK("serial replay_journal" + suffix) {
+            std::size_t replayed = 0;
+            for (const auto& p : paths) {
+                replayed += mc::replay_journal(p, book);
+            }
+            return replayed;
+        };
+
+        const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+        for (std::size_t threads = 1; threads <= hardware; threads *= 2) {
+            BENCHMARK("parallel replay_journal, " + std::to_string(threads) + " threads" + suffix) {
+                return mc::replay_journal(paths, book, threads);
+            };
+        }
+        for (const auto& p : paths) {
+            std::remove(p.c_str());
+        }
+    }
+}
+
+TEST_CASE("Journal replay throughput, 10M records", "[!benchmark][journal]") {
+    run_replay(10000000);
+}
+
+TEST_CASE("Journal replay throughput, 100M records", "[!benchmark][journal][.large]") {
+    run_replay(100000000);
+}
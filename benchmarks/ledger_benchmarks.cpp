@@ -0,0 +1,71 @@
+#include <catch2/catch_all.hpp>
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "currency.hpp"
+#include "ledger.hpp"
+#include "money.hpp"
+
+namespace {
+    const std::size_t accounts = 1000000;
+
+    /// Builds a batch of two-leg transfers between pseudo-random accounts
+    mc::journal_batch make_batch(std::size_t postings) {
+        mc::journal_batch batch;
+        batch.reserve(postings / 2, postings);
+        std::uint64_t state = 88172645463325252ULL;
+        for (std::size_t e = 0; e < postings / 2; ++e) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            const auto from = static_cast<mc::account_id>(state % accounts);
+            const auto to = static_cast<mc::account_id>((state >> 32) % accounts);
+            const auto amount = static_cast<std::int64_t>(state % 100000 + 1);
+            batch.add({{to, mc::currency::USD, amount}, {from, mc::currency::USD, -amount}});
+        }
+        return batch;
+    }
+
+    void run_postings(std::size_t postings) {
+        mc::ledger book;
+        std::vector<mc::money> balances;
+        std::vector<std::mutex> locks(accounts);
+        for (std::size_t i = 0; i < accounts; ++i) {
+            book.open_account(mc::currency::USD);
+            balances.push_back(mc::money::from_amount(mc::currency::USD, 1ULL << 40));
+        }
+        const mc::journal_batch batch = make_batch(postings);
+        const std::string suffix = ", " + std::to_string(postings) + " postings";
+
+        BENCHMARK("per-posting locked money +=/-=" + suffix) {
+            for (std::size_t e = 0; e < batch.size(); ++e) {
+                const mc::leg* legs = batch.entry(e);
+                for (std::size_t i = 0; i < batch.entry_size(e); ++i) {
+                    std::lock_guard<std::mutex> guard(locks[legs[i].account]);
+                    const auto value = mc::money::from_amount(mc::currency::USD,
+                            static_cast<std::uint64_t>(legs[i].amount < 0 ? -legs[i].amount : legs[i].amount));
+                    if (legs[i].amount < 0) {
+                        balances[legs[i].account] -= value;
+                    } else {
+                        balances[legs[i].account] += value;
+                    }
+                }
+            }
+            return balances.size();
+        };
+
+        BENCHMARK("ledger batch post" + suffix) {
+            return book.post(batch);
+        };
+    }
+}
+
+TEST_CASE("Ledger posting throughput, 1M postings", "[!benchmark][ledger]") {
+    run_postings(1000000);
+}
+
+TEST_CASE("Ledger posting throughput, 100M postings", "[!benchmark][ledger][.large]") {
+    run_postings(100000000);
+}
@@ -0,0 +1,36 @@
+#include <catch2/catch_all.hpp>
+
+#include <sstream>
+#include <vector>
+
+#include "currency.hpp"
+#include "money.hpp"
+
+TEST_CASE("Stream output versus to_string", "[!benchmark][stream]") {
+    const std::size_t count = 1000000;
+    std::vector<mc::money> values;
+    values.reserve(count);
+    std::uint64_t state = 88172645463325252ULL;
+    for (std::size_t i = 0; i < count; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        values.push_back(mc::money::from_amount(state % 3 == 0 ? mc::currency::EUR : mc::currency::USD, state % 100000000));
+    }
+
+    BENCHMARK("os << to_string(), 1M values") {
+        std::ostringstream os;
+        for (const mc::money& m : values) {
+            os << m.to_string() << '\n';
+        }
+        return os.tellp();
+    };
+
+    BENCHMARK("os << money, 1M values") {
+        std::ostringstream os;
+        for (const mc::money& m : values) {
+            os << m << '\n';
+        }
+        return os.tellp();
+    };
+}
@@ -0,0 +1,74 @@
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <vector>
+
+#include "currency.hpp"
+#include "money.hpp"
+#include "money_codec.hpp"
+#include "packed_money.hpp"
+
+TEST_CASE("Binary codec versus string round trip", "[!benchmark][codec]") {
+    const std::size_t count = 1000000;
+    std::vector<mc::money> values;
+    values.reserve(count);
+    std::uint64_t state = 88172645463325252ULL;
+    for (std::size_t i = 0; i < count; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        const std::uint64_t amount = state % 4 == 0 ? (state >> 8) % 10000 * 100 : (state >> 8) % 1000000;
+        values.push_back(mc::money::from_amount(state % 3 == 0 ? mc::currency::EUR : mc::currency::USD, amount));
+    }
+    std::vector<mc::packed_money> packed(count);
+    mc::pack(values.data(), count, packed.data());
+
+    std::size_t string_bytes = 0;
+    for (const mc::money& m : values) {
+        string_bytes += m.to_string().size() + 1;
+    }
+    std::vector<std::uint8_t> encoded;
+    mc::encode(values.data(), count, encoded);
+    WARN("to_string bytes: " << string_bytes << ", binary bytes: " << encoded.size());
+
+    BENCHMARK("to_string encode, 1M values") {
+        std::string out;
+        out.reserve(string_bytes);
+        for (const mc::money& m : values) {
+            out += m.to_string();
+            out += '\n';
+        }
+        return out.size();
+    };
+
+    BENCHMARK("binary encode money, 1M values") {
+        std::vector<std::uint8_t> out;
+        out.reserve(encoded.size());
+        mc::encode(values.data(), count, out);
+        return out.size();
+    };
+
+    BENCHMARK("binary encode packed_money, 1M values") {
+        std::vector<std::uint8_t> out;
+        out.reserve(encoded.size());
+        mc::encode(packed.data(), count, out);
+        return out.size();
+    };
+
+    BENCHMARK("binary decode money, 1M values") {
+        std::vector<mc::money> out;
+        out.reserve(count);
+        return mc::decode(encoded.data(), encoded.size(), out);
+    };
+
+    BENCHMARK("binary decode packed_money, 1M values") {
+        std::vector<mc::packed_money> out;
+        out.reserve(count);
+        return mc::decode(encoded.data(), encoded.size(), out);
+    };
+
+    BENCHMARK("binary decode of the last 1000 values") {
+        std::vector<mc::packed_money> out;
+        return mc::decode(encoded.data(), encoded.size(), out, count - 1000);
+    };
+}
@@ -0,0 +1,60 @@
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <vector>
+
+#include "currency.hpp"
+#include "money.hpp"
+#include "money_fmt.hpp"
+
+TEST_CASE("Formatting integration versus to_string", "[!benchmark][fmt]") {
+    const std::size_t count = 1000000;
+    std::vector<mc::money> values;
+    values.reserve(count);
+    std::uint64_t state = 88172645463325252ULL;
+    for (std::size_t i = 0; i < count; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        values.push_back(mc::money::from_amount(state % 3 == 0 ? mc::currency::EUR : mc::currency::USD, state % 100000000));
+    }
+
+    BENCHMARK("to_string per value, 1M values") {
+        std::string out;
+        for (const mc::money& m : values) {
+            out += m.to_string();
+            out += '\n';
+        }
+        return out.size();
+    };
+
+    BENCHMARK("write_money into a string, 1M values") {
+        std::string out;
+        const mc::money_spec spec;
+        for (const mc::money& m : values) {
+            mc::write_money(std::back_inserter(out), m, spec);
+            out += '\n';
+        }
+        return out.size();
+    };
+
+#if defined(FMT_VERSION)
+    BENCHMARK("fmt::format_to into a memory buffer, 1M values") {
+        fmt::memory_buffer out;
+        for (const mc::money& m : values) {
+            fmt::format_to(std::back_inserter(out), FMT_STRING("{}\n"), m);
+        }
+        return out.size();
+    };
+#endif
+
+#if defined(__cpp_lib_format)
+    BENCHMARK("std::format_to into a string, 1M values") {
+        std::string out;
+        for (const mc::money& m : values) {
+            std::format_to(std::back_inserter(out), "{}\n", m);
+        }
+        return out.size();
+    };
+#endif
+}
@@ -0,0 +1,45 @@
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <vector>
+
+#include "currency.hpp"
+#include "money.hpp"
+#include "money_format.hpp"
+
+TEST_CASE("Column formatting versus to_string per line", "[!benchmark][format]") {
+    const std::size_t count = 1000000;
+    std::vector<mc::money> values;
+    values.reserve(count);
+    std::uint64_t state = 88172645463325252ULL;
+    for (std::size_t i = 0; i < count; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        values.push_back(mc::money::from_amount(state % 3 == 0 ? mc::currency::EUR : mc::currency::USD, state % 100000000));
+    }
+    mc::format_options options;
+    options.width = 16;
+
+    BENCHMARK("to_string per line, 1M values") {
+        std::string out;
+        for (const mc::money& m : values) {
+            out += m.to_string();
+            out += '\n';
+        }
+        return out.size();
+    };
+
+    BENCHMARK("format_column, 1M values") {
+        mc::output_buffer out;
+        mc::format_column(values.data(), count, options, out);
+        return out.size();
+    };
+
+    mc::output_buffer reused(count * 20);
+    BENCHMARK("format_column into a reused buffer, 1M values") {
+        reused.clear();
+        mc::format_column(values.data(), count, options, reused);
+        return reused.size();
+    };
+}
@@ -0,0 +1,57 @@
+#include <catch2/catch_all.hpp>
+
+#include <iomanip>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "currency.hpp"
+#include "money.hpp"
+#include "money_formatter.hpp"
+
+TEST_CASE("Locale formatter versus std::put_money", "[!benchmark][formatter]") {
+    const std::size_t count = 100000;
+    std::vector<mc::money> values;
+    values.reserve(count);
+    std::uint64_t state = 88172645463325252ULL;
+    for (std::size_t i = 0; i < count; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        values.push_back(mc::money::from_amount(mc::currency::USD, state % 100000000));
+    }
+
+    // fall back to the classic locale where en_US is not installed
+    std::locale locale = std::locale::classic();
+    try {
+        locale = std::locale("en_US.UTF-8");
+    } catch (const std::runtime_error&) {
+    }
+
+    BENCHMARK("std::put_money, 100k values") {
+        std::ostringstream out;
+        out.imbue(locale);
+        out << std::showbase;
+        for (const mc::money& m : values) {
+            out << std::put_money(static_cast<long double>(m.amount())) << '\n';
+        }
+        return out.str().size();
+    };
+
+    BENCHMARK("money_formatter::format per value, 100k values") {
+        const mc::money_formatter& formatter = mc::find_formatter("en_US");
+        std::size_t size = 0;
+        for (const mc::money& m : values) {
+            size += formatter.format(m).size();
+        }
+        return size;
+    };
+
+    mc::output_buffer reused(count * 20);
+    BENCHMARK("money_formatter::format_column into a reused buffer, 100k values") {
+        reused.clear();
+        mc::find_formatter("en_US").format_column(values.data(), count, reused);
+        return reused.size();
+    };
+}
@@ -0,0 +1,59 @@
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <vector>
+
+#include "currency.hpp"
+#include "money.hpp"
+#include "money_json.hpp"
+
+TEST_CASE("JSON codec versus to_string and stod", "[!benchmark][json]") {
+    const std::size_t count = 100000;
+    std::vector<mc::money> values;
+    values.reserve(count);
+    std::uint64_t state = 88172645463325252ULL;
+    for (std::size_t i = 0; i < count; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        values.push_back(mc::money::from_amount(state % 3 == 0 ? mc::currency::EUR : mc::currency::USD, state % 10000000));
+    }
+    std::string buffer(count * (mc::max_json_size + 1) + 2, '\0');
+    const std::size_t length = mc::write_json(values.data(), count, &buffer[0], buffer.size());
+    const std::string text = buffer.substr(0, length);
+    std::vector<mc::money> read(count, mc::money(mc::currency::AED));
+
+    BENCHMARK("hand-rolled to_string encode, 100k values") {
+        std::string out = "[";
+        for (const mc::money& m : values) {
+            std::string amount = std::to_string(m.integral()) + "." + (m.part() < 10 ? "0" : "") + std::to_string(m.part());
+            out += "{\"amount\":\"" + amount + "\",\"currency\":\"" + mc::to_shortname(m.currency()) + "\"},";
+        }
+        out.back() = ']';
+        return out.size();
+    };
+
+    BENCHMARK("write_json, 100k values") {
+        return mc::write_json(values.data(), count, &buffer[0], buffer.size());
+    };
+
+    BENCHMARK("hand-rolled stod decode, 100k values") {
+        std::vector<mc::money> out;
+        out.reserve(count);
+        std::size_t pos = 0;
+        while ((pos = text.find("\"amount\":\"", pos)) != std::string::npos) {
+            pos += 10;
+            const std::size_t quote = text.find('"', pos);
+            const double amount = std::stod(text.substr(pos, quote - pos));
+            pos = text.find("\"currency\":\"", quote) + 12;
+            out.push_back(mc::money::from_amount(mc::to_currency(text.substr(pos, 3)), static_cast<std::uint64_t>(amount * 100 + 0.5)));
+        }
+        return out.size();
+    };
+
+    BENCHMARK("read_json, 100k values") {
+        std::size_t decoded = 0;
+        mc::read_json(text, read.data(), read.size(), decoded);
+        return decoded;
+    };
+}
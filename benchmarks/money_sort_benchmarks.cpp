@@ -0,0 +1,83 @@
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "currency.hpp"
+#include "money.hpp"
+#include "money_column.hpp"
+#include "money_sort.hpp"
+
+namespace {
+    /// Values in a dozen currencies with amounts below one million units
+    std::vector<mc::money> make_values(std::size_t count) {
+        std::vector<mc::money> values;
+        values.reserve(count);
+        std::uint64_t state = 88172645463325252ULL;
+        for (std::size_t i = 0; i < count; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            values.push_back(mc::money::from_amount(static_cast<mc::currency>(state % 12 * 13), (state >> 8) % 100000000));
+        }
+        return values;
+    }
+
+    void run_sort_benchmarks(std::size_t count, const std::string& suffix) {
+        const std::vector<mc::money> values = make_values(count);
+
+        BENCHMARK_ADVANCED("std::sort of money objects" + suffix)(Catch::Benchmark::Chronometer meter) {
+            std::vector<std::vector<mc::money>> data(meter.runs(), values);
+            meter.measure([&](int run) {
+                std::sort(data[run].begin(), data[run].end());
+                return data[run].size();
+            });
+        };
+
+        BENCHMARK_ADVANCED("radix_sort of money objects" + suffix)(Catch::Benchmark::Chronometer meter) {
+            std::vector<std::vector<mc::money>> data(meter.runs(), values);
+            meter.measure([&](int run) {
+                mc::radix_sort(data[run]);
+                return data[run].size();
+            });
+        };
+
+        mc::money_column column;
+        column.reserve(count);
+        for (const mc::money& value : values) {
+            column.push_back(value);
+        }
+
+        BENCHMARK_ADVANCED("std::sort of a column through an index" + suffix)(Catch::Benchmark::Chronometer meter) {
+            std::vector<std::uint32_t> order(count);
+            meter.measure([&] {
+                std::iota(order.begin(), order.end(), 0);
+                const std::int64_t* amounts = column.amounts();
+                const std::uint8_t* currencies = column.currencies();
+                std::sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+                    return currencies[a] != currencies[b] ? currencies[a] < currencies[b] : amounts[a] < amounts[b];
+                });
+                return order.size();
+            });
+        };
+
+        BENCHMARK_ADVANCED("radix_sort of a column" + suffix)(Catch::Benchmark::Chronometer meter) {
+            std::vector<mc::money_column> data(meter.runs(), column);
+            meter.measure([&](int run) {
+                mc::radix_sort(data[run]);
+                return data[run].size();
+            });
+        };
+    }
+}
+
+// Every run sorts its own unsorted copy of the input.
+TEST_CASE("Radix sort versus std::sort, 10M values", "[!benchmark][money_sort]") {
+    run_sort_benchmarks(10000000, ", 10M values");
+}
+
+TEST_CASE("Radix sort versus std::sort, 100M values", "[!benchmark][money_sort][.large]") {
+    run_sort_benchmarks(100000000, ", 100M values");
+}
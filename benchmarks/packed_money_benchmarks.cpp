@@ -0,0 +1,61 @@
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <vector>
+
+#include "currency.hpp"
+#include "money.hpp"
+#include "money_bag.hpp"
+#include "packed_money.hpp"
+
+namespace {
+    void run_sums(std::size_t count) {
+        std::vector<mc::money> values;
+        values.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            values.push_back(mc::money::from_amount(i % 4 == 0 ? mc::currency::EUR : mc::currency::USD, i % 100000));
+        }
+        std::vector<mc::packed_money> packed(count);
+        mc::pack(values.data(), values.size(), packed.data());
+        const std::string suffix = ", " + std::to_string(count) + " values";
+
+        BENCHMARK("money sum of one currency" + suffix) {
+            std::uint64_t total = 0;
+            for (const mc::money& m : values) {
+                if (m.currency() == mc::currency::USD) {
+                    total += m.amount();
+                }
+            }
+            return total;
+        };
+
+        BENCHMARK("packed_money sum of one currency" + suffix) {
+            std::int64_t total = 0;
+            mc::sum(packed.data(), packed.size(), mc::currency::USD, total);
+            return total;
+        };
+
+        BENCHMARK("money_bag of money" + suffix) {
+            mc::money_bag totals;
+            for (const mc::money& m : values) {
+                totals.add(m);
+            }
+            return totals.size();
+        };
+
+        BENCHMARK("money_bag of packed_money" + suffix) {
+            mc::money_bag totals;
+            mc::sum(packed.data(), packed.size(), totals);
+            return totals.size();
+        };
+
+        std::vector<mc::packed_money> out(count);
+        BENCHMARK("packed_money element-wise add" + suffix) {
+            return mc::add(packed.data(), packed.data(), out.data(), count);
+        };
+    }
+}
+
+TEST_CASE("Packed money scans, 10M values", "[!benchmark][packed_money]") {
+    run_sums(10000000);
+}
@@ -0,0 +1,86 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "currency.hpp"
+#include "rate_table.hpp"
+
+namespace {
+    /// Writes a historical rate file with the given number of lines
+    std::string make_rate_file(std::size_t lines) {
+        const std::string path = "money_bench_rates_" + std::to_string(lines) + ".txt";
+        std::ofstream fout(path, std::ios::binary | std::ios::trunc);
+        for (std::size_t i = 0; i < lines; ++i) {
+            const auto from = static_cast<mc::currency>(i % mc::currency_count);
+            const auto to = static_cast<mc::currency>((i * 7 + 1) % mc::currency_count);
+            if (from == to) {
+                continue;
+            }
+            fout << mc::to_shortname(from) << ' ' << mc::to_shortname(to) << ' '
+                    << 0.5 + static_cast<double>(i % 1000) / 997. << '\n';
+        }
+        return path;
+    }
+
+    /// Reference loader: stream extraction and to_currency(std::string) per line
+    mc::rate_table load_rates_stream(const std::string& path) {
+        mc::rate_table table;
+        std::ifstream fin(path);
+        std::string from, to;
+        double rate;
+        while (fin >> from >> to >> rate) {
+            const auto f = mc::to_currency(from);
+            const auto t = mc::to_currency(to);
+            table.set(f, t, rate);
+            table.set(t, f, 1. / rate);
+        }
+        return table;
+    }
+}
+
+TEST_CASE("Rate file loading", "[!benchmark][rates]") {
+    for (std::size_t lines : {10000u, 1000000u}) {
+        const std::string path = make_rate_file(lines);
+
+        BENCHMARK("load_rates (mmap + from_chars), " + std::to_string(lines) + " lines") {
+            return mc::load_rates(path);
+        };
+
+        BENCHMARK("ifstream >> + to_currency, " + std::to_string(lines) + " lines") {
+            return load_rates_stream(path);
+        };
+
+        std::remove(path.c_str());
+    }
+}
+
+TEST_CASE("Two-sided conversion", "[!benchmark][rates][two_sided]") {
+    mc::rate_table table;
+    table.set(mc::currency::USD, mc::currency::EUR, mc::two_sided_rate{{0.91, 0.93}});
+    table.set(mc::currency::GBP, mc::currency::EUR, mc::two_sided_rate{{1.15, 1.17}});
+
+    std::vector<mc::money> values;
+    for (std::size_t i = 0; i < 100000; ++i) {
+        values.emplace_back(i % 3 ? mc::currency::USD : mc::currency::GBP, static_cast<double>(i % 10000) + 0.25);
+    }
+    std::vector<mc::money> bid, ask;
+
+    BENCHMARK("two money::convert calls per value, 100000 values") {
+        bid.clear();
+        ask.clear();
+        for (const auto& m : values) {
+            const auto& quote = table.quote(m.currency(), mc::currency::EUR);
+            bid.push_back(m.convert(mc::currency::EUR, quote.bid()));
+            ask.push_back(m.convert(mc::currency::EUR, quote.ask()));
+        }
+        return bid.size() + ask.size();
+    };
+
+    BENCHMARK("rate_table batch convert, 100000 values") {
+        table.convert(values.data(), values.size(), mc::currency::EUR, bid, ask);
+        return bid.size() + ask.size();
+    };
+}
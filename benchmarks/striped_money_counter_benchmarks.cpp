@@ -0,0 +1,58 @@
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "currency.hpp"
+#include "striped_money_counter.hpp"
+
+namespace {
+    const int increments_per_thread = 1000000;
+
+    /// Runs the increment on the given number of threads and waits for them
+    template <typename Increment>
+    void run_threads(unsigned threads, Increment increment) {
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&increment] {
+                for (int i = 0; i < increments_per_thread; ++i) {
+                    increment();
+                }
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+}
+
+TEST_CASE("Hot aggregate counter scaling", "[!benchmark][striped_counter]") {
+    const unsigned hardware = std::thread::hardware_concurrency() == 0 ? 1 : std::thread::hardware_concurrency();
+
+    for (unsigned threads = 1; threads <= hardware * 2; threads *= 2) {
+        const std::string suffix = ", " + std::to_string(threads) + " threads x "
+                + std::to_string(increments_per_thread) + " increments";
+
+        BENCHMARK_ADVANCED("single shared atomic total" + suffix)(Catch::Benchmark::Chronometer meter) {
+            std::atomic<std::int64_t> total(0);
+            meter.measure([&] {
+                run_threads(threads, [&] {
+                    total.fetch_add(1, std::memory_order_relaxed);
+                });
+            });
+        };
+
+        BENCHMARK_ADVANCED("striped_money_counter" + suffix)(Catch::Benchmark::Chronometer meter) {
+            mc::striped_money_counter counter;
+            meter.measure([&] {
+                run_threads(threads, [&] {
+                    counter.add(mc::currency::USD, 1);
+                });
+            });
+        };
+    }
+}
@@ -0,0 +1,92 @@
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "currency.hpp"
+#include "ledger.hpp"
+#include "money.hpp"
+#include "transfer_executor.hpp"
+
+namespace {
+    const std::size_t accounts = 1000000;
+
+    /// Builds transfers between pseudo-random accounts, every tenth to a hot merchant
+    std::vector<mc::transfer> make_transfers(std::size_t count) {
+        std::vector<mc::transfer> transfers;
+        transfers.reserve(count);
+        std::uint64_t state = 88172645463325252ULL;
+        for (std::size_t i = 0; i < count; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            const auto from = static_cast<mc::account_id>(state % accounts);
+            const auto to = state % 10 == 0 ? 0 : static_cast<mc::account_id>((state >> 32) % accounts);
+            transfers.push_back(mc::transfer{from, to, mc::currency::USD, state % 100000 + 1});
+        }
+        return transfers;
+    }
+
+    void run_transfers(std::size_t count) {
+        const std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+        const std::vector<mc::transfer> transfers = make_transfers(count);
+        const std::string suffix = ", " + std::to_string(count) + " transfers";
+
+        mc::ledger book;
+        mc::journal_batch funding;
+        const auto bank = book.open_account(mc::currency::USD);
+        std::vector<mc::money> balances;
+        std::vector<std::mutex> locks(accounts);
+        for (std::size_t i = 0; i < accounts; ++i) {
+            funding.add({{book.open_account(mc::currency::USD), mc::currency::USD, 1LL << 40},
+                         {bank, mc::currency::USD, -(1LL << 40)}});
+            balances.push_back(mc::money::from_amount(mc::currency::USD, 1ULL << 40));
+        }
+        book.post(funding);
+
+        BENCHMARK("locked money transfers, " + std::to_string(threads) + " threads" + suffix) {
+            std::vector<std::thread> workers;
+            for (std::size_t t = 0; t < threads; ++t) {
+                workers.emplace_back([&, t] {
+                    for (std::size_t i = t * count / threads; i < (t + 1) * count / threads; ++i) {
+                        const mc::transfer& tr = transfers[i];
+                        if (tr.from == tr.to) {
+                            continue;
+                        }
+                        // lock both accounts in ID order to avoid deadlocks
+                        std::unique_lock<std::mutex> first(locks[std::min(tr.from, tr.to)]);
+                        std::unique_lock<std::mutex> second(locks[std::max(tr.from, tr.to)]);
+                        const auto value = mc::money::from_amount(mc::currency::USD, tr.amount);
+                        try {
+                            balances[tr.from] -= value;
+                            balances[tr.to] += value;
+                        } catch (const std::logic_error&) {
+                        }
+                    }
+                });
+            }
+            for (auto& w : workers) {
+                w.join();
+            }
+            return balances.size();
+        };
+
+        mc::transfer_executor executor(book, threads);
+        std::vector<mc::transfer_status> statuses;
+        BENCHMARK("transfer_executor, " + std::to_string(threads) + " threads" + suffix) {
+            return executor.execute(transfers, statuses);
+        };
+    }
+}
+
+TEST_CASE("Transfer throughput, 1M transfers", "[!benchmark][transfer_executor]") {
+    run_transfers(1000000);
+}
+
+TEST_CASE("Transfer throughput, 10M transfers", "[!benchmark][transfer_executor][.large]") {
+    run_transfers(10000000);
+}
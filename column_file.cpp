@@ -0,0 +1,427 @@
+#include "column_file.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace mc {
+
+    namespace impl {
+        constexpr char column_magic_[8] = {'M', 'C', 'C', 'O', 'L', 'U', 'M', 'N'};
+        constexpr std::uint32_t column_version_ = 1;
+
+        enum : std::uint8_t {
+            frame_of_reference_ = 0,
+            delta_ = 1
+        };
+
+        enum : std::uint8_t {
+            constant_currency_ = 0,
+            currency_runs_ = 1,
+            currency_dictionary_ = 2
+        };
+
+        /// A run of rows with the same currency, as stored in a block
+        struct currency_run_ {
+            std::uint32_t length;
+            std::uint8_t currency;
+            std::uint8_t reserved[3];
+        };
+
+        constexpr std::size_t pad8_(std::size_t size) noexcept {
+            return (size + 7) & ~std::size_t(7);
+        }
+
+        /// Size of count packed values of width bits, with a trailing zero word for unaligned reads
+        constexpr std::size_t packed_bytes_(std::size_t count, unsigned width) noexcept {
+            return ((count * width + 63) / 64 + 1) * 8;
+        }
+
+        unsigned bit_width_(std::uint64_t value) noexcept {
+            unsigned width = 0;
+            while (value != 0) {
+                ++width;
+                value >>= 1;
+            }
+            return width;
+        }
+
+        constexpr std::uint64_t zigzag_(std::int64_t value) noexcept {
+            return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+        }
+
+        constexpr std::uint64_t unzigzag_(std::uint64_t value) noexcept {
+            return (value >> 1) ^ (0 - (value & 1));
+        }
+
+        void pack_bits_(const std::uint64_t* values, std::size_t count, unsigned width, std::vector<char>& out) {
+            std::vector<std::uint64_t> words(packed_bytes_(count, width) / 8, 0);
+            if (width != 0) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    const std::size_t bit = i * width;
+                    const unsigned shift = bit & 63;
+                    words[bit >> 6] |= values[i] << shift;
+                    if (shift + width > 64) {
+                        words[(bit >> 6) + 1] |= values[i] >> (64 - shift);
+                    }
+                }
+            }
+            const char* bytes = reinterpret_cast<const char*>(words.data());
+            out.insert(out.end(), bytes, bytes + words.size() * 8);
+        }
+
+        std::uint64_t load_word_(const char* data) noexcept {
+            std::uint64_t word;
+            std::memcpy(&word, data, sizeof (word));
+            return word;
+        }
+
+        void unpack_bits_(const char* data, std::size_t count, unsigned width, std::uint64_t* out) noexcept {
+            if (width == 0) {
+                std::fill(out, out + count, 0);
+                return;
+            }
+            const std::uint64_t mask = width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+            for (std::size_t i = 0; i < count; ++i) {
+                const std::size_t bit = i * width;
+                const unsigned shift = bit & 63;
+                std::uint64_t value = load_word_(data + (bit >> 6) * 8) >> shift;
+                if (shift + width > 64) {
+                    value |= load_word_(data + ((bit >> 6) + 1) * 8) << (64 - shift);
+                }
+                out[i] = value & mask;
+            }
+        }
+
+        template<typename T>
+        void append_bytes_(std::vector<char>& out, const T& value) {
+            const char* bytes = reinterpret_cast<const char*>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof (T));
+        }
+
+        /// Encodes one block of rows, header included
+        void encode_block_(const std::int64_t* amounts, const std::uint8_t* currencies, std::size_t rows,
+                std::vector<std::uint64_t>& scratch, std::vector<char>& out) {
+            column_block header{};
+            header.rows = static_cast<std::uint32_t>(rows);
+
+            // amounts: offsets from the minimum, or deltas when they are narrower
+            header.min_amount = *std::min_element(amounts, amounts + rows);
+            header.max_amount = *std::max_element(amounts, amounts + rows);
+            const unsigned reference_width = bit_width_(static_cast<std::uint64_t>(header.max_amount) - static_cast<std::uint64_t>(header.min_amount));
+            std::uint64_t widest_delta = 0;
+            for (std::size_t i = 1; i < rows; ++i) {
+                widest_delta |= zigzag_(static_cast<std::int64_t>(static_cast<std::uint64_t>(amounts[i]) - static_cast<std::uint64_t>(amounts[i - 1])));
+            }
+            const unsigned delta_width = bit_width_(widest_delta);
+            scratch.resize(rows);
+            std::size_t packed = rows;
+            if (delta_width < reference_width) {
+                header.amount_encoding = delta_;
+                header.amount_width = static_cast<std::uint8_t>(delta_width);
+                header.base = amounts[0];
+                packed = rows - 1;
+                for (std::size_t i = 1; i < rows; ++i) {
+                    scratch[i - 1] = zigzag_(static_cast<std::int64_t>(static_cast<std::uint64_t>(amounts[i]) - static_cast<std::uint64_t>(amounts[i - 1])));
+                }
+            } else {
+                header.amount_encoding = frame_of_reference_;
+                header.amount_width = static_cast<std::uint8_t>(reference_width);
+                header.base = header.min_amount;
+                for (std::size_t i = 0; i < rows; ++i) {
+                    scratch[i] = static_cast<std::uint64_t>(amounts[i]) - static_cast<std::uint64_t>(header.min_amount);
+                }
+            }
+            std::vector<char> amount_section;
+            pack_bits_(scratch.data(), packed, header.amount_width, amount_section);
+            header.amount_bytes = amount_section.size();
+
+            // currencies: a constant, runs or dictionary indices, whichever is smallest
+            std::size_t runs = 1;
+            for (std::size_t i = 0; i < rows; ++i) {
+                header.currency_set[currencies[i] >> 6] |= std::uint64_t(1) << (currencies[i] & 63);
+                runs += i > 0 && currencies[i] != currencies[i - 1];
+            }
+            std::uint8_t dictionary[256];
+            std::uint8_t index_of[256] = {};
+            std::size_t distinct = 0;
+            for (unsigned c = 0; c < 256; ++c) {
+                if (header.currency_set[c >> 6] & (std::uint64_t(1) << (c & 63))) {
+                    index_of[c] = static_cast<std::uint8_t>(distinct);
+                    dictionary[distinct++] = static_cast<std::uint8_t>(c);
+                }
+            }
+            std::vector<char> currency_section;
+            const unsigned index_width = bit_width_(distinct - 1);
+            if (distinct == 1) {
+                header.currency_encoding = constant_currency_;
+                header.currency_entries = 1;
+                currency_section.assign(8, 0);
+                currency_section[0] = static_cast<char>(dictionary[0]);
+            } else if (runs * sizeof (currency_run_) <= pad8_(distinct) + packed_bytes_(rows, index_width)) {
+                header.currency_encoding = currency_runs_;
+                header.currency_entries = static_cast<std::uint32_t>(runs);
+                currency_run_ run{1, currencies[0], {}};
+                for (std::size_t i = 1; i < rows; ++i) {
+                    if (currencies[i] == run.currency) {
+                        ++run.length;
+                    } else {
+                        append_bytes_(currency_section, run);
+                        run = currency_run_{1, currencies[i], {}};
+                    }
+                }
+                append_bytes_(currency_section, run);
+            } else {
+                header.currency_encoding = currency_dictionary_;
+                header.currency_entries = static_cast<std::uint32_t>(distinct);
+                header.currency_width = static_cast<std::uint8_t>(index_width);
+                currency_section.assign(dictionary, dictionary + distinct);
+                currency_section.resize(pad8_(distinct), 0);
+                for (std::size_t i = 0; i < rows; ++i) {
+                    scratch[i] = index_of[currencies[i]];
+                }
+                pack_bits_(scratch.data(), rows, index_width, currency_section);
+            }
+            header.currency_bytes = static_cast<std::uint32_t>(currency_section.size());
+
+            append_bytes_(out, header);
+            out.insert(out.end(), currency_section.begin(), currency_section.end());
+            out.insert(out.end(), amount_section.begin(), amount_section.end());
+        }
+
+        [[noreturn]] void corrupt_() {
+            throw std::runtime_error("corrupt column file");
+        }
+
+        /// Decodes the rows of a block whose sections start at data
+        void decode_block_(const column_block& header, const char* data, std::int64_t* amounts, std::uint8_t* currencies,
+                std::vector<std::uint64_t>& scratch) {
+            const std::size_t rows = header.rows;
+            const char* currency_section = data;
+            const char* amount_section = data + header.currency_bytes;
+            scratch.resize(rows);
+
+            if (header.amount_width > 64 || rows == 0) {
+                corrupt_();
+            }
+            if (header.amount_encoding == delta_) {
+                if (header.amount_bytes < packed_bytes_(rows - 1, header.amount_width)) {
+                    corrupt_();
+                }
+                unpack_bits_(amount_section, rows - 1, header.amount_width, scratch.data());
+                std::uint64_t value = static_cast<std::uint64_t>(header.base);
+                amounts[0] = header.base;
+                for (std::size_t i = 1; i < rows; ++i) {
+                    value += unzigzag_(scratch[i - 1]);
+                    amounts[i] = static_cast<std::int64_t>(value);
+                }
+            } else if (header.amount_encoding == frame_of_reference_) {
+                if (header.amount_bytes < packed_bytes_(rows, header.amount_width)) {
+                    corrupt_();
+                }
+                unpack_bits_(amount_section, rows, header.amount_width, scratch.data());
+                const std::uint64_t base = static_cast<std::uint64_t>(header.base);
+                for (std::size_t i = 0; i < rows; ++i) {
+                    amounts[i] = static_cast<std::int64_t>(base + scratch[i]);
+                }
+            } else {
+                corrupt_();
+            }
+
+            if (header.currency_encoding == constant_currency_) {
+                if (header.currency_bytes < 1) {
+                    corrupt_();
+                }
+                std::memset(currencies, static_cast<std::uint8_t>(currency_section[0]), rows);
+            } else if (header.currency_encoding == currency_runs_) {
+                if (header.currency_bytes < std::size_t(header.currency_entries) * sizeof (currency_run_)) {
+                    corrupt_();
+                }
+                std::size_t row = 0;
+                for (std::size_t r = 0; r < header.currency_entries; ++r) {
+                    currency_run_ run;
+                    std::memcpy(&run, currency_section + r * sizeof (run), sizeof (run));
+                    if (run.length > rows - row) {
+                        corrupt_();
+                    }
+                    std::memset(currencies + row, run.currency, run.length);
+                    row += run.length;
+                }
+                if (row != rows) {
+                    corrupt_();
+                }
+            } else if (header.currency_encoding == currency_dictionary_) {
+                const std::size_t entries = header.currency_entries;
+                if (entries == 0 || entries > 256 || header.currency_width > 8
+                        || header.currency_bytes < pad8_(entries) + packed_bytes_(rows, header.currency_width)) {
+                    corrupt_();
+                }
+                unpack_bits_(currency_section + pad8_(entries), rows, header.currency_width, scratch.data());
+                for (std::size_t i = 0; i < rows; ++i) {
+                    if (scratch[i] >= entries) {
+                        corrupt_();
+                    }
+                    currencies[i] = static_cast<std::uint8_t>(currency_section[scratch[i]]);
+                }
+            } else {
+                corrupt_();
+            }
+        }
+    }
+
+    bool column_block::contains(mc::currency curr) const noexcept {
+        const unsigned c = static_cast<std::uint8_t>(curr);
+        return (currency_set[c >> 6] >> (c & 63)) & 1;
+    }
+
+    void write_column_file(const std::string& path, const money_column& column, std::size_t block_rows) {
+        if (block_rows == 0 || block_rows > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::invalid_argument("invalid number of rows per block");
+        }
+        std::FILE* out = std::fopen(path.c_str(), "wb");
+        if (out == nullptr) {
+            throw std::runtime_error("cannot write column file: " + path);
+        }
+
+        column_file_header header{};
+        std::memcpy(header.magic, impl::column_magic_, sizeof (header.magic));
+        header.version = impl::column_version_;
+        header.block_rows = static_cast<std::uint32_t>(block_rows);
+        header.rows = column.size();
+        header.blocks = (column.size() + block_rows - 1) / block_rows;
+        bool written = std::fwrite(&header, sizeof (header), 1, out) == 1;
+
+        std::vector<std::uint64_t> offsets;
+        std::vector<std::uint64_t> scratch;
+        std::vector<char> block;
+        std::uint64_t offset = sizeof (header);
+        for (std::size_t begin = 0; written && begin < column.size(); begin += block_rows) {
+            const std::size_t rows = std::min(block_rows, column.size() - begin);
+            block.clear();
+            impl::encode_block_(column.amounts() + begin, column.currencies() + begin, rows, scratch, block);
+            written = std::fwrite(block.data(), 1, block.size(), out) == block.size();
+            offsets.push_back(offset);
+            offset += block.size();
+        }
+        written = written && (offsets.empty()
+                || std::fwrite(offsets.data(), sizeof (std::uint64_t), offsets.size(), out) == offsets.size());
+        written = std::fclose(out) == 0 && written;
+        if (!written) {
+            std::remove(path.c_str());
+            throw std::runtime_error("cannot write column file: " + path);
+        }
+    }
+
+    column_file::column_file(const std::string& path) :
+    _file(path), _header() {
+        if (_file.size() < sizeof (_header)) {
+            throw std::runtime_error("not a column file: " + path);
+        }
+        std::memcpy(&_header, _file.data(), sizeof (_header));
+        if (std::memcmp(_header.magic, impl::column_magic_, sizeof (_header.magic)) != 0
+                || _header.version != impl::column_version_ || _header.block_rows == 0
+                || _header.blocks > (_file.size() - sizeof (_header)) / sizeof (std::uint64_t)
+                || _header.blocks != (_header.rows + _header.block_rows - 1) / _header.block_rows) {
+            throw std::runtime_error("not a column file: " + path);
+        }
+        const std::size_t directory = _file.size() - _header.blocks * sizeof (std::uint64_t);
+        for (std::size_t i = 0; i < _header.blocks; ++i) {
+            const std::uint64_t offset = impl::load_word_(_file.data() + directory + i * sizeof (std::uint64_t));
+            if (offset < sizeof (_header) || offset > directory || directory - offset < sizeof (column_block)) {
+                throw std::runtime_error("not a column file: " + path);
+            }
+        }
+    }
+
+    std::size_t column_file::size() const noexcept {
+        return static_cast<std::size_t>(_header.rows);
+    }
+
+    std::size_t column_file::blocks() const noexcept {
+        return static_cast<std::size_t>(_header.blocks);
+    }
+
+    column_block column_file::block(std::size_t index) const {
+        if (index >= blocks()) {
+            throw std::out_of_range("block index out of range");
+        }
+        column_block header;
+        block_data(index, header);
+        return header;
+    }
+
+    const char* column_file::block_data(std::size_t index, column_block& header) const {
+        const std::size_t directory = _file.size() - blocks() * sizeof (std::uint64_t);
+        const std::uint64_t offset = impl::load_word_(_file.data() + directory + index * sizeof (std::uint64_t));
+        std::memcpy(&header, _file.data() + offset, sizeof (header));
+        const std::uint64_t available = directory - offset - sizeof (header);
+        if (header.currency_bytes > available || header.amount_bytes > available - header.currency_bytes
+                || header.rows > _header.block_rows) {
+            impl::corrupt_();
+        }
+        return _file.data() + offset + sizeof (header);
+    }
+
+    void column_file::read(money_column& out) const {
+        std::size_t row = out.size();
+        out.resize(row + size());
+        std::vector<std::uint64_t> scratch;
+        for (std::size_t b = 0; b < blocks(); ++b) {
+            column_block header;
+            const char* data = block_data(b, header);
+            if (header.rows > out.size() - row) {
+                impl::corrupt_();
+            }
+            impl::decode_block_(header, data, out.amounts() + row, out.currencies() + row, scratch);
+            row += header.rows;
+        }
+        out.resize(row);
+    }
+
+    std::size_t column_file::scan(const column_filter& filter, money_column& out, std::size_t* skipped) const {
+        const std::size_t start = out.size();
+        std::size_t count = start;
+        std::size_t skipped_blocks = 0;
+        std::vector<std::int64_t> amounts(_header.block_rows);
+        std::vector<std::uint8_t> currencies(_header.block_rows);
+        std::vector<std::uint64_t> scratch;
+        const std::uint8_t wanted = static_cast<std::uint8_t>(filter.currency);
+
+        for (std::size_t b = 0; b < blocks(); ++b) {
+            column_block header;
+            const char* data = block_data(b, header);
+            if ((filter.match_currency && !header.contains(filter.currency))
+                    || header.max_amount < filter.min_amount || header.min_amount > filter.max_amount) {
+                ++skipped_blocks;
+                continue;
+            }
+            impl::decode_block_(header, data, amounts.data(), currencies.data(), scratch);
+            out.resize(count + header.rows);
+            std::int64_t* out_amounts = out.amounts();
+            std::uint8_t* out_currencies = out.currencies();
+
+            const bool all_currencies = !filter.match_currency
+                    || (header.currency_encoding == impl::constant_currency_ && currencies[0] == wanted);
+            if (all_currencies && header.min_amount >= filter.min_amount && header.max_amount <= filter.max_amount) {
+                // the zone map proves that every row matches
+                std::memcpy(out_amounts + count, amounts.data(), header.rows * sizeof (std::int64_t));
+                std::memcpy(out_currencies + count, currencies.data(), header.rows);
+                count += header.rows;
+                continue;
+            }
+            for (std::size_t i = 0; i < header.rows; ++i) {
+                out_amounts[count] = amounts[i];
+                out_currencies[count] = currencies[i];
+                count += (all_currencies || currencies[i] == wanted)
+                        & (amounts[i] >= filter.min_amount) & (amounts[i] <= filter.max_amount);
+            }
+        }
+        out.resize(count);
+        if (skipped != nullptr) {
+            *skipped = skipped_blocks;
+        }
+        return count - start;
+    }
+}
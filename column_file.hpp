@@ -0,0 +1,152 @@
+/**
+ * @file column_file.hpp
+ * @brief Compressed columnar file format for money columns.
+ *
+ * A column file stores a money column in blocks of rows. Within a block the
+ * amounts are bit-packed either as offsets from the block minimum (frame of
+ * reference) or as zigzag deltas between neighbours, whichever is narrower,
+ * and the currencies are stored as a single constant, as runs, or as
+ * bit-packed indices into a block dictionary. Every block header doubles as
+ * a zone map holding the amount range and the set of currencies, so a
+ * memory-mapped reader skips the blocks a filter cannot match.
+ *
+ * The file starts with a column_file_header, continues with the blocks and
+ * ends with the file offset of every block.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef COLUMN_FILE_HPP
+#define COLUMN_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include "mapped_file.hpp"
+#include "money_column.hpp"
+
+namespace mc {
+
+    /**
+     * @brief Header at the start of every column file.
+     */
+    struct column_file_header {
+        char magic[8];            ///< Always "MCCOLUMN"
+        std::uint32_t version;    ///< Format version, currently 1
+        std::uint32_t block_rows; ///< Largest number of rows per block
+        std::uint64_t rows;       ///< Number of rows of all blocks
+        std::uint64_t blocks;     ///< Number of blocks
+    };
+
+    /**
+     * @brief Header of a block and zone map of its rows.
+     */
+    struct column_block {
+        std::uint32_t rows;              ///< Number of rows
+        std::uint8_t amount_encoding;    ///< 0 for frame of reference, 1 for deltas
+        std::uint8_t amount_width;       ///< Bits per packed amount
+        std::uint8_t currency_encoding;  ///< 0 for a constant, 1 for runs, 2 for a dictionary
+        std::uint8_t currency_width;     ///< Bits per packed dictionary index
+        std::int64_t min_amount;         ///< Smallest amount of the block
+        std::int64_t max_amount;         ///< Largest amount of the block
+        std::int64_t base;               ///< Reference amount: the minimum, or the first amount for deltas
+        std::uint64_t currency_set[4];   ///< Bit c is set if currency index c occurs in the block
+        std::uint32_t currency_entries;  ///< Number of dictionary entries or runs
+        std::uint32_t currency_bytes;    ///< Size of the currency section
+        std::uint64_t amount_bytes;      ///< Size of the amount section
+
+        /**
+         * @brief Checks whether a currency occurs in the block.
+         * @param curr The currency
+         * @return true if at least one row has the currency, false otherwise
+         */
+        bool contains(mc::currency curr) const noexcept;
+    };
+
+    static_assert(sizeof(column_block) == 80, "column block headers must be 80 bytes");
+
+    /**
+     * @brief Rows selected by a column file scan.
+     *
+     * Amount bounds are inclusive.
+     */
+    struct column_filter {
+        bool match_currency = false;                                      ///< Whether only one currency is selected
+        mc::currency currency = mc::currency::AED;                        ///< The selected currency
+        std::int64_t min_amount = std::numeric_limits<std::int64_t>::min(); ///< Smallest selected amount
+        std::int64_t max_amount = std::numeric_limits<std::int64_t>::max(); ///< Largest selected amount
+    };
+
+    /**
+     * @brief Writes a money column to a column file.
+     * @param path Path to the column file
+     * @param column The values to write
+     * @param block_rows Largest number of rows per block
+     * @throws std::invalid_argument if block_rows is zero
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void write_column_file(const std::string& path, const money_column& column, std::size_t block_rows = 65536);
+
+    /**
+     * @brief A memory-mapped column file.
+     */
+    class column_file {
+        mapped_file _file;          ///< Mapped file contents
+        column_file_header _header; ///< Copy of the validated header
+    public:
+        /**
+         * @brief Maps a column file and checks its header and block directory.
+         * @param path Path to the column file
+         * @throws std::runtime_error if the file cannot be mapped or is not a column file
+         */
+        explicit column_file(const std::string& path);
+
+        /**
+         * @brief Gets the number of rows.
+         * @return The number of rows
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * @brief Gets the number of blocks.
+         * @return The number of blocks
+         */
+        std::size_t blocks() const noexcept;
+
+        /**
+         * @brief Gets the header and zone map of a block.
+         * @param index Index of the block
+         * @return The block header
+         * @throws std::out_of_range if the index is out of range
+         */
+        column_block block(std::size_t index) const;
+
+        /**
+         * @brief Decodes all rows.
+         * @param out Receives the rows, appended to its current contents
+         * @throws std::runtime_error if a block is corrupt
+         */
+        void read(money_column& out) const;
+
+        /**
+         * @brief Decodes the rows matching a filter.
+         *
+         * Blocks whose zone map excludes the filter are skipped without
+         * decoding them.
+         *
+         * @param filter The rows to select
+         * @param out Receives the matching rows, appended to its current contents
+         * @param skipped If not null, receives the number of skipped blocks
+         * @return The number of matching rows
+         * @throws std::runtime_error if a block is corrupt
+         */
+        std::size_t scan(const column_filter& filter, money_column& out, std::size_t* skipped = nullptr) const;
+
+    private:
+        const char* block_data(std::size_t index, column_block& header) const;
+    };
+}
+
+#endif /* COLUMN_FILE_HPP */
@@ -28,7 +28,7 @@ class MoneyConan(ConanFile):
     }
     
     # Sources are located in the same place as this recipe, copy them to the recipe
-    exports_sources = "CMakeLists.txt", "*.cpp", "*.hpp", "tests/*"
+    exports_sources = "CMakeLists.txt", "*.cpp", "*.hpp", "cmake/*", "tests/*", "benchmarks/*"
     
     def config_options(self):
         if self.settings.os == "Windows":
@@ -66,6 +66,8 @@ class MoneyConan(ConanFile):
     
     def package_info(self):
         self.cpp_info.libs = ["money"]
+        if self.settings.os in ["Linux", "FreeBSD"]:
+            self.cpp_info.system_libs = ["pthread", "atomic"]
         self.cpp_info.set_property("cmake_file_name", "money")
         self.cpp_info.set_property("cmake_target_name", "money::money")
         
@@ -0,0 +1,339 @@
+#include "csv_reader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace mc {
+
+    namespace impl {
+        /// Bytes a fast row parse may read past the start of a line
+        constexpr std::ptrdiff_t csv_lookahead_ = 64;
+
+        constexpr std::uint64_t powers_of_10_[9] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+
+        unsigned lowest_bit_(std::uint64_t value) noexcept {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward64(&index, value);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+        }
+
+        /**
+         * Parses the leading digits of 8 bytes at once: digit bytes are told
+         * apart from delimiters within a 64-bit word, and the digits are
+         * combined by three multiplications. Returns the number of leading
+         * digits, 0 to 8.
+         */
+        unsigned parse_8_digits_(const char* data, std::uint64_t& value) noexcept {
+            std::uint64_t word;
+            std::memcpy(&word, data, sizeof (word));
+            word ^= 0x3030303030303030ULL;
+            const std::uint64_t delimiters = (((word & 0x7F7F7F7F7F7F7F7FULL) + 0x7676767676767676ULL) | word) & 0x8080808080808080ULL;
+            const unsigned digits = delimiters != 0 ? lowest_bit_(delimiters) / 8 : 8;
+            if (digits == 0) {
+                return 0;
+            }
+            word <<= 64 - 8 * digits;
+            word = (word * 10 + (word >> 8)) & 0x00FF00FF00FF00FFULL;
+            word = (word * 100 + (word >> 16)) & 0x0000FFFF0000FFFFULL;
+            value = (word * 10000 + (word >> 32)) & 0xFFFFFFFFULL;
+            return digits;
+        }
+
+        /// Parses up to 15 leading digits, 8 at a time; returns 0 if there are none or more
+        unsigned parse_15_digits_(const char* data, std::uint64_t& value) noexcept {
+            unsigned digits = parse_8_digits_(data, value);
+            if (digits == 8) {
+                std::uint64_t low = 0;
+                const unsigned more = parse_8_digits_(data + 8, low);
+                value = value * powers_of_10_[more] + low;
+                digits = more == 8 ? 0 : digits + more;
+            }
+            return digits;
+        }
+
+        /// Parses up to max_digits decimal digits, false if there are none, other characters or an overflow
+        bool parse_digits_(const char* begin, const char* end, std::size_t max_digits, std::uint64_t& value) noexcept {
+            if (begin == end || static_cast<std::size_t>(end - begin) > max_digits) {
+                return false;
+            }
+            std::uint64_t result = 0;
+            for (const char* p = begin; p != end; ++p) {
+                const unsigned digit = static_cast<unsigned char>(*p) - '0';
+                if (digit > 9) {
+                    return false;
+                }
+                if (result > (~std::uint64_t(0) - digit) / 10) {
+                    return false;
+                }
+                result = result * 10 + digit;
+            }
+            value = result;
+            return true;
+        }
+
+        /// Parses "[-]digits[.d[d]]" exactly into smallest currency units
+        bool parse_amount_(const char* begin, const char* end, std::int64_t& amount) noexcept {
+            const bool negative = begin != end && *begin == '-';
+            begin += negative;
+            const char* p = begin;
+            std::uint64_t value = 0;
+            while (p != end) {
+                const unsigned digit = static_cast<unsigned char>(*p) - '0';
+                if (digit > 9) {
+                    break;
+                }
+                value = value * 10 + digit;
+                ++p;
+            }
+            if (p == begin || p - begin > 16) {
+                return false;
+            }
+            value *= 100;
+            if (p != end) {
+                const std::ptrdiff_t decimals = end - p - 1;
+                const unsigned tens = static_cast<unsigned char>(p[1]) - '0';
+                if (*p != '.' || decimals < 1 || decimals > 2 || tens > 9) {
+                    return false;
+                }
+                value += tens * 10;
+                if (decimals == 2) {
+                    const unsigned units = static_cast<unsigned char>(p[2]) - '0';
+                    if (units > 9) {
+                        return false;
+                    }
+                    value += units;
+                }
+            }
+            amount = negative ? -static_cast<std::int64_t>(value) : static_cast<std::int64_t>(value);
+            return true;
+        }
+
+        /// Resolves currency codes through a small direct-mapped cache in front of find_currency()
+        struct currency_cache_ {
+            std::uint32_t keys[64] = {};
+            std::uint8_t values[64] = {};
+
+            bool find(const char* code, std::uint8_t& result) noexcept {
+                const std::uint32_t key = static_cast<std::uint8_t>(code[0]) | static_cast<std::uint8_t>(code[1]) << 8
+                        | static_cast<std::uint32_t>(static_cast<std::uint8_t>(code[2])) << 16 | 1u << 24;
+                const std::uint32_t slot = (key * 2654435761u) >> 26;
+                if (keys[slot] != key) {
+                    currency c;
+                    if (!find_currency(std::string_view(code, 3), c)) {
+                        return false;
+                    }
+                    keys[slot] = key;
+                    values[slot] = static_cast<std::uint8_t>(c);
+                }
+                result = values[slot];
+                return true;
+            }
+        };
+
+        /// Output arrays of a parse
+        struct csv_row_ {
+            std::uint64_t* ids;
+            std::int64_t* amounts;
+            std::uint8_t* currencies;
+        };
+
+        /**
+         * Parses a common row ending with "\n", which must be followed by at
+         * least csv_lookahead_ readable bytes. Returns false without changes
+         * for anything else, which parse_line_() then handles.
+         */
+        bool parse_row_fast_(const char*& line, const csv_row_& out, std::size_t row, currency_cache_& cache) noexcept {
+            const char* p = line;
+            std::uint64_t id;
+            unsigned digits = parse_15_digits_(p, id);
+            if (digits == 0 || p[digits] != ',') {
+                return false;
+            }
+            p += digits + 1;
+            const bool negative = *p == '-';
+            p += negative;
+            std::uint64_t amount;
+            digits = parse_15_digits_(p, amount);
+            if (digits == 0) {
+                return false;
+            }
+            p += digits;
+            amount *= 100;
+            if (*p == '.') {
+                const unsigned tens = static_cast<unsigned char>(p[1]) - '0';
+                const unsigned units = static_cast<unsigned char>(p[2]) - '0';
+                if (tens > 9) {
+                    return false;
+                }
+                amount += tens * 10;
+                if (units <= 9) {
+                    amount += units;
+                    ++p;
+                }
+                p += 2;
+            }
+            if (*p != ',' || p[4] != '\n' || !cache.find(p + 1, out.currencies[row])) {
+                return false;
+            }
+            out.ids[row] = id;
+            out.amounts[row] = negative ? -static_cast<std::int64_t>(amount) : static_cast<std::int64_t>(amount);
+            line = p + 5;
+            return true;
+        }
+
+        /// Parses the row from line to end, without its newline
+        bool parse_line_(const char* line, const char* end, const csv_row_& out, std::size_t row, currency_cache_& cache) noexcept {
+            end -= end != line && end[-1] == '\r';
+            const char* first = static_cast<const char*>(std::memchr(line, ',', static_cast<std::size_t>(end - line)));
+            if (first == nullptr) {
+                return false;
+            }
+            const char* second = static_cast<const char*>(std::memchr(first + 1, ',', static_cast<std::size_t>(end - first - 1)));
+            return second != nullptr && end - second == 4
+                    && parse_digits_(line, first, 20, out.ids[row])
+                    && parse_amount_(first + 1, second, out.amounts[row])
+                    && cache.find(second + 1, out.currencies[row]);
+        }
+
+        [[noreturn]] void malformed_row_(const char* file, const char* line) {
+            throw std::invalid_argument("malformed csv row at byte " + std::to_string(line - file));
+        }
+
+        /// Start of the first line that begins at or after offset
+        const char* line_start_(const char* data, std::size_t size, std::size_t offset) noexcept {
+            if (offset == 0) {
+                return data;
+            }
+            if (offset >= size) {
+                return data + size;
+            }
+            const void* newline = std::memchr(data + offset - 1, '\n', size - offset + 1);
+            return newline != nullptr ? static_cast<const char*>(newline) + 1 : data + size;
+        }
+
+        void append_chunk_(csv_chunk& out, const csv_chunk& rows) {
+            const std::size_t first = out.ids.size();
+            out.ids.insert(out.ids.end(), rows.ids.begin(), rows.ids.end());
+            out.values.resize(first + rows.values.size());
+            if (!rows.values.empty()) {
+                std::memcpy(out.values.amounts() + first, rows.values.amounts(), rows.values.size() * sizeof (std::int64_t));
+                std::memcpy(out.values.currencies() + first, rows.values.currencies(), rows.values.size());
+            }
+        }
+    }
+
+    csv_reader::csv_reader(const std::string& path, std::size_t part, std::size_t parts, std::size_t chunk_rows) :
+    _file(path), _next(nullptr), _end(nullptr), _chunk_rows(chunk_rows) {
+        if (part >= parts || chunk_rows == 0) {
+            throw std::invalid_argument("invalid csv part or chunk size");
+        }
+        const char* data = _file.data();
+        const std::size_t size = _file.size();
+        _next = impl::line_start_(data, size, size / parts * part + size % parts * part / parts);
+        _end = part + 1 == parts ? data + size
+                : impl::line_start_(data, size, size / parts * (part + 1) + size % parts * (part + 1) / parts);
+        if (part == 0 && _next != _end && static_cast<unsigned>(static_cast<unsigned char>(*_next) - '0') > 9) {
+            // header line
+            const void* newline = std::memchr(_next, '\n', static_cast<std::size_t>(_end - _next));
+            _next = newline != nullptr ? static_cast<const char*>(newline) + 1 : _end;
+        }
+    }
+
+    bool csv_reader::next(csv_chunk& chunk) {
+        chunk.ids.clear();
+        chunk.values.clear();
+        return parse(chunk, _chunk_rows) > 0;
+    }
+
+    std::size_t csv_reader::read_all(csv_chunk& out) {
+        return parse(out, static_cast<std::size_t>(-1));
+    }
+
+    std::size_t csv_reader::parse(csv_chunk& out, std::size_t max_rows) {
+        const char* const file = _file.data();
+        const std::size_t start = out.ids.size();
+        const std::size_t limit = max_rows < static_cast<std::size_t>(-1) - start ? start + max_rows : static_cast<std::size_t>(-1);
+        std::size_t rows = start;
+        std::size_t capacity = start;
+        impl::csv_row_ row{};
+        impl::currency_cache_ cache;
+
+        const char* line = _next;
+        while (rows < limit && line < _end) {
+            if (rows == capacity) {
+                // room for the rest of the part, at the average row length so far
+                const double rows_per_byte = static_cast<double>(rows - start) / static_cast<double>(line - _next + 1);
+                capacity = std::min(limit, rows + 1024 + static_cast<std::size_t>(static_cast<double>(_end - line) * rows_per_byte * 1.125));
+                out.ids.resize(capacity);
+                out.values.resize(capacity);
+                row = impl::csv_row_{out.ids.data(), out.values.amounts(), out.values.currencies()};
+            }
+            if (_end - line >= impl::csv_lookahead_ && impl::parse_row_fast_(line, row, rows, cache)) {
+                ++rows;
+                continue;
+            }
+            const char* newline = static_cast<const char*>(std::memchr(line, '\n', static_cast<std::size_t>(_end - line)));
+            const char* end = newline != nullptr ? newline : _end;
+            if (end != line && !(end == line + 1 && *line == '\r')) {
+                if (!impl::parse_line_(line, end, row, rows, cache)) {
+                    impl::malformed_row_(file, line);
+                }
+                ++rows;
+            }
+            line = newline != nullptr ? newline + 1 : _end;
+        }
+        _next = line;
+        out.ids.resize(rows);
+        out.values.resize(rows);
+        return rows - start;
+    }
+
+    std::size_t read_csv(const std::string& path, csv_chunk& out, std::size_t threads) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        if (threads == 1) {
+            csv_reader reader(path);
+            return reader.read_all(out);
+        }
+        std::vector<csv_chunk> parts(threads);
+        std::vector<std::exception_ptr> errors(threads);
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (std::size_t p = 0; p < threads; ++p) {
+            workers.emplace_back([&, p] {
+                try {
+                    csv_reader reader(path, p, threads);
+                    reader.read_all(parts[p]);
+                } catch (...) {
+                    errors[p] = std::current_exception();
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        for (const std::exception_ptr& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+        std::size_t total = 0;
+        for (const csv_chunk& part : parts) {
+            impl::append_chunk_(out, part);
+            total += part.ids.size();
+        }
+        return total;
+    }
+}
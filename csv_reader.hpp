@@ -0,0 +1,100 @@
+/**
+ * @file csv_reader.hpp
+ * @brief Streaming reader of "id,amount,currency" CSV files.
+ *
+ * The file is memory-mapped and parsed in place. Fields are read 8 bytes
+ * at a time: the delimiter ending a number is located by classifying all
+ * bytes of a 64-bit word at once and its digits are combined without a
+ * loop. Amounts are parsed exactly into smallest currency units and
+ * currency codes are resolved through find_currency(), so no row
+ * allocates. A reader can cover only a part of the file, split at line
+ * boundaries, so several readers parse one file in parallel.
+ *
+ * Rows look like "1042,-1234.56,USD": an unsigned id, an amount with an
+ * optional minus sign, at most 16 integral digits and at most two decimals,
+ * and a three-letter currency code. Lines may end with "\r\n", empty lines
+ * are ignored and a first line that does not start with a digit is taken
+ * as a header and skipped.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef CSV_READER_HPP
+#define CSV_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "mapped_file.hpp"
+#include "money_column.hpp"
+
+namespace mc {
+
+    /**
+     * @brief Rows read from a CSV file.
+     */
+    struct csv_chunk {
+        std::vector<std::uint64_t> ids; ///< Id of every row
+        money_column values;            ///< Amount and currency of every row
+    };
+
+    /**
+     * @brief Reads a CSV file, or a part of it, in chunks.
+     */
+    class csv_reader {
+        mapped_file _file;       ///< Mapped file contents
+        const char* _next;       ///< Start of the next unread line
+        const char* _end;        ///< End of the part read by this reader
+        std::size_t _chunk_rows; ///< Largest number of rows per chunk
+    public:
+        /**
+         * @brief Maps a CSV file and selects the part to read.
+         *
+         * The file is cut into parts of about equal size, moved forward to
+         * the next line start, so the parts of one file together read every
+         * line exactly once.
+         *
+         * @param path Path to the CSV file
+         * @param part Index of the part to read
+         * @param parts Number of parts
+         * @param chunk_rows Largest number of rows returned by next()
+         * @throws std::runtime_error if the file cannot be mapped
+         * @throws std::invalid_argument if part is not less than parts, or chunk_rows is zero
+         */
+        explicit csv_reader(const std::string& path, std::size_t part = 0, std::size_t parts = 1, std::size_t chunk_rows = 65536);
+
+        /**
+         * @brief Reads the next rows.
+         * @param chunk Receives the rows, replacing its contents
+         * @return false if there were no rows left, true otherwise
+         * @throws std::invalid_argument if a row is malformed or has an unknown currency
+         */
+        bool next(csv_chunk& chunk);
+
+        /**
+         * @brief Reads all remaining rows.
+         * @param out Receives the rows, appended to its current contents
+         * @return The number of rows read
+         * @throws std::invalid_argument if a row is malformed or has an unknown currency
+         */
+        std::size_t read_all(csv_chunk& out);
+
+    private:
+        std::size_t parse(csv_chunk& out, std::size_t max_rows);
+    };
+
+    /**
+     * @brief Reads a whole CSV file in parallel.
+     * @param path Path to the CSV file
+     * @param out Receives the rows in file order, appended to its current contents
+     * @param threads Number of threads, 0 for one per hardware thread
+     * @return The number of rows read
+     * @throws std::runtime_error if the file cannot be mapped
+     * @throws std::invalid_argument if a row is malformed or has an unknown currency
+     */
+    std::size_t read_csv(const std::string& path, csv_chunk& out, std::size_t threads = 0);
+}
+
+#endif /* CSV_READER_HPP */
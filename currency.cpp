@@ -1,7 +1,14 @@
 #include "currency.hpp"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include "currency_info.hpp"
 
 namespace mc {
 //    namespace impl {
@@ -513,10 +520,92 @@ namespace mc {
         };
     }
 
+    namespace impl {
+        constexpr std::uint8_t no_currency_ = 0xFF;
+        constexpr std::size_t code_table_size_ = 26 * 26 * 26;
+
+        /// Maps a three-letter code to its index in a 26^3 table, or code_table_size_
+        inline std::size_t code_index_(char a, char b, char c) noexcept {
+            const unsigned ia = static_cast<unsigned>((a | 0x20) - 'a');
+            const unsigned ib = static_cast<unsigned>((b | 0x20) - 'a');
+            const unsigned ic = static_cast<unsigned>((c | 0x20) - 'a');
+            if (ia >= 26 || ib >= 26 || ic >= 26) {
+                return code_table_size_;
+            }
+            return (ia * 26 + ib) * 26 + ic;
+        }
+
+        constexpr std::size_t max_registered_ = max_currency_count - currency_count;
+
+        /**
+         * Lookup tables of all known currencies. The ISO part is filled on
+         * first use. Registration appends a unit under the mutex and then
+         * publishes it with release stores to count and to its code slot, so
+         * lookups synchronize with a single acquire load and never lock.
+         */
+        struct currency_tables_ {
+            std::array<std::atomic<std::uint8_t>, code_table_size_> codes; ///< Currency per code index
+            std::array<char, max_currency_count * 3> code_names;           ///< Three-byte code per currency
+            std::array<currency_info, max_registered_> infos;             ///< Metadata of registered units
+            std::array<std::string, max_registered_> names;               ///< Names of registered units
+            std::array<std::string, max_registered_> symbols;             ///< Symbols of registered units
+            std::atomic<std::size_t> count;                               ///< Number of known currencies
+            std::mutex mutex;                                             ///< Serializes registrations
+
+            currency_tables_() : code_names{}, infos{}, count(currency_count) {
+                for (std::atomic<std::uint8_t>& slot : codes) {
+                    slot.store(no_currency_, std::memory_order_relaxed);
+                }
+                for (const auto& entry : shortname_to_currency_) {
+                    const std::string& code = entry.first;
+                    const std::size_t index = code_index_(code[0], code[1], code[2]);
+                    if (index < code_table_size_) {
+                        codes[index].store(static_cast<std::uint8_t>(entry.second), std::memory_order_relaxed);
+                    }
+                }
+                for (const auto& entry : currency_to_shortname_) {
+                    const std::size_t index = static_cast<std::size_t>(entry.first);
+                    if (index < currency_count && entry.second.size() == 3) {
+                        std::copy(entry.second.begin(), entry.second.end(), code_names.begin() + index * 3);
+                    }
+                }
+            }
+        };
+
+        currency_tables_& currency_tables_instance_() {
+            static currency_tables_ tables;
+            return tables;
+        }
+
+        /// Index of a registered unit in the registry arrays, or max_registered_
+        std::size_t registered_index_(currency c) noexcept {
+            const std::size_t index = static_cast<std::size_t>(c);
+            if (index < currency_count || index >= currency_tables_instance_().count.load(std::memory_order_acquire)) {
+                return max_registered_;
+            }
+            return index - currency_count;
+        }
+
+        const currency_info& registered_info_(currency c) noexcept {
+            static const currency_info none{};
+            const std::size_t index = registered_index_(c);
+            return index == max_registered_ ? none : currency_tables_instance_().infos[index];
+        }
+
+        std::string_view registered_symbol_(currency c) noexcept {
+            const std::size_t index = registered_index_(c);
+            return index == max_registered_ ? std::string_view() : std::string_view(currency_tables_instance_().symbols[index]);
+        }
+    }
+
     std::string to_string(currency c) {
         using namespace impl;
         if (currency_name_.find(c) == currency_name_.end()) {
-            throw unknown_currency();
+            const std::size_t index = registered_index_(c);
+            if (index == max_registered_) {
+                throw unknown_currency();
+            }
+            return currency_tables_instance_().names[index];
         }
         return currency_name_.at(c);
     }
@@ -524,7 +613,10 @@ namespace mc {
     std::string to_shortname(currency c) {
         using namespace impl;
         if (currency_to_shortname_.find(c) == currency_to_shortname_.end()) {
-            throw unknown_currency();
+            if (registered_index_(c) == max_registered_) {
+                throw unknown_currency();
+            }
+            return std::string(to_code(c));
         }
         return currency_to_shortname_.at(c);
     }
@@ -535,11 +627,76 @@ namespace mc {
         upper_sn.resize(sn.size());
         std::transform(sn.begin(), sn.end(), upper_sn.begin(), ::toupper);
         if (shortname_to_currency_.find(upper_sn) == shortname_to_currency_.end()) {
-            throw unknown_currency_shortname();
+            currency registered;
+            if (!find_currency(upper_sn, registered)) {
+                throw unknown_currency_shortname();
+            }
+            return registered;
         }
         return shortname_to_currency_.at(upper_sn);
     }
 
+    bool find_currency(std::string_view code, currency& result) noexcept {
+        using namespace impl;
+        if (code.size() != 3) {
+            return false;
+        }
+        const std::size_t index = code_index_(code[0], code[1], code[2]);
+        if (index == code_table_size_) {
+            return false;
+        }
+        const std::uint8_t value = currency_tables_instance_().codes[index].load(std::memory_order_acquire);
+        if (value == no_currency_) {
+            return false;
+        }
+        result = static_cast<currency>(value);
+        return true;
+    }
+
+    std::string_view to_code(currency c) noexcept {
+        const std::size_t index = static_cast<std::size_t>(c);
+        const impl::currency_tables_& tables = impl::currency_tables_instance_();
+        if (index >= currency_count && index >= tables.count.load(std::memory_order_acquire)) {
+            return std::string_view();
+        }
+        return std::string_view(tables.code_names.data() + index * 3, 3);
+    }
+
+    currency register_currency(const currency_unit& unit) {
+        using namespace impl;
+        const std::size_t slot = unit.code.size() == 3 ? code_index_(unit.code[0], unit.code[1], unit.code[2]) : code_table_size_;
+        if (slot == code_table_size_) {
+            throw std::invalid_argument("currency code must be three letters");
+        }
+        const char code[3] = {
+            static_cast<char>(std::toupper(static_cast<unsigned char>(unit.code[0]))),
+            static_cast<char>(std::toupper(static_cast<unsigned char>(unit.code[1]))),
+            static_cast<char>(std::toupper(static_cast<unsigned char>(unit.code[2])))
+        };
+
+        currency_tables_& tables = currency_tables_instance_();
+        std::lock_guard<std::mutex> lock(tables.mutex);
+        if (tables.codes[slot].load(std::memory_order_relaxed) != no_currency_) {
+            throw std::invalid_argument("currency code already taken: " + std::string(code, 3));
+        }
+        const std::size_t id = tables.count.load(std::memory_order_relaxed);
+        if (id >= max_currency_count) {
+            throw std::overflow_error("too many registered currencies");
+        }
+        const std::size_t index = id - currency_count;
+        std::memcpy(tables.code_names.data() + id * 3, code, 3);
+        tables.infos[index] = currency_info{0, unit.minor_units, static_cast<std::uint8_t>(id), {code[0], code[1], code[2]}};
+        tables.names[index] = std::string(unit.name);
+        tables.symbols[index] = unit.symbol.empty() ? std::string(code, 3) : std::string(unit.symbol);
+        tables.count.store(id + 1, std::memory_order_release);
+        tables.codes[slot].store(static_cast<std::uint8_t>(id), std::memory_order_release);
+        return static_cast<currency>(id);
+    }
+
+    std::size_t known_currency_count() noexcept {
+        return impl::currency_tables_instance_().count.load(std::memory_order_acquire);
+    }
+
     // exceptions
 
     const char* unknown_currency::what() const noexcept {
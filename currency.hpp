@@ -16,7 +16,10 @@
 #ifndef CURRENCY_HPP
 #define CURRENCY_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <map>
 
 namespace mc {
@@ -201,6 +204,24 @@ namespace mc {
         ZMW,
         ZWD  ///< Zimbabwean Dollar
     };
+
+    /**
+     * @brief Number of values in the currency enumeration.
+     * 
+     * Currency enumeration values are dense and start at zero, so this value
+     * can be used to size lookup tables indexed by currency.
+     */
+    constexpr std::size_t currency_count = static_cast<std::size_t>(currency::ZWD) + 1;
+
+    /**
+     * @brief Upper bound of currency values, including registered units.
+     * 
+     * Values from currency_count up are assigned to units added with
+     * register_currency(). Tables indexed by currency are sized with this
+     * constant so that they cover registered units; the byte value 0xFF is
+     * left free to mark a missing currency.
+     */
+    constexpr std::size_t max_currency_count = 255;
     
     /**
      * @brief Converts a currency enumeration value to its full string representation.
@@ -249,6 +270,76 @@ namespace mc {
      */
     currency to_currency(std::string currency_str);
 
+    /**
+     * @brief Looks up a currency by its three-letter ISO code without allocating.
+     * 
+     * Fast counterpart of to_currency() for parsing hot paths: the code is
+     * resolved through a direct-indexed table, the lookup is case-insensitive
+     * and never throws.
+     * 
+     * @param code The ISO 4217 three-letter currency code
+     * @param result Receives the currency when the code is recognized
+     * @return true if the code was recognized, false otherwise
+     * 
+     * @example
+     * currency c;
+     * if (find_currency("usd", c)) { ... } // c == currency::USD
+     */
+    bool find_currency(std::string_view code, currency& result) noexcept;
+
+    /**
+     * @brief Gets the three-letter ISO code of a currency without allocating.
+     * 
+     * Fast counterpart of to_shortname() for formatting hot paths: the code is
+     * read from a table of three-byte entries and the function never throws.
+     * 
+     * @param curr The currency enumeration value
+     * @return std::string_view The ISO code, empty if the currency is not recognized
+     * 
+     * @example
+     * std::string_view code = to_code(currency::USD); // "USD"
+     */
+    std::string_view to_code(currency curr) noexcept;
+
+    /**
+     * @brief Description of a non-ISO unit such as loyalty points or a token.
+     */
+    struct currency_unit {
+        std::string_view code;         ///< Three-letter code, must not be taken
+        std::string_view name;         ///< Full name
+        std::string_view symbol;       ///< Symbol, the code if empty
+        std::uint8_t minor_units = 2;  ///< Number of decimal digits of the minor unit
+    };
+
+    /**
+     * @brief Registers a non-ISO unit as a currency.
+     * 
+     * The unit gets the next free currency value, starting at currency_count,
+     * and is then found by every lookup: find_currency(), to_code(),
+     * to_shortname(), to_string(), to_currency() and the currency metadata.
+     * Registration is meant to run at startup and takes a lock; lookups stay
+     * lock-free.
+     * 
+     * @param unit The unit to register
+     * @return The currency value assigned to the unit
+     * @throws std::invalid_argument if the code is not three letters or is already taken
+     * @throws std::overflow_error if max_currency_count currencies are already known
+     * 
+     * @example
+     * currency points = register_currency({"PTS", "Loyalty Points", "pts", 0});
+     * money balance = money::from_amount(points, 1500);
+     */
+    currency register_currency(const currency_unit& unit);
+
+    /**
+     * @brief Gets the number of known currencies, ISO and registered.
+     * 
+     * Currency values below this number are valid.
+     * 
+     * @return currency_count plus the number of registered units
+     */
+    std::size_t known_currency_count() noexcept;
+
     /**
      * @brief Exception thrown when an unknown currency is encountered.
      * 
@@ -0,0 +1,135 @@
+#include "currency_batch.hpp"
+
+#include <array>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MC_CURRENCY_BATCH_SSE2 1
+#endif
+
+namespace mc {
+
+    namespace impl {
+        /// Multiplier of the perfect hash, collision-free for the ISO codes
+        constexpr std::uint32_t code_hash_multiplier_ = 0x45f639b1u;
+        constexpr unsigned code_hash_bits_ = 10;
+
+        /// Packs three uppercase bytes as a little-endian key
+        constexpr std::uint32_t code_key_(std::uint8_t a, std::uint8_t b, std::uint8_t c) noexcept {
+            return a | static_cast<std::uint32_t>(b) << 8 | static_cast<std::uint32_t>(c) << 16;
+        }
+
+        constexpr std::uint32_t code_slot_(std::uint32_t key) noexcept {
+            return (key * code_hash_multiplier_) >> (32 - code_hash_bits_);
+        }
+
+        /**
+         * Slots hold key << 8 | currency index. Empty slots hold the key of a
+         * code stored in another slot, which no key hashing to them can equal.
+         */
+        const std::array<std::uint32_t, std::size_t(1) << code_hash_bits_>& code_hash_table_() {
+            static const std::array<std::uint32_t, std::size_t(1) << code_hash_bits_> table = [] {
+                const std::string_view first = to_code(static_cast<currency>(0));
+                std::array<std::uint32_t, std::size_t(1) << code_hash_bits_> t;
+                t.fill(code_key_(first[0], first[1], first[2]) << 8 | invalid_currency);
+                for (std::size_t i = 0; i < currency_count; ++i) {
+                    const std::string_view code = to_code(static_cast<currency>(i));
+                    const std::uint32_t key = code_key_(code[0], code[1], code[2]);
+                    t[code_slot_(key)] = key << 8 | static_cast<std::uint32_t>(i);
+                }
+                return t;
+            }();
+            return table;
+        }
+
+        /// Looks up a key that is not an ISO code among the registered units
+        std::uint8_t resolve_registered_(std::uint32_t key) noexcept {
+            const char code[3] = {static_cast<char>(key), static_cast<char>(key >> 8), static_cast<char>(key >> 16)};
+            currency result;
+            return find_currency(std::string_view(code, 3), result) ? static_cast<std::uint8_t>(result) : invalid_currency;
+        }
+
+        /**
+         * Resolves an uppercased key and flags it in the bitmask when invalid.
+         * The hash only covers the ISO codes, so with registered units a miss
+         * falls back to find_currency().
+         */
+        inline bool resolve_code_(const std::uint32_t* table, std::uint32_t key, std::size_t row,
+                std::uint8_t* out, bitmask* invalid, bool registered) noexcept {
+            const std::uint32_t entry = table[code_slot_(key)];
+            bool valid = entry >> 8 == key;
+            out[row] = valid ? static_cast<std::uint8_t>(entry) : invalid_currency;
+            if (!valid && registered) {
+                out[row] = resolve_registered_(key);
+                valid = out[row] != invalid_currency;
+            }
+            if (invalid != nullptr) {
+                invalid[row >> 6] |= static_cast<bitmask>(!valid) << (row & 63);
+            }
+            return valid;
+        }
+
+        inline std::uint8_t upper_(std::uint8_t c) noexcept {
+            return static_cast<std::uint8_t>(c - 'a') < 26 ? static_cast<std::uint8_t>(c - 0x20) : c;
+        }
+
+        std::size_t resolve_scalar_(const char* codes, std::size_t stride, std::size_t first, std::size_t n,
+                std::uint8_t* out, bitmask* invalid) noexcept {
+            const std::uint32_t* table = code_hash_table_().data();
+            const bool registered = known_currency_count() > currency_count;
+            std::size_t failed = 0;
+            for (std::size_t i = first; i < n; ++i) {
+                const std::uint8_t* code = reinterpret_cast<const std::uint8_t*>(codes + i * stride);
+                const std::uint32_t key = code_key_(upper_(code[0]), upper_(code[1]), upper_(code[2]));
+                failed += !resolve_code_(table, key, i, out, invalid, registered);
+            }
+            return failed;
+        }
+    }
+
+    std::size_t to_currency_batch_scalar(const char* codes, std::size_t stride, std::size_t n,
+            std::uint8_t* out, bitmask* invalid) noexcept {
+        if (invalid != nullptr) {
+            std::memset(invalid, 0, (n + 63) / 64 * sizeof (bitmask));
+        }
+        return impl::resolve_scalar_(codes, stride, 0, n, out, invalid);
+    }
+
+    std::size_t to_currency_batch(const char* codes, std::size_t stride, std::size_t n,
+            std::uint8_t* out, bitmask* invalid) noexcept {
+#if defined(MC_CURRENCY_BATCH_SSE2)
+        if (invalid != nullptr) {
+            std::memset(invalid, 0, (n + 63) / 64 * sizeof (bitmask));
+        }
+        const std::uint32_t* table = impl::code_hash_table_().data();
+        const bool registered = known_currency_count() > currency_count;
+        const __m128i low_bytes = _mm_set1_epi32(0x00FFFFFF);
+        const __m128i before_a = _mm_set1_epi8('a' - 1);
+        const __m128i after_z = _mm_set1_epi8('z' + 1);
+        const __m128i case_bit = _mm_set1_epi8(0x20);
+        std::size_t failed = 0;
+        std::size_t i = 0;
+        // four bytes are loaded per code, so the last code is left to the scalar loop
+        for (; i + 16 < n; i += 16) {
+            alignas(16) std::uint32_t keys[16];
+            for (std::size_t group = 0; group < 16; group += 4) {
+                std::uint32_t words[4];
+                for (std::size_t j = 0; j < 4; ++j) {
+                    std::memcpy(&words[j], codes + (i + group + j) * stride, 4);
+                }
+                __m128i v = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(words)), low_bytes);
+                const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(v, before_a), _mm_cmplt_epi8(v, after_z));
+                v = _mm_sub_epi8(v, _mm_and_si128(lower, case_bit));
+                _mm_store_si128(reinterpret_cast<__m128i*>(keys + group), v);
+            }
+            for (std::size_t j = 0; j < 16; ++j) {
+                failed += !impl::resolve_code_(table, keys[j], i + j, out, invalid, registered);
+            }
+        }
+        return failed + impl::resolve_scalar_(codes, stride, i, n, out, invalid);
+#else
+        return to_currency_batch_scalar(codes, stride, n, out, invalid);
+#endif
+    }
+}
@@ -0,0 +1,64 @@
+/**
+ * @file currency_batch.hpp
+ * @brief Conversion of whole columns of currency codes.
+ *
+ * Codes are uppercased 16 at a time with SSE2 where available and resolved
+ * through a perfect hash of the ISO codes: one multiplication selects the
+ * only slot a code can be in, and a comparison with the stored code tells
+ * whether it is valid. Codes missing from the hash are looked up among
+ * the units added with register_currency(), if any. Invalid codes are
+ * flagged in a bitmask instead of throwing.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef CURRENCY_BATCH_HPP
+#define CURRENCY_BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "currency.hpp"
+
+namespace mc {
+
+    /// Word of a bitmask, bit i of word k stands for row k * 64 + i
+    using bitmask = std::uint64_t;
+
+    /// Currency index written for invalid codes
+    constexpr std::uint8_t invalid_currency = 0xFF;
+
+    /**
+     * @brief Converts currency codes to currency indices.
+     *
+     * Codes are case-insensitive. Each code is read as three bytes at
+     * codes + i * stride; a fourth byte is read for all but the last code.
+     *
+     * @param codes Pointer to the first code
+     * @param stride Distance in bytes between the starts of two codes, at least 3
+     * @param n Number of codes
+     * @param out Receives the currency index of every code, or invalid_currency
+     * @param invalid If not null, receives (n + 63) / 64 words with the bits of invalid codes set
+     * @return The number of invalid codes
+     */
+    std::size_t to_currency_batch(const char* codes, std::size_t stride, std::size_t n,
+            std::uint8_t* out, bitmask* invalid) noexcept;
+
+    /**
+     * @brief Converts currency codes one at a time.
+     *
+     * Portable counterpart of to_currency_batch() with the same results,
+     * used where SSE2 is not available and for the remaining codes.
+     *
+     * @param codes Pointer to the first code
+     * @param stride Distance in bytes between the starts of two codes, at least 3
+     * @param n Number of codes
+     * @param out Receives the currency index of every code, or invalid_currency
+     * @param invalid If not null, receives (n + 63) / 64 words with the bits of invalid codes set
+     * @return The number of invalid codes
+     */
+    std::size_t to_currency_batch_scalar(const char* codes, std::size_t stride, std::size_t n,
+            std::uint8_t* out, bitmask* invalid) noexcept;
+}
+
+#endif /* CURRENCY_BATCH_HPP */
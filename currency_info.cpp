@@ -0,0 +1,49 @@
+#include "currency_info.hpp"
+
+#include <array>
+
+namespace mc {
+
+    namespace impl {
+        constexpr std::uint8_t no_numeric_ = 0xFF;
+
+        constexpr bool currency_infos_sorted_() {
+            for (std::size_t i = 1; i < currency_count; ++i) {
+                const char* a = currency_infos_[i - 1].code;
+                const char* b = currency_infos_[i].code;
+                if (std::string_view(a, 3) >= std::string_view(b, 3)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static_assert(currency_infos_sorted_(), "currency infos must follow the enumeration order");
+
+        /// Currency index of every numeric code, no_numeric_ for unassigned codes
+        constexpr std::array<std::uint8_t, 1000> numeric_table_ = [] {
+            std::array<std::uint8_t, 1000> t{};
+            for (std::uint8_t& entry : t) {
+                entry = no_numeric_;
+            }
+            for (std::size_t i = 0; i < currency_count; ++i) {
+                if (currency_infos_[i].numeric != 0) {
+                    t[currency_infos_[i].numeric] = static_cast<std::uint8_t>(i);
+                }
+            }
+            return t;
+        }();
+    }
+
+    bool from_numeric(std::uint16_t numeric, currency& result) noexcept {
+        if (numeric >= impl::numeric_table_.size()) {
+            return false;
+        }
+        const std::uint8_t index = impl::numeric_table_[numeric];
+        if (index == impl::no_numeric_) {
+            return false;
+        }
+        result = static_cast<currency>(index);
+        return true;
+    }
+}
@@ -0,0 +1,456 @@
+/**
+ * @file currency_info.hpp
+ * @brief Compile-time metadata of the ISO 4217 currencies.
+ *
+ * Every currency has a currency_info record with its numeric ISO code,
+ * its minor units, the currency it is pegged to and its three-letter code,
+ * packed into eight bytes so that the whole table spans a few cache lines.
+ * Symbols are rarely needed on hot paths and are kept in a separate table.
+ * Both tables are constexpr; from_numeric() resolves numeric codes, as used
+ * by ISO 8583 and SWIFT messages, through a direct table of 1000 entries.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef CURRENCY_INFO_HPP
+#define CURRENCY_INFO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "currency.hpp"
+
+namespace mc {
+
+    /**
+     * @brief Metadata of one currency.
+     */
+    struct alignas(8) currency_info {
+        std::uint16_t numeric;     ///< ISO 4217 numeric code, 0 for codes without one
+        std::uint8_t minor_units;  ///< Number of decimal digits of the minor unit
+        std::uint8_t peg;          ///< Index of the currency this one is pegged to, its own index if it floats
+        char code[3];              ///< Three-letter code
+    };
+
+    static_assert(sizeof(currency_info) == 8, "currency info records must be 8 bytes");
+
+    namespace impl {
+        /// Metadata of a unit added with register_currency(), zeroed for unknown values
+        const currency_info& registered_info_(currency curr) noexcept;
+
+        /// Symbol of a unit added with register_currency(), empty for unknown values
+        std::string_view registered_symbol_(currency curr) noexcept;
+
+        /// Metadata of every ISO currency, in enumeration order
+        inline constexpr currency_info currency_infos_[currency_count] = {
+            {784, 2, static_cast<std::uint8_t>(currency::USD), {'A', 'E', 'D'}},
+            {971, 2, static_cast<std::uint8_t>(currency::AFN), {'A', 'F', 'N'}},
+            {8, 2, static_cast<std::uint8_t>(currency::ALL), {'A', 'L', 'L'}},
+            {51, 2, static_cast<std::uint8_t>(currency::AMD), {'A', 'M', 'D'}},
+            {532, 2, static_cast<std::uint8_t>(currency::USD), {'A', 'N', 'G'}},
+            {973, 2, static_cast<std::uint8_t>(currency::AOA), {'A', 'O', 'A'}},
+            {32, 2, static_cast<std::uint8_t>(currency::ARS), {'A', 'R', 'S'}},
+            {36, 2, static_cast<std::uint8_t>(currency::AUD), {'A', 'U', 'D'}},
+            {533, 2, static_cast<std::uint8_t>(currency::USD), {'A', 'W', 'G'}},
+            {944, 2, static_cast<std::uint8_t>(currency::AZN), {'A', 'Z', 'N'}},
+            {977, 2, static_cast<std::uint8_t>(currency::EUR), {'B', 'A', 'M'}},
+            {52, 2, static_cast<std::uint8_t>(currency::USD), {'B', 'B', 'D'}},
+            {50, 2, static_cast<std::uint8_t>(currency::BDT), {'B', 'D', 'T'}},
+            {975, 2, static_cast<std::uint8_t>(currency::EUR), {'B', 'G', 'N'}},
+            {48, 3, static_cast<std::uint8_t>(currency::USD), {'B', 'H', 'D'}},
+            {108, 0, static_cast<std::uint8_t>(currency::BIF), {'B', 'I', 'F'}},
+            {60, 2, static_cast<std::uint8_t>(currency::USD), {'B', 'M', 'D'}},
+            {96, 2, static_cast<std::uint8_t>(currency::SGD), {'B', 'N', 'D'}},
+            {68, 2, static_cast<std::uint8_t>(currency::BOB), {'B', 'O', 'B'}},
+            {986, 2, static_cast<std::uint8_t>(currency::BRL), {'B', 'R', 'L'}},
+            {44, 2, static_cast<std::uint8_t>(currency::USD), {'B', 'S', 'D'}},
+            {64, 2, static_cast<std::uint8_t>(currency::INR), {'B', 'T', 'N'}},
+            {72, 2, static_cast<std::uint8_t>(currency::BWP), {'B', 'W', 'P'}},
+            {933, 2, static_cast<std::uint8_t>(currency::BYN), {'B', 'Y', 'N'}},
+            {84, 2, static_cast<std::uint8_t>(currency::USD), {'B', 'Z', 'D'}},
+            {124, 2, static_cast<std::uint8_t>(currency::CAD), {'C', 'A', 'D'}},
+            {976, 2, static_cast<std::uint8_t>(currency::CDF), {'C', 'D', 'F'}},
+            {756, 2, static_cast<std::uint8_t>(currency::CHF), {'C', 'H', 'F'}},
+            {152, 0, static_cast<std::uint8_t>(currency::CLP), {'C', 'L', 'P'}},
+            {156, 2, static_cast<std::uint8_t>(currency::CNY), {'C', 'N', 'Y'}},
+            {170, 2, static_cast<std::uint8_t>(currency::COP), {'C', 'O', 'P'}},
+            {188, 2, static_cast<std::uint8_t>(currency::CRC), {'C', 'R', 'C'}},
+            {931, 2, static_cast<std::uint8_t>(currency::USD), {'C', 'U', 'C'}},
+            {192, 2, static_cast<std::uint8_t>(currency::CUP), {'C', 'U', 'P'}},
+            {132, 2, static_cast<std::uint8_t>(currency::EUR), {'C', 'V', 'E'}},
+            {203, 2, static_cast<std::uint8_t>(currency::CZK), {'C', 'Z', 'K'}},
+            {262, 0, static_cast<std::uint8_t>(currency::USD), {'D', 'J', 'F'}},
+            {208, 2, static_cast<std::uint8_t>(currency::EUR), {'D', 'K', 'K'}},
+            {214, 2, static_cast<std::uint8_t>(currency::DOP), {'D', 'O', 'P'}},
+            {12, 2, static_cast<std::uint8_t>(currency::DZD), {'D', 'Z', 'D'}},
+            {818, 2, static_cast<std::uint8_t>(currency::EGP), {'E', 'G', 'P'}},
+            {232, 2, static_cast<std::uint8_t>(currency::USD), {'E', 'R', 'N'}},
+            {230, 2, static_cast<std::uint8_t>(currency::ETB), {'E', 'T', 'B'}},
+            {978, 2, static_cast<std::uint8_t>(currency::EUR), {'E', 'U', 'R'}},
+            {242, 2, static_cast<std::uint8_t>(currency::FJD), {'F', 'J', 'D'}},
+            {238, 2, static_cast<std::uint8_t>(currency::GBP), {'F', 'K', 'P'}},
+            {826, 2, static_cast<std::uint8_t>(currency::GBP), {'G', 'B', 'P'}},
+            {981, 2, static_cast<std::uint8_t>(currency::GEL), {'G', 'E', 'L'}},
+            {0, 2, static_cast<std::uint8_t>(currency::GBP), {'G', 'G', 'P'}},
+            {936, 2, static_cast<std::uint8_t>(currency::GHS), {'G', 'H', 'S'}},
+            {292, 2, static_cast<std::uint8_t>(currency::GBP), {'G', 'I', 'P'}},
+            {270, 2, static_cast<std::uint8_t>(currency::GMD), {'G', 'M', 'D'}},
+            {324, 0, static_cast<std::uint8_t>(currency::GNF), {'G', 'N', 'F'}},
+            {320, 2, static_cast<std::uint8_t>(currency::GTQ), {'G', 'T', 'Q'}},
+            {328, 2, static_cast<std::uint8_t>(currency::GYD), {'G', 'Y', 'D'}},
+            {344, 2, static_cast<std::uint8_t>(currency::USD), {'H', 'K', 'D'}},
+            {340, 2, static_cast<std::uint8_t>(currency::HNL), {'H', 'N', 'L'}},
+            {191, 2, static_cast<std::uint8_t>(currency::EUR), {'H', 'R', 'K'}},
+            {332, 2, static_cast<std::uint8_t>(currency::HTG), {'H', 'T', 'G'}},
+            {348, 2, static_cast<std::uint8_t>(currency::HUF), {'H', 'U', 'F'}},
+            {360, 2, static_cast<std::uint8_t>(currency::IDR), {'I', 'D', 'R'}},
+            {376, 2, static_cast<std::uint8_t>(currency::ILS), {'I', 'L', 'S'}},
+            {0, 2, static_cast<std::uint8_t>(currency::GBP), {'I', 'M', 'P'}},
+            {356, 2, static_cast<std::uint8_t>(currency::INR), {'I', 'N', 'R'}},
+            {368, 3, static_cast<std::uint8_t>(currency::IQD), {'I', 'Q', 'D'}},
+            {364, 2, static_cast<std::uint8_t>(currency::IRR), {'I', 'R', 'R'}},
+            {352, 0, static_cast<std::uint8_t>(currency::ISK), {'I', 'S', 'K'}},
+            {0, 2, static_cast<std::uint8_t>(currency::GBP), {'J', 'E', 'P'}},
+            {388, 2, static_cast<std::uint8_t>(currency::JMD), {'J', 'M', 'D'}},
+            {400, 3, static_cast<std::uint8_t>(currency::USD), {'J', 'O', 'D'}},
+            {392, 0, static_cast<std::uint8_t>(currency::JPY), {'J', 'P', 'Y'}},
+            {404, 2, static_cast<std::uint8_t>(currency::KES), {'K', 'E', 'S'}},
+            {417, 2, static_cast<std::uint8_t>(currency::KGS), {'K', 'G', 'S'}},
+            {116, 2, static_cast<std::uint8_t>(currency::KHR), {'K', 'H', 'R'}},
+            {174, 0, static_cast<std::uint8_t>(currency::EUR), {'K', 'M', 'F'}},
+            {408, 2, static_cast<std::uint8_t>(currency::KPW), {'K', 'P', 'W'}},
+            {410, 0, static_cast<std::uint8_t>(currency::KRW), {'K', 'R', 'W'}},
+            {414, 3, static_cast<std::uint8_t>(currency::KWD), {'K', 'W', 'D'}},
+            {136, 2, static_cast<std::uint8_t>(currency::USD), {'K', 'Y', 'D'}},
+            {398, 2, static_cast<std::uint8_t>(currency::KZT), {'K', 'Z', 'T'}},
+            {418, 2, static_cast<std::uint8_t>(currency::LAK), {'L', 'A', 'K'}},
+            {422, 2, static_cast<std::uint8_t>(currency::LBP), {'L', 'B', 'P'}},
+            {144, 2, static_cast<std::uint8_t>(currency::LKR), {'L', 'K', 'R'}},
+            {430, 2, static_cast<std::uint8_t>(currency::LRD), {'L', 'R', 'D'}},
+            {426, 2, static_cast<std::uint8_t>(currency::ZAR), {'L', 'S', 'L'}},
+            {434, 3, static_cast<std::uint8_t>(currency::LYD), {'L', 'Y', 'D'}},
+            {504, 2, static_cast<std::uint8_t>(currency::MAD), {'M', 'A', 'D'}},
+            {498, 2, static_cast<std::uint8_t>(currency::MDL), {'M', 'D', 'L'}},
+            {969, 2, static_cast<std::uint8_t>(currency::MGA), {'M', 'G', 'A'}},
+            {807, 2, static_cast<std::uint8_t>(currency::MKD), {'M', 'K', 'D'}},
+            {104, 2, static_cast<std::uint8_t>(currency::MMK), {'M', 'M', 'K'}},
+            {496, 2, static_cast<std::uint8_t>(currency::MNT), {'M', 'N', 'T'}},
+            {446, 2, static_cast<std::uint8_t>(currency::HKD), {'M', 'O', 'P'}},
+            {929, 2, static_cast<std::uint8_t>(currency::MRU), {'M', 'R', 'U'}},
+            {480, 2, static_cast<std::uint8_t>(currency::MUR), {'M', 'U', 'R'}},
+            {462, 2, static_cast<std::uint8_t>(currency::MVR), {'M', 'V', 'R'}},
+            {454, 2, static_cast<std::uint8_t>(currency::MWK), {'M', 'W', 'K'}},
+            {484, 2, static_cast<std::uint8_t>(currency::MXN), {'M', 'X', 'N'}},
+            {458, 2, static_cast<std::uint8_t>(currency::MYR), {'M', 'Y', 'R'}},
+            {943, 2, static_cast<std::uint8_t>(currency::MZN), {'M', 'Z', 'N'}},
+            {516, 2, static_cast<std::uint8_t>(currency::ZAR), {'N', 'A', 'D'}},
+            {566, 2, static_cast<std::uint8_t>(currency::NGN), {'N', 'G', 'N'}},
+            {558, 2, static_cast<std::uint8_t>(currency::NIO), {'N', 'I', 'O'}},
+            {578, 2, static_cast<std::uint8_t>(currency::NOK), {'N', 'O', 'K'}},
+            {524, 2, static_cast<std::uint8_t>(currency::INR), {'N', 'P', 'R'}},
+            {554, 2, static_cast<std::uint8_t>(currency::NZD), {'N', 'Z', 'D'}},
+            {512, 3, static_cast<std::uint8_t>(currency::USD), {'O', 'M', 'R'}},
+            {590, 2, static_cast<std::uint8_t>(currency::USD), {'P', 'A', 'B'}},
+            {604, 2, static_cast<std::uint8_t>(currency::PEN), {'P', 'E', 'N'}},
+            {598, 2, static_cast<std::uint8_t>(currency::PGK), {'P', 'G', 'K'}},
+            {608, 2, static_cast<std::uint8_t>(currency::PHP), {'P', 'H', 'P'}},
+            {586, 2, static_cast<std::uint8_t>(currency::PKR), {'P', 'K', 'R'}},
+            {985, 2, static_cast<std::uint8_t>(currency::PLN), {'P', 'L', 'N'}},
+            {600, 0, static_cast<std::uint8_t>(currency::PYG), {'P', 'Y', 'G'}},
+            {634, 2, static_cast<std::uint8_t>(currency::USD), {'Q', 'A', 'R'}},
+            {946, 2, static_cast<std::uint8_t>(currency::RON), {'R', 'O', 'N'}},
+            {941, 2, static_cast<std::uint8_t>(currency::RSD), {'R', 'S', 'D'}},
+            {643, 2, static_cast<std::uint8_t>(currency::RUB), {'R', 'U', 'B'}},
+            {646, 0, static_cast<std::uint8_t>(currency::RWF), {'R', 'W', 'F'}},
+            {682, 2, static_cast<std::uint8_t>(currency::USD), {'S', 'A', 'R'}},
+            {90, 2, static_cast<std::uint8_t>(currency::SBD), {'S', 'B', 'D'}},
+            {690, 2, static_cast<std::uint8_t>(currency::SCR), {'S', 'C', 'R'}},
+            {938, 2, static_cast<std::uint8_t>(currency::SDG), {'S', 'D', 'G'}},
+            {752, 2, static_cast<std::uint8_t>(currency::SEK), {'S', 'E', 'K'}},
+            {702, 2, static_cast<std::uint8_t>(currency::SGD), {'S', 'G', 'D'}},
+            {654, 2, static_cast<std::uint8_t>(currency::GBP), {'S', 'H', 'P'}},
+            {694, 2, static_cast<std::uint8_t>(currency::SLL), {'S', 'L', 'L'}},
+            {706, 2, static_cast<std::uint8_t>(currency::SOS), {'S', 'O', 'S'}},
+            {0, 2, static_cast<std::uint8_t>(currency::USD), {'S', 'P', 'L'}},
+            {968, 2, static_cast<std::uint8_t>(currency::SRD), {'S', 'R', 'D'}},
+            {930, 2, static_cast<std::uint8_t>(currency::EUR), {'S', 'T', 'N'}},
+            {222, 2, static_cast<std::uint8_t>(currency::USD), {'S', 'V', 'C'}},
+            {760, 2, static_cast<std::uint8_t>(currency::SYP), {'S', 'Y', 'P'}},
+            {748, 2, static_cast<std::uint8_t>(currency::ZAR), {'S', 'Z', 'L'}},
+            {764, 2, static_cast<std::uint8_t>(currency::THB), {'T', 'H', 'B'}},
+            {972, 2, static_cast<std::uint8_t>(currency::TJS), {'T', 'J', 'S'}},
+            {934, 2, static_cast<std::uint8_t>(currency::TMT), {'T', 'M', 'T'}},
+            {788, 3, static_cast<std::uint8_t>(currency::TND), {'T', 'N', 'D'}},
+            {776, 2, static_cast<std::uint8_t>(currency::TOP), {'T', 'O', 'P'}},
+            {949, 2, static_cast<std::uint8_t>(currency::TRY), {'T', 'R', 'Y'}},
+            {780, 2, static_cast<std::uint8_t>(currency::TTD), {'T', 'T', 'D'}},
+            {0, 2, static_cast<std::uint8_t>(currency::AUD), {'T', 'V', 'D'}},
+            {901, 2, static_cast<std::uint8_t>(currency::TWD), {'T', 'W', 'D'}},
+            {834, 2, static_cast<std::uint8_t>(currency::TZS), {'T', 'Z', 'S'}},
+            {980, 2, static_cast<std::uint8_t>(currency::UAH), {'U', 'A', 'H'}},
+            {800, 0, static_cast<std::uint8_t>(currency::UGX), {'U', 'G', 'X'}},
+            {840, 2, static_cast<std::uint8_t>(currency::USD), {'U', 'S', 'D'}},
+            {858, 2, static_cast<std::uint8_t>(currency::UYU), {'U', 'Y', 'U'}},
+            {860, 2, static_cast<std::uint8_t>(currency::UZS), {'U', 'Z', 'S'}},
+            {937, 2, static_cast<std::uint8_t>(currency::VEF), {'V', 'E', 'F'}},
+            {704, 0, static_cast<std::uint8_t>(currency::VND), {'V', 'N', 'D'}},
+            {548, 0, static_cast<std::uint8_t>(currency::VUV), {'V', 'U', 'V'}},
+            {882, 2, static_cast<std::uint8_t>(currency::WST), {'W', 'S', 'T'}},
+            {950, 0, static_cast<std::uint8_t>(currency::EUR), {'X', 'A', 'F'}},
+            {951, 2, static_cast<std::uint8_t>(currency::USD), {'X', 'C', 'D'}},
+            {960, 2, static_cast<std::uint8_t>(currency::XDR), {'X', 'D', 'R'}},
+            {952, 0, static_cast<std::uint8_t>(currency::EUR), {'X', 'O', 'F'}},
+            {953, 0, static_cast<std::uint8_t>(currency::EUR), {'X', 'P', 'F'}},
+            {886, 2, static_cast<std::uint8_t>(currency::YER), {'Y', 'E', 'R'}},
+            {710, 2, static_cast<std::uint8_t>(currency::ZAR), {'Z', 'A', 'R'}},
+            {967, 2, static_cast<std::uint8_t>(currency::ZMW), {'Z', 'M', 'W'}},
+            {716, 2, static_cast<std::uint8_t>(currency::ZWD), {'Z', 'W', 'D'}},
+        };
+
+        /// UTF-8 symbol of every ISO currency, in enumeration order
+        inline constexpr std::string_view currency_symbols_[currency_count] = {
+            "\xD8\xAF.\xD8\xA5", // AED
+            "\xD8\x8B", // AFN
+            "L", // ALL
+            "\xD6\x8F", // AMD
+            "\xC6\x92", // ANG
+            "Kz", // AOA
+            "$", // ARS
+            "$", // AUD
+            "\xC6\x92", // AWG
+            "\xE2\x82\xBC", // AZN
+            "KM", // BAM
+            "$", // BBD
+            "\xE0\xA7\xB3", // BDT
+            "\xD0\xBB\xD0\xB2.", // BGN
+            ".\xD8\xAF.\xD8\xA8", // BHD
+            "FBu", // BIF
+            "$", // BMD
+            "$", // BND
+            "Bs", // BOB
+            "R$", // BRL
+            "$", // BSD
+            "Nu.", // BTN
+            "P", // BWP
+            "Br", // BYN
+            "$", // BZD
+            "$", // CAD
+            "FC", // CDF
+            "CHF", // CHF
+            "$", // CLP
+            "\xC2\xA5", // CNY
+            "$", // COP
+            "\xE2\x82\xA1", // CRC
+            "$", // CUC
+            "$", // CUP
+            "$", // CVE
+            "K\xC4\x8D", // CZK
+            "Fdj", // DJF
+            "kr.", // DKK
+            "$", // DOP
+            "\xD8\xAF.\xD8\xAC", // DZD
+            "E\xC2\xA3", // EGP
+            "Nfk", // ERN
+            "Br", // ETB
+            "\xE2\x82\xAC", // EUR
+            "$", // FJD
+            "\xC2\xA3", // FKP
+            "\xC2\xA3", // GBP
+            "\xE2\x82\xBE", // GEL
+            "\xC2\xA3", // GGP
+            "\xE2\x82\xB5", // GHS
+            "\xC2\xA3", // GIP
+            "D", // GMD
+            "FG", // GNF
+            "Q", // GTQ
+            "$", // GYD
+            "HK$", // HKD
+            "L", // HNL
+            "kn", // HRK
+            "G", // HTG
+            "Ft", // HUF
+            "Rp", // IDR
+            "\xE2\x82\xAA", // ILS
+            "\xC2\xA3", // IMP
+            "\xE2\x82\xB9", // INR
+            "\xD8\xB9.\xD8\xAF", // IQD
+            "\xEF\xB7\xBC", // IRR
+            "kr", // ISK
+            "\xC2\xA3", // JEP
+            "$", // JMD
+            "\xD8\xAF.\xD8\xA7", // JOD
+            "\xC2\xA5", // JPY
+            "KSh", // KES
+            "\xD1\x81", // KGS
+            "\xE1\x9F\x9B", // KHR
+            "CF", // KMF
+            "\xE2\x82\xA9", // KPW
+            "\xE2\x82\xA9", // KRW
+            "\xD8\xAF.\xD9\x83", // KWD
+            "$", // KYD
+            "\xE2\x82\xB8", // KZT
+            "\xE2\x82\xAD", // LAK
+            "\xD9\x84.\xD9\x84", // LBP
+            "Rs", // LKR
+            "$", // LRD
+            "L", // LSL
+            "\xD9\x84.\xD8\xAF", // LYD
+            "\xD8\xAF.\xD9\x85.", // MAD
+            "L", // MDL
+            "Ar", // MGA
+            "\xD0\xB4\xD0\xB5\xD0\xBD", // MKD
+            "K", // MMK
+            "\xE2\x82\xAE", // MNT
+            "MOP$", // MOP
+            "UM", // MRU
+            "Rs", // MUR
+            "Rf", // MVR
+            "MK", // MWK
+            "$", // MXN
+            "RM", // MYR
+            "MT", // MZN
+            "$", // NAD
+            "\xE2\x82\xA6", // NGN
+            "C$", // NIO
+            "kr", // NOK
+            "Rs", // NPR
+            "$", // NZD
+            "\xD8\xB1.\xD8\xB9.", // OMR
+            "B/.", // PAB
+            "S/", // PEN
+            "K", // PGK
+            "\xE2\x82\xB1", // PHP
+            "Rs", // PKR
+            "z\xC5\x82", // PLN
+            "\xE2\x82\xB2", // PYG
+            "\xD8\xB1.\xD9\x82", // QAR
+            "lei", // RON
+            "\xD0\xB4\xD0\xB8\xD0\xBD.", // RSD
+            "\xE2\x82\xBD", // RUB
+            "FRw", // RWF
+            "\xD8\xB1.\xD8\xB3", // SAR
+            "$", // SBD
+            "Rs", // SCR
+            "\xD8\xAC.\xD8\xB3.", // SDG
+            "kr", // SEK
+            "$", // SGD
+            "\xC2\xA3", // SHP
+            "Le", // SLL
+            "Sh", // SOS
+            "L", // SPL
+            "$", // SRD
+            "Db", // STN
+            "\xE2\x82\xA1", // SVC
+            "\xC2\xA3", // SYP
+            "E", // SZL
+            "\xE0\xB8\xBF", // THB
+            "SM", // TJS
+            "m", // TMT
+            "\xD8\xAF.\xD8\xAA", // TND
+            "T$", // TOP
+            "\xE2\x82\xBA", // TRY
+            "$", // TTD
+            "$", // TVD
+            "NT$", // TWD
+            "TSh", // TZS
+            "\xE2\x82\xB4", // UAH
+            "USh", // UGX
+            "$", // USD
+            "$", // UYU
+            "so\xCA\xBBm", // UZS
+            "Bs.", // VEF
+            "\xE2\x82\xAB", // VND
+            "VT", // VUV
+            "T", // WST
+            "FCFA", // XAF
+            "$", // XCD
+            "SDR", // XDR
+            "CFA", // XOF
+            "\xE2\x82\xA3", // XPF
+            "\xEF\xB7\xBC", // YER
+            "R", // ZAR
+            "K", // ZMW
+            "Z$", // ZWD
+        };
+    }
+
+    /**
+     * @brief Gets the metadata of a currency.
+     *
+     * ISO currencies are read from the constexpr table, units added with
+     * register_currency() from the registry; those have numeric code 0 and
+     * are pegged to themselves.
+     *
+     * @param curr The currency
+     * @return The metadata record
+     *
+     * @example
+     * static_assert(info(currency::USD).numeric == 840);
+     */
+    constexpr const currency_info& info(currency curr) noexcept {
+        return static_cast<std::size_t>(curr) < currency_count
+                ? impl::currency_infos_[static_cast<std::size_t>(curr)]
+                : impl::registered_info_(curr);
+    }
+
+    /**
+     * @brief Gets the ISO 4217 numeric code of a currency.
+     * @param curr The currency
+     * @return The numeric code, 0 if the currency has none
+     */
+    constexpr std::uint16_t to_numeric(currency curr) noexcept {
+        return info(curr).numeric;
+    }
+
+    /**
+     * @brief Gets the number of decimal digits of the minor unit of a currency.
+     *
+     * Money values always count hundredths; this is the precision the
+     * currency is quoted with, e.g. 0 for JPY and 3 for KWD.
+     *
+     * @param curr The currency
+     * @return The number of decimal digits
+     */
+    constexpr unsigned minor_units(currency curr) noexcept {
+        return info(curr).minor_units;
+    }
+
+    /**
+     * @brief Gets the currency a currency is pegged to.
+     * @param curr The currency
+     * @return The anchor currency, curr itself if it floats
+     */
+    constexpr currency peg(currency curr) noexcept {
+        return static_cast<currency>(info(curr).peg);
+    }
+
+    /**
+     * @brief Gets the symbol of a currency.
+     * @param curr The currency
+     * @return The UTF-8 symbol, e.g. "$" for USD
+     */
+    constexpr std::string_view symbol(currency curr) noexcept {
+        return static_cast<std::size_t>(curr) < currency_count
+                ? impl::currency_symbols_[static_cast<std::size_t>(curr)]
+                : impl::registered_symbol_(curr);
+    }
+
+    /**
+     * @brief Looks up a currency by its ISO 4217 numeric code.
+     *
+     * The code is resolved through a direct table indexed by the numeric
+     * code, so the lookup is a single load and never throws.
+     *
+     * @param numeric The numeric code, 1 to 999
+     * @param result Receives the currency when the code is recognized
+     * @return true if the code was recognized, false otherwise
+     *
+     * @example
+     * currency c;
+     * if (from_numeric(978, c)) { ... } // c == currency::EUR
+     */
+    bool from_numeric(std::uint16_t numeric, currency& result) noexcept;
+}
+
+#endif /* CURRENCY_INFO_HPP */
@@ -0,0 +1,170 @@
+#include "currency_set.hpp"
+
+#include <stdexcept>
+#include <string>
+
+// The SSSE3 filter is compiled for every x86 build and chosen at run time,
+// unless the target already guarantees SSSE3.
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define MC_CURRENCY_SET_SSSE3 1
+#define MC_SSSE3_TARGET
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <tmmintrin.h>
+#define MC_CURRENCY_SET_SSSE3 1
+#define MC_CURRENCY_SET_DISPATCH 1
+#define MC_SSSE3_TARGET __attribute__((target("ssse3")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <tmmintrin.h>
+#define MC_CURRENCY_SET_SSSE3 1
+#define MC_CURRENCY_SET_DISPATCH 1
+#define MC_SSSE3_TARGET
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace mc {
+
+    namespace impl {
+        currency find_set_code_(std::string_view code) {
+            currency result;
+            if (!find_currency(code, result)) {
+                throw std::invalid_argument("unknown currency code: " + std::string(code));
+            }
+            return result;
+        }
+
+        unsigned lowest_set_bit_(std::uint64_t value) noexcept {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward64(&index, value);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+        }
+
+        /// First member not below index, or 256
+        std::size_t next_member_(const std::uint64_t* words, std::size_t index) noexcept {
+            if (index >= 256) {
+                return 256;
+            }
+            std::size_t word = index >> 6;
+            std::uint64_t bits = words[word] & (~std::uint64_t(0) << (index & 63));
+            while (bits == 0) {
+                if (++word == 4) {
+                    return 256;
+                }
+                bits = words[word];
+            }
+            return word * 64 + lowest_set_bit_(bits);
+        }
+
+        /// Selects rows first to n through a membership byte per currency value
+        std::size_t filter_scalar_(const std::uint8_t* currencies, std::size_t first, std::size_t n,
+                const currency_set& set, bitmask* selection) noexcept {
+            std::uint8_t member[256];
+            for (std::size_t c = 0; c < 256; ++c) {
+                member[c] = (set.words()[c >> 6] >> (c & 63)) & 1;
+            }
+            // first is a multiple of 64, so every word is assembled in a register
+            std::size_t selected = 0;
+            for (std::size_t i = first; i < n; i += 64) {
+                const std::size_t rows = n - i < 64 ? n - i : 64;
+                std::uint64_t word = 0;
+                for (std::size_t j = 0; j < rows; ++j) {
+                    word |= static_cast<std::uint64_t>(member[currencies[i + j]]) << j;
+                }
+                selection[i >> 6] = word;
+                selected += count_bits_(word);
+            }
+            return selected;
+        }
+
+#if defined(MC_CURRENCY_SET_SSSE3)
+        /// Selects whole words of 64 rows with SSSE3, returns the number of rows done through done
+        MC_SSSE3_TARGET
+        std::size_t filter_ssse3_(const std::uint8_t* currencies, std::size_t n, const currency_set& set,
+                bitmask* selection, std::size_t& done) noexcept {
+            // Byte x is a member if bit x >> 4 of the 16-bit row x & 15 is set. The
+            // rows are split into two tables of their low and high bytes, so one
+            // shuffle per table looks up 16 rows, and a third shuffle turns the
+            // high nibble into the bit to test.
+            alignas(16) std::uint8_t low_rows[16] = {};
+            alignas(16) std::uint8_t high_rows[16] = {};
+            for (std::size_t c = 0; c < 256; ++c) {
+                if (set.contains(static_cast<currency>(c))) {
+                    std::uint8_t* rows = (c >> 4) < 8 ? low_rows : high_rows;
+                    rows[c & 15] |= static_cast<std::uint8_t>(1u << ((c >> 4) & 7));
+                }
+            }
+            const __m128i low_table = _mm_load_si128(reinterpret_cast<const __m128i*>(low_rows));
+            const __m128i high_table = _mm_load_si128(reinterpret_cast<const __m128i*>(high_rows));
+            const __m128i bit_table = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+            const __m128i nibble = _mm_set1_epi8(0x0F);
+            const __m128i seven = _mm_set1_epi8(7);
+            std::size_t selected = 0;
+            std::size_t i = 0;
+            for (; i + 64 <= n; i += 64) {
+                std::uint64_t word = 0;
+                for (std::size_t part = 0; part < 64; part += 16) {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(currencies + i + part));
+                    const __m128i low = _mm_and_si128(v, nibble);
+                    const __m128i high = _mm_and_si128(_mm_srli_epi16(v, 4), nibble);
+                    const __m128i upper_half = _mm_cmpgt_epi8(high, seven);
+                    const __m128i row = _mm_or_si128(_mm_andnot_si128(upper_half, _mm_shuffle_epi8(low_table, low)),
+                            _mm_and_si128(upper_half, _mm_shuffle_epi8(high_table, low)));
+                    const __m128i bit = _mm_shuffle_epi8(bit_table, high);
+                    const __m128i hit = _mm_cmpeq_epi8(_mm_and_si128(row, bit), bit);
+                    word |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(hit))) << part;
+                }
+                selection[i >> 6] = word;
+                selected += count_bits_(word);
+            }
+            done = i;
+            return selected;
+        }
+#endif
+
+#if defined(MC_CURRENCY_SET_SSSE3)
+        /// Whether the processor runs SSSE3, checked once
+        bool has_ssse3_() noexcept {
+#if !defined(MC_CURRENCY_SET_DISPATCH)
+            return true;
+#elif defined(_MSC_VER)
+            static const bool supported = [] {
+                int registers[4];
+                __cpuid(registers, 1);
+                return (registers[2] & (1 << 9)) != 0;
+            }();
+            return supported;
+#else
+            static const bool supported = __builtin_cpu_supports("ssse3");
+            return supported;
+#endif
+        }
+#endif
+    }
+
+    currency_set::iterator::iterator(const std::uint64_t* words, std::size_t index) noexcept :
+    _words(words), _index(impl::next_member_(words, index)) {
+    }
+
+    currency_set::iterator& currency_set::iterator::operator++() noexcept {
+        _index = impl::next_member_(_words, _index + 1);
+        return *this;
+    }
+
+    std::size_t filter(const std::uint8_t* currencies, std::size_t n, const currency_set& set, bitmask* selection) noexcept {
+#if defined(MC_CURRENCY_SET_SSSE3)
+        if (impl::has_ssse3_()) {
+            std::size_t done = 0;
+            const std::size_t selected = impl::filter_ssse3_(currencies, n, set, selection, done);
+            return selected + impl::filter_scalar_(currencies, done, n, set, selection);
+        }
+#endif
+        return impl::filter_scalar_(currencies, 0, n, set, selection);
+    }
+}
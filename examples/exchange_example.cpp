@@ -1,67 +1,30 @@
-#include "../money.h"
+#include "../money.hpp"
+#include "../rate_table.hpp"
 #include <iostream>
-#include <fstream>
-#include <vector>
-#include <algorithm>
 
 using mc::money;
-using mc::to_currency;
 using currency = mc::currency;
 
-struct exchange_data {
-    currency from;
-    currency to;
-    double rate;
-};
-
-struct has_exchange {
-    exchange_data _test;
-
-    has_exchange(exchange_data t) : _test(t) {
-    }
-
-    bool operator()(exchange_data ex) {
-        return (ex.from == _test.from && _test.to == ex.to);
-    }
-};
-
 int main(int argc, char** argv) {
-    std::vector<exchange_data> exchange;
-    std::ifstream fin("exchange.txt");
+    // "FROM TO RATE" lines, each one also defines the inverse rate
+    mc::rate_table exchange = mc::load_rates("exchange.txt");
 
-    while (fin.eof() == false) {
-        std::string from, to;
-        double rate;
-        fin >> from >> to >> rate;
-        exchange_data tmp;
-        std::cout << from << " " << to << " " << rate << std::endl;
-        tmp.from = to_currency(from);
-        tmp.to = to_currency(to);
-        tmp.rate = rate;
-        exchange.push_back(tmp);
-        tmp.from = to_currency(to);
-        tmp.to = to_currency(from);
-        tmp.rate = 1. / rate;
-        exchange.push_back(tmp);
-    }
     std::string shortname_from, shortname_to;
     double total;
     std::cin >> shortname_from >> shortname_to >> total;
 
-    exchange_data test = {
-        mc::to_currency(shortname_from),
-        mc::to_currency(shortname_to),
-        0.
-    };
+    currency from = mc::to_currency(shortname_from);
+    currency to = mc::to_currency(shortname_to);
 
-    // TODO#: very ideal case. if exchange does not exists, will fail
-    exchange_data data = *(std::find_if(exchange.begin(), exchange.end(), has_exchange(test)));
+    if (!exchange.has(from, to)) {
+        std::cout << "no exchange rate from " << shortname_from << " to " << shortname_to << std::endl;
+        return 1;
+    }
 
     std::cout << "result = " 
-            << money(data.from, total).convert(data.to, data.rate).amount() / 100. 
+            << exchange.convert(money(from, total), to).amount() / 100. 
             << " " 
-            << mc::to_shortname(data.to);
+            << mc::to_shortname(to);
 
     return 0;
 }
-
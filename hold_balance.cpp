@@ -0,0 +1,100 @@
+#include "hold_balance.hpp"
+
+#include <limits>
+
+namespace mc {
+
+    hold_balance::hold_balance(mc::currency c, std::uint64_t available) noexcept :
+    _state(state{available, 0}), _currency(c) {
+
+    }
+
+    bool hold_balance::is_lock_free() const noexcept {
+        return _state.is_lock_free();
+    }
+
+    mc::currency hold_balance::currency() const noexcept {
+        return _currency;
+    }
+
+    hold_balance::state hold_balance::load() const noexcept {
+        return _state.load(std::memory_order_acquire);
+    }
+
+    money hold_balance::available() const {
+        return money::from_amount(_currency, load().available);
+    }
+
+    money hold_balance::held() const {
+        return money::from_amount(_currency, load().held);
+    }
+
+    /// Applies update to a copy of the state until the swap succeeds or update refuses
+    template <typename Update>
+    bool hold_balance::update(Update update) noexcept {
+        state current = _state.load(std::memory_order_relaxed);
+        state next;
+        do {
+            next = current;
+            if (!update(next)) {
+                return false;
+            }
+        } while (!_state.compare_exchange_weak(current, next,
+                std::memory_order_acq_rel, std::memory_order_relaxed));
+        return true;
+    }
+
+    bool hold_balance::credit(std::uint64_t amount) noexcept {
+        return update([amount](state& s) {
+            const std::uint64_t total = s.available + s.held;
+            if (amount > std::numeric_limits<std::uint64_t>::max() - total) {
+                return false;
+            }
+            s.available += amount;
+            return true;
+        });
+    }
+
+    bool hold_balance::reserve(std::uint64_t amount) noexcept {
+        return update([amount](state& s) {
+            if (s.available < amount) {
+                return false;
+            }
+            s.available -= amount;
+            s.held += amount;
+            return true;
+        });
+    }
+
+    bool hold_balance::capture(std::uint64_t amount) noexcept {
+        return update([amount](state& s) {
+            if (s.held < amount) {
+                return false;
+            }
+            s.held -= amount;
+            return true;
+        });
+    }
+
+    bool hold_balance::capture(std::uint64_t amount, std::uint64_t reserved) noexcept {
+        return update([amount, reserved](state& s) {
+            if (amount > reserved || s.held < reserved) {
+                return false;
+            }
+            s.held -= reserved;
+            s.available += reserved - amount;
+            return true;
+        });
+    }
+
+    bool hold_balance::release(std::uint64_t amount) noexcept {
+        return update([amount](state& s) {
+            if (s.held < amount) {
+                return false;
+            }
+            s.held -= amount;
+            s.available += amount;
+            return true;
+        });
+    }
+}
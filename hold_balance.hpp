@@ -0,0 +1,132 @@
+/**
+ * @file hold_balance.hpp
+ * @brief Lock-free balance with authorization holds (reserve/capture/release).
+ *
+ * Card flows reserve funds first and later capture or release them. The hold
+ * balance keeps the available and the held amount together in one 16-byte
+ * state updated by a double-width compare-and-swap, so every operation moves
+ * funds between the two amounts atomically and readers always see a
+ * consistent pair.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef HOLD_BALANCE_HPP
+#define HOLD_BALANCE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include "money.hpp"
+
+namespace mc {
+
+    /**
+     * @brief A balance split into available and held funds, updated without locks.
+     *
+     * All operations are linearizable and never throw; an operation that
+     * would make either amount negative (or overflow it) fails and leaves the
+     * balance unchanged. Amounts are in smallest currency units.
+     */
+    class hold_balance {
+    public:
+        /**
+         * @brief A consistent view of both amounts.
+         */
+        struct alignas(16) state {
+            std::uint64_t available; ///< Funds that can be reserved
+            std::uint64_t held;      ///< Funds reserved and not yet captured or released
+        };
+
+    private:
+        std::atomic<state> _state;    ///< Both amounts, swapped together
+        const mc::currency _currency; ///< Currency fixed at construction
+
+    public:
+        /**
+         * @brief Constructs a balance with the given available funds and nothing held.
+         * @param curr The currency of the balance
+         * @param available Initial available funds
+         */
+        explicit hold_balance(mc::currency curr, std::uint64_t available = 0) noexcept;
+
+        hold_balance(const hold_balance&) = delete;
+        hold_balance& operator=(const hold_balance&) = delete;
+
+        /**
+         * @brief Checks whether the double-width compare-and-swap is lock-free.
+         *
+         * Some standard libraries report false even when the platform
+         * instruction (e.g. cmpxchg16b) is used at run time.
+         *
+         * @return true if the state is reported lock-free
+         */
+        bool is_lock_free() const noexcept;
+
+        /**
+         * @brief Gets the currency of the balance.
+         * @return The currency enumeration value
+         */
+        mc::currency currency() const noexcept;
+
+        /**
+         * @brief Loads both amounts at once.
+         * @return The available and held amounts
+         */
+        state load() const noexcept;
+
+        /**
+         * @brief Gets the available funds.
+         * @return The available funds as a money object
+         */
+        money available() const;
+
+        /**
+         * @brief Gets the held funds.
+         * @return The held funds as a money object
+         */
+        money held() const;
+
+        /**
+         * @brief Adds funds to the available amount.
+         * @param amount The amount to add
+         * @return true on success, false if the total would overflow
+         */
+        bool credit(std::uint64_t amount) noexcept;
+
+        /**
+         * @brief Moves funds from the available to the held amount.
+         * @param amount The amount to reserve
+         * @return true on success, false if the available funds are insufficient
+         */
+        bool reserve(std::uint64_t amount) noexcept;
+
+        /**
+         * @brief Removes funds from the held amount, completing a payment.
+         * @param amount The amount to capture
+         * @return true on success, false if the held funds are insufficient
+         */
+        bool capture(std::uint64_t amount) noexcept;
+
+        /**
+         * @brief Captures part of a hold and releases the rest in one step.
+         * @param amount The amount to capture
+         * @param reserved The amount that was reserved for this payment
+         * @return true on success, false if amount exceeds reserved or the held funds are insufficient
+         */
+        bool capture(std::uint64_t amount, std::uint64_t reserved) noexcept;
+
+        /**
+         * @brief Moves funds from the held back to the available amount.
+         * @param amount The amount to release
+         * @return true on success, false if the held funds are insufficient
+         */
+        bool release(std::uint64_t amount) noexcept;
+
+    private:
+        template <typename Update>
+        bool update(Update update) noexcept;
+    };
+}
+
+#endif /* HOLD_BALANCE_HPP */
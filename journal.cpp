@@ -0,0 +1,502 @@
+#include "journal.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include "mapped_file.hpp"
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mc {
+
+    namespace impl {
+        /// Number of records replayed per ledger restore
+        constexpr std::size_t replay_chunk_ = 1 << 16;
+
+        /// Number of records every thread buckets per round of a parallel replay
+        constexpr std::size_t replay_round_ = 1 << 20;
+
+        /// A record amount bucketed for a shard, indexed within the shard
+        struct shard_entry_ {
+            std::uint32_t index;
+            std::int64_t amount;
+        };
+
+        /// The first record a replay thread rejected
+        struct replay_failure_ {
+            std::size_t record = std::numeric_limits<std::size_t>::max();
+            bool unknown_account = false;
+        };
+
+        /// Runs work(0) .. work(threads - 1), on the calling thread too
+        template<typename Work>
+        void run_parallel_(std::size_t threads, Work work) {
+            std::vector<std::thread> workers;
+            workers.reserve(threads - 1);
+            for (std::size_t t = 1; t < threads; ++t) {
+                workers.emplace_back(work, t);
+            }
+            work(0);
+            for (auto& w : workers) {
+                w.join();
+            }
+        }
+
+        constexpr char journal_magic_[8] = {'M', 'C', 'J', 'O', 'U', 'R', 'N', 'L'};
+        constexpr std::uint32_t journal_version_ = 1;
+
+        journal_header make_journal_header_() noexcept {
+            journal_header header;
+            std::memcpy(header.magic, journal_magic_, sizeof (header.magic));
+            header.version = journal_version_;
+            header.record_size = sizeof (journal_record);
+            return header;
+        }
+
+        bool is_journal_header_(const journal_header& header) noexcept {
+            return std::memcmp(header.magic, journal_magic_, sizeof (header.magic)) == 0
+                    && header.version == journal_version_
+                    && header.record_size == sizeof (journal_record);
+        }
+
+        std::int64_t now_nanoseconds_() noexcept {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+
+        /// Maps a journal file and checks its header
+        mapped_file map_journal_(const std::string& path) {
+            mapped_file file(path);
+            journal_header header;
+            if (file.size() < sizeof (header)) {
+                throw std::runtime_error("not a journal file: " + path);
+            }
+            std::memcpy(&header, file.data(), sizeof (header));
+            if (!is_journal_header_(header)) {
+                throw std::runtime_error("not a journal file: " + path);
+            }
+            return file;
+        }
+
+        std::size_t journal_records_(const mapped_file& file) noexcept {
+            return (file.size() - sizeof (journal_header)) / sizeof (journal_record);
+        }
+
+#if defined(_WIN32)
+        int open_journal_(const std::string& path) noexcept {
+            return ::_open(path.c_str(), _O_RDWR | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+        }
+
+        long long file_size_(int fd) noexcept {
+            return ::_lseeki64(fd, 0, SEEK_END);
+        }
+
+        bool read_at_start_(int fd, void* data, std::size_t size) noexcept {
+            return ::_lseeki64(fd, 0, SEEK_SET) == 0
+                    && ::_read(fd, data, static_cast<unsigned>(size)) == static_cast<int>(size);
+        }
+
+        bool truncate_(int fd, long long size) noexcept {
+            return ::_chsize_s(fd, size) == 0;
+        }
+
+        bool write_all_(int fd, const char* data, std::size_t size) noexcept {
+            while (size > 0) {
+                const int written = ::_write(fd, data, static_cast<unsigned>(std::min<std::size_t>(size, 1 << 30)));
+                if (written < 0) {
+                    return false;
+                }
+                data += written;
+                size -= static_cast<std::size_t>(written);
+            }
+            return true;
+        }
+
+        bool sync_(int fd) noexcept {
+            return ::_commit(fd) == 0;
+        }
+
+        void close_(int fd) noexcept {
+            ::_close(fd);
+        }
+#else
+        int open_journal_(const std::string& path) noexcept {
+            return ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        }
+
+        long long file_size_(int fd) noexcept {
+            struct stat st;
+            return ::fstat(fd, &st) == 0 ? static_cast<long long>(st.st_size) : -1;
+        }
+
+        bool read_at_start_(int fd, void* data, std::size_t size) noexcept {
+            return ::pread(fd, data, size, 0) == static_cast<ssize_t>(size);
+        }
+
+        bool truncate_(int fd, long long size) noexcept {
+            return ::ftruncate(fd, static_cast<off_t>(size)) == 0;
+        }
+
+        bool write_all_(int fd, const char* data, std::size_t size) noexcept {
+            while (size > 0) {
+                const ssize_t written = ::write(fd, data, size);
+                if (written < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return false;
+                }
+                data += written;
+                size -= static_cast<std::size_t>(written);
+            }
+            return true;
+        }
+
+        bool sync_(int fd) noexcept {
+#if defined(__linux__)
+            return ::fdatasync(fd) == 0;
+#else
+            return ::fsync(fd) == 0;
+#endif
+        }
+
+        void close_(int fd) noexcept {
+            ::close(fd);
+        }
+#endif
+    }
+
+    journal_record journal_record::of(const leg& value) noexcept {
+        journal_record record{};
+        record.account = value.account;
+        record.currency = static_cast<std::uint8_t>(value.currency);
+        record.amount = value.amount;
+        record.timestamp = impl::now_nanoseconds_();
+        return record;
+    }
+
+    leg journal_record::to_leg() const noexcept {
+        return leg{account, static_cast<mc::currency>(currency), amount};
+    }
+
+    journal_writer::journal_writer(const std::string& path, journal_options options) :
+    _options(options), _fd(-1), _mask(0), _tail(0),
+    _wake_at(std::numeric_limits<std::uint64_t>::max()), _head(0), _durable(0),
+    _urgent(false), _failed(false), _stopping(false) {
+        _options.max_batch = std::max<std::size_t>(1, _options.max_batch);
+        std::size_t capacity = 1;
+        while (capacity < _options.queue_capacity) {
+            capacity <<= 1;
+        }
+        _mask = capacity - 1;
+        _slots.reset(new slot[capacity]);
+        for (std::size_t i = 0; i < capacity; ++i) {
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        _fd = impl::open_journal_(path);
+        if (_fd < 0) {
+            throw std::runtime_error("cannot open journal: " + path);
+        }
+        const long long size = impl::file_size_(_fd);
+        bool valid = size >= 0;
+        if (valid && size < static_cast<long long>(sizeof (journal_header))) {
+            // a new journal, or one that crashed while writing its header
+            const journal_header header = impl::make_journal_header_();
+            valid = impl::truncate_(_fd, 0)
+                    && impl::write_all_(_fd, reinterpret_cast<const char*>(&header), sizeof (header))
+                    && impl::sync_(_fd);
+        } else if (valid) {
+            journal_header header;
+            valid = impl::read_at_start_(_fd, &header, sizeof (header)) && impl::is_journal_header_(header);
+            // drop a record torn by a crash, so appended records stay aligned
+            const long long records = (size - static_cast<long long>(sizeof (header))) / static_cast<long long>(sizeof (journal_record));
+            const long long end = static_cast<long long>(sizeof (header)) + records * static_cast<long long>(sizeof (journal_record));
+            valid = valid && (end == size || impl::truncate_(_fd, end));
+        }
+        if (!valid) {
+            impl::close_(_fd);
+            throw std::runtime_error("not a journal file: " + path);
+        }
+        try {
+            _thread = std::thread(&journal_writer::run, this);
+        } catch (...) {
+            impl::close_(_fd);
+            throw;
+        }
+    }
+
+    journal_writer::~journal_writer() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping.store(true);
+            _wake.notify_one();
+        }
+        _thread.join();
+        impl::close_(_fd);
+    }
+
+    std::uint64_t journal_writer::append(const journal_record& record) noexcept {
+        std::uint64_t position = _tail.load(std::memory_order_relaxed);
+        slot* s;
+        for (;;) {
+            s = &_slots[position & _mask];
+            const std::uint64_t sequence = s->sequence.load(std::memory_order_acquire);
+            if (sequence == position) {
+                if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (sequence < position) {
+                // the queue is full, let the writer drain it
+                std::this_thread::yield();
+                position = _tail.load(std::memory_order_relaxed);
+            } else {
+                position = _tail.load(std::memory_order_relaxed);
+            }
+        }
+        s->record = record;
+        s->sequence.store(position + 1, std::memory_order_release);
+
+        // pairs with the fence in run(): either the writer sees this record or we see it waiting
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (position + 1 >= _wake_at.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _wake.notify_one();
+        }
+        return position + 1;
+    }
+
+    std::uint64_t journal_writer::append(const leg& value) noexcept {
+        return append(journal_record::of(value));
+    }
+
+    std::uint64_t journal_writer::append(const leg* legs, std::size_t count) noexcept {
+        if (count == 0) {
+            return _tail.load(std::memory_order_acquire);
+        }
+        const std::int64_t timestamp = impl::now_nanoseconds_();
+        std::uint64_t sequence = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            journal_record record = journal_record::of(legs[i]);
+            record.timestamp = timestamp;
+            sequence = append(record);
+        }
+        return sequence;
+    }
+
+    std::uint64_t journal_writer::durable() const noexcept {
+        return _durable.load(std::memory_order_acquire);
+    }
+
+    void journal_writer::wait_durable(std::uint64_t sequence) {
+        if (_durable.load(std::memory_order_acquire) < sequence) {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _urgent.store(true);
+            _wake.notify_one();
+            _committed.wait(lock, [this, sequence] {
+                return _durable.load(std::memory_order_acquire) >= sequence || _failed.load();
+            });
+        }
+        if (_durable.load(std::memory_order_acquire) < sequence) {
+            throw std::runtime_error("journal write failed");
+        }
+    }
+
+    void journal_writer::flush() {
+        wait_durable(_tail.load(std::memory_order_acquire));
+    }
+
+    void journal_writer::run() {
+        using clock = std::chrono::steady_clock;
+        std::vector<journal_record> batch;
+        batch.reserve(_options.max_batch);
+        clock::time_point deadline = clock::time_point::max();
+        for (;;) {
+            while (batch.size() < _options.max_batch) {
+                slot& s = _slots[_head & _mask];
+                if (s.sequence.load(std::memory_order_acquire) != _head + 1) {
+                    break;
+                }
+                if (batch.empty()) {
+                    deadline = clock::now() + _options.max_latency;
+                }
+                batch.push_back(s.record);
+                s.sequence.store(_head + _mask + 1, std::memory_order_release);
+                ++_head;
+            }
+
+            const bool stopping = _stopping.load();
+            if (!batch.empty() && (batch.size() >= _options.max_batch || stopping
+                    || _urgent.exchange(false) || clock::now() >= deadline)) {
+                commit(batch);
+                batch.clear();
+                continue;
+            }
+            if (batch.empty() && stopping && _tail.load() == _head) {
+                return;
+            }
+
+            // sleep until the batch can fill up, a producer waits, or the deadline passes
+            const bool idle = batch.empty();
+            const std::uint64_t missing = std::min<std::uint64_t>(_options.max_batch - batch.size(), _mask + 1);
+            const std::uint64_t target = idle ? _head + 1 : _head + missing;
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake_at.store(target, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const clock::time_point until = idle ? clock::now() + _options.max_latency : deadline;
+            _wake.wait_until(lock, until, [this, target, idle] {
+                return _stopping.load() || (!idle && _urgent.load()) || _tail.load() >= target;
+            });
+            _wake_at.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+        }
+    }
+
+    bool journal_writer::commit(const std::vector<journal_record>& batch) noexcept {
+        if (!_failed.load()) {
+            const bool written = impl::write_all_(_fd, reinterpret_cast<const char*>(batch.data()),
+                    batch.size() * sizeof (journal_record))
+                    && (!_options.sync || impl::sync_(_fd));
+            if (written) {
+                _durable.fetch_add(batch.size(), std::memory_order_release);
+            } else {
+                _failed.store(true);
+            }
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        _committed.notify_all();
+        return !_failed.load();
+    }
+
+    std::vector<journal_record> read_journal(const std::string& path) {
+        const mapped_file file = impl::map_journal_(path);
+        std::vector<journal_record> records(impl::journal_records_(file));
+        if (!records.empty()) {
+            std::memcpy(records.data(), file.data() + sizeof (journal_header), records.size() * sizeof (journal_record));
+        }
+        return records;
+    }
+
+    std::size_t replay_journal(const std::string& path, ledger& book) {
+        const mapped_file file = impl::map_journal_(path);
+        const std::size_t count = impl::journal_records_(file);
+        const char* data = file.data() + sizeof (journal_header);
+        // check every record before applying any, so a bad record leaves the ledger unchanged
+        const std::size_t accounts = book.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            journal_record record;
+            std::memcpy(&record, data + i * sizeof (journal_record), sizeof (record));
+            if (record.account >= accounts) {
+                throw std::out_of_range("unknown account!");
+            }
+            if (book.currency(record.account) != static_cast<mc::currency>(record.currency)) {
+                throw std::invalid_argument("incompatible currencies!");
+            }
+        }
+        std::vector<leg> legs;
+        legs.reserve(std::min(count, impl::replay_chunk_));
+        for (std::size_t begin = 0; begin < count; begin += impl::replay_chunk_) {
+            const std::size_t end = std::min(count, begin + impl::replay_chunk_);
+            legs.clear();
+            for (std::size_t i = begin; i < end; ++i) {
+                journal_record record;
+                std::memcpy(&record, data + i * sizeof (journal_record), sizeof (record));
+                legs.push_back(record.to_leg());
+            }
+            book.restore(legs.data(), legs.size());
+        }
+        return count;
+    }
+
+    std::size_t replay_journal(const std::vector<std::string>& segments, ledger& book, std::size_t threads) {
+        std::vector<mapped_file> files;
+        std::vector<std::size_t> starts(1, 0);
+        files.reserve(segments.size());
+        for (const std::string& path : segments) {
+            files.push_back(impl::map_journal_(path));
+            starts.push_back(starts.back() + impl::journal_records_(files.back()));
+        }
+        const std::size_t total = starts.back();
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        const std::size_t shards = threads;
+        const std::size_t accounts = book._balances.size();
+        const std::vector<mc::currency>& currencies = book._currencies;
+
+        // shard s owns the accounts a with a % shards == s, at index a / shards
+        std::vector<std::vector<std::int64_t>> shard_balances(shards);
+        for (std::size_t s = 0; s < shards; ++s) {
+            shard_balances[s].assign((accounts + shards - 1 - s) / shards, 0);
+        }
+        // buckets[t * shards + s] holds the amounts found by thread t for shard s
+        std::vector<std::vector<impl::shard_entry_>> buckets(threads * shards);
+        std::vector<impl::replay_failure_> failures(threads);
+
+        for (std::size_t round = 0; round < total; round += threads * impl::replay_round_) {
+            const std::size_t size = std::min(total - round, threads * impl::replay_round_);
+            impl::run_parallel_(threads, [&](std::size_t t) {
+                const std::size_t begin = round + size * t / threads;
+                const std::size_t end = round + size * (t + 1) / threads;
+                std::size_t file = static_cast<std::size_t>(std::upper_bound(starts.begin(), starts.end(), begin) - starts.begin()) - 1;
+                for (std::size_t i = begin; i < end; ++i) {
+                    while (i >= starts[file + 1]) {
+                        ++file;
+                    }
+                    journal_record record;
+                    std::memcpy(&record, files[file].data() + sizeof (journal_header)
+                            + (i - starts[file]) * sizeof (journal_record), sizeof (record));
+                    if (record.account >= accounts || currencies[record.account] != static_cast<mc::currency>(record.currency)) {
+                        if (i < failures[t].record) {
+                            failures[t].record = i;
+                            failures[t].unknown_account = record.account >= accounts;
+                        }
+                        continue;
+                    }
+                    if (shards == 1) {
+                        shard_balances[0][record.account] += record.amount;
+                        continue;
+                    }
+                    buckets[t * shards + record.account % shards].push_back(
+                            impl::shard_entry_{static_cast<std::uint32_t>(record.account / shards), record.amount});
+                }
+            });
+            const auto first = std::min_element(failures.begin(), failures.end(),
+                    [](const impl::replay_failure_& a, const impl::replay_failure_& b) { return a.record < b.record; });
+            if (first->record != std::numeric_limits<std::size_t>::max()) {
+                if (first->unknown_account) {
+                    throw std::out_of_range("unknown account!");
+                }
+                throw std::invalid_argument("incompatible currencies!");
+            }
+            impl::run_parallel_(shards, [&](std::size_t s) {
+                std::vector<std::int64_t>& balances = shard_balances[s];
+                for (std::size_t t = 0; t < threads; ++t) {
+                    for (const impl::shard_entry_& e : buckets[t * shards + s]) {
+                        balances[e.index] += e.amount;
+                    }
+                    buckets[t * shards + s].clear();
+                }
+            });
+        }
+
+        // merge by account range, so no two threads write the same cache line
+        std::vector<std::int64_t>& balances = book._balances;
+        impl::run_parallel_(threads, [&](std::size_t t) {
+            const std::size_t end = accounts * (t + 1) / threads;
+            for (std::size_t a = accounts * t / threads; a < end; ++a) {
+                balances[a] += shard_balances[a % shards][a / shards];
+            }
+        });
+        return total;
+    }
+}
@@ -0,0 +1,225 @@
+/**
+ * @file journal.hpp
+ * @brief Write-ahead journal of balance changes with group commit.
+ *
+ * The journal is an append-only binary file of fixed-size records, one per
+ * ledger leg, written before the change is considered durable. Producers
+ * enqueue records into a lock-free queue; a writer thread drains it and
+ * makes a whole batch durable with one write and one fsync, bounded by a
+ * maximum batch size and a maximum latency. Replaying the journal rebuilds
+ * the balances of a ledger.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef JOURNAL_HPP
+#define JOURNAL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ledger.hpp"
+
+namespace mc {
+
+    /**
+     * @brief One journaled balance change, stored in host byte order.
+     */
+    struct journal_record {
+        account_id account;       ///< Account the amount is posted to
+        std::uint8_t currency;    ///< Index of the account currency
+        std::uint8_t reserved[3]; ///< Zero padding
+        std::int64_t amount;      ///< Amount in smallest currency units, positive for a debit
+        std::int64_t timestamp;   ///< Nanoseconds since the Unix epoch when the record was appended
+
+        /**
+         * @brief Creates a record of a leg stamped with the current time.
+         * @param value The leg to journal
+         * @return The journal record
+         */
+        static journal_record of(const leg& value) noexcept;
+
+        /**
+         * @brief Gets the leg described by the record.
+         * @return The leg
+         */
+        leg to_leg() const noexcept;
+    };
+
+    static_assert(sizeof(journal_record) == 24, "journal records must be 24 bytes");
+
+    /**
+     * @brief Header at the start of every journal file.
+     */
+    struct journal_header {
+        char magic[8];             ///< Always "MCJOURNL"
+        std::uint32_t version;     ///< Format version, currently 1
+        std::uint32_t record_size; ///< Size of one record in bytes
+    };
+
+    /**
+     * @brief Batching bounds of a journal writer.
+     */
+    struct journal_options {
+        std::size_t max_batch = 4096;                ///< Most records made durable by one write
+        std::chrono::microseconds max_latency{1000}; ///< Longest time a record waits for its batch to fill
+        std::size_t queue_capacity = 1 << 16;        ///< Records the queue holds, rounded up to a power of two
+        bool sync = true;                            ///< Whether every batch is followed by an fsync
+    };
+
+    /**
+     * @brief Appends records to a journal file from many threads.
+     *
+     * Every appended record gets a sequence number, starting at 1, in the
+     * order the records are written. A producer that needs durability waits
+     * for its sequence number with wait_durable(). When the queue is full,
+     * producers wait for the writer to catch up.
+     */
+    class journal_writer {
+        /// A queue slot, its sequence tells producers and the writer whose turn it is
+        struct slot {
+            std::atomic<std::uint64_t> sequence;
+            journal_record record;
+        };
+
+        journal_options _options;                     ///< Batching bounds
+        int _fd;                                      ///< Descriptor of the journal file
+        std::unique_ptr<slot[]> _slots;               ///< Ring buffer of queued records
+        std::uint64_t _mask;                          ///< Queue capacity minus one
+        alignas(64) std::atomic<std::uint64_t> _tail; ///< Next position producers claim
+        std::atomic<std::uint64_t> _wake_at;          ///< Queue length at which producers wake the writer
+        alignas(64) std::uint64_t _head;              ///< Next position the writer reads
+        std::atomic<std::uint64_t> _durable;          ///< Number of records written and synced
+        std::atomic<bool> _urgent;                    ///< A producer waits, commit without waiting for the batch to fill
+        std::atomic<bool> _failed;                    ///< A write or sync failed, nothing more is written
+        std::atomic<bool> _stopping;                  ///< The writer must write the queue and finish
+        std::mutex _mutex;                            ///< Guards the waits on the condition variables
+        std::condition_variable _wake;                ///< Wakes the writer
+        std::condition_variable _committed;           ///< Wakes producers waiting for durability
+        std::thread _thread;                          ///< Writer thread
+    public:
+        /**
+         * @brief Opens a journal file for appending and starts the writer thread.
+         *
+         * A missing or empty file is created with a journal header.
+         *
+         * @param path Path to the journal file
+         * @param options Batching bounds
+         * @throws std::runtime_error if the file cannot be opened or is not a journal
+         */
+        explicit journal_writer(const std::string& path, journal_options options = journal_options());
+
+        journal_writer(const journal_writer&) = delete;
+        journal_writer& operator=(const journal_writer&) = delete;
+
+        /**
+         * @brief Writes all appended records and closes the file.
+         */
+        ~journal_writer();
+
+        /**
+         * @brief Enqueues a record.
+         * @param record The record to write
+         * @return The sequence number of the record
+         */
+        std::uint64_t append(const journal_record& record) noexcept;
+
+        /**
+         * @brief Enqueues a record of a leg stamped with the current time.
+         * @param value The leg to journal
+         * @return The sequence number of the record
+         */
+        std::uint64_t append(const leg& value) noexcept;
+
+        /**
+         * @brief Enqueues records of the legs of an entry.
+         * @param legs Pointer to the first leg
+         * @param count Number of legs
+         * @return The sequence number of the last record, or of the last
+         *         appended record if count is zero
+         */
+        std::uint64_t append(const leg* legs, std::size_t count) noexcept;
+
+        /**
+         * @brief Gets the number of records written and synced.
+         * @return The highest durable sequence number
+         */
+        std::uint64_t durable() const noexcept;
+
+        /**
+         * @brief Blocks until a record is durable.
+         * @param sequence The sequence number returned by append()
+         * @throws std::runtime_error if writing the journal failed
+         */
+        void wait_durable(std::uint64_t sequence);
+
+        /**
+         * @brief Blocks until every record appended so far is durable.
+         * @throws std::runtime_error if writing the journal failed
+         */
+        void flush();
+
+    private:
+        void run();
+        bool commit(const std::vector<journal_record>& batch) noexcept;
+    };
+
+    /**
+     * @brief Reads all complete records of a journal file.
+     *
+     * A partially written record at the end of the file, left by a crash
+     * during a write, is ignored.
+     *
+     * @param path Path to the journal file
+     * @return The records in file order
+     * @throws std::runtime_error if the file cannot be read or is not a journal
+     */
+    std::vector<journal_record> read_journal(const std::string& path);
+
+    /**
+     * @brief Rebuilds ledger balances from a journal file.
+     *
+     * The accounts must already be open in the ledger; records are applied
+     * in large batches without per-record allocation. Every record is
+     * checked before any is applied, so the ledger is left unchanged when a
+     * record is rejected.
+     *
+     * @param path Path to the journal file
+     * @param book The ledger to apply the records to
+     * @return The number of records applied
+     * @throws std::runtime_error if the file cannot be read or is not a journal
+     * @throws std::out_of_range if a record refers to an account that is not open
+     * @throws std::invalid_argument if a record currency differs from its account currency
+     */
+    std::size_t replay_journal(const std::string& path, ledger& book);
+
+    /**
+     * @brief Rebuilds ledger balances from journal segments in parallel.
+     *
+     * The segments are mapped and their records split evenly across threads.
+     * Every thread scans its records and buckets them by account hash; every
+     * shard then sums its buckets into its own balance array, and the shard
+     * arrays are finally added to the ledger. Since the records are only
+     * summed, the balances equal those of a serial replay.
+     *
+     * @param segments Paths to the journal files, in any order
+     * @param book The ledger to apply the records to
+     * @param threads Number of threads; zero selects the number of hardware threads
+     * @return The number of records applied
+     * @throws std::runtime_error if a file cannot be read or is not a journal
+     * @throws std::out_of_range if a record refers to an account that is not open
+     * @throws std::invalid_argument if a record currency differs from its account currency;
+     *         the ledger is left unchanged when a record is rejected
+     */
+    std::size_t replay_journal(const std::vector<std::string>& segments, ledger& book, std::size_t threads = 0);
+}
+
+#endif /* JOURNAL_HPP */
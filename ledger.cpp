@@ -0,0 +1,227 @@
+#include "ledger.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace mc {
+
+    namespace impl {
+        /// Smallest number of legs per thread worth sharding a batch for
+        constexpr std::size_t legs_per_shard_ = 1 << 16;
+
+        /// Subtracts the legs again, returning the bag to zero
+        void undo_legs_(money_bag& bag, const leg* legs, std::size_t count) noexcept {
+            for (std::size_t i = 0; i < count; ++i) {
+                bag.try_add(legs[i].currency, -legs[i].amount);
+            }
+        }
+
+        std::int64_t leg_amount_(const money& m) {
+            if (m.amount() > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+                throw std::overflow_error("amount does not fit into a leg");
+            }
+            return static_cast<std::int64_t>(m.amount());
+        }
+    }
+
+    leg leg::debit(account_id account, const money& m) {
+        return leg{account, m.currency(), impl::leg_amount_(m)};
+    }
+
+    leg leg::credit(account_id account, const money& m) {
+        return leg{account, m.currency(), -impl::leg_amount_(m)};
+    }
+
+    void journal_batch::add(const leg* legs, std::size_t count) {
+        _legs.insert(_legs.end(), legs, legs + count);
+        _ends.push_back(_legs.size());
+    }
+
+    void journal_batch::add(std::initializer_list<leg> legs) {
+        add(legs.begin(), legs.size());
+    }
+
+    std::size_t journal_batch::size() const noexcept {
+        return _ends.size();
+    }
+
+    std::size_t journal_batch::legs() const noexcept {
+        return _legs.size();
+    }
+
+    const leg* journal_batch::entry(std::size_t index) const noexcept {
+        return _legs.data() + (index == 0 ? 0 : _ends[index - 1]);
+    }
+
+    std::size_t journal_batch::entry_size(std::size_t index) const noexcept {
+        return _ends[index] - (index == 0 ? 0 : _ends[index - 1]);
+    }
+
+    void journal_batch::reserve(std::size_t entries, std::size_t legs) {
+        _ends.reserve(entries);
+        _legs.reserve(legs);
+    }
+
+    void journal_batch::clear() noexcept {
+        _legs.clear();
+        _ends.clear();
+    }
+
+    ledger::ledger(std::size_t threads) :
+    _threads(threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads) {
+
+    }
+
+    account_id ledger::open_account(mc::currency c) {
+        _balances.push_back(0);
+        _currencies.push_back(c);
+        return static_cast<account_id>(_balances.size() - 1);
+    }
+
+    std::size_t ledger::size() const noexcept {
+        return _balances.size();
+    }
+
+    mc::currency ledger::currency(account_id account) const {
+        return _currencies.at(account);
+    }
+
+    std::int64_t ledger::balance(account_id account) const {
+        return _balances.at(account);
+    }
+
+    money_bag ledger::trial_balance() const {
+        money_bag total;
+        for (std::size_t i = 0; i < _balances.size(); ++i) {
+            total.add(_currencies[i], _balances[i]);
+        }
+        return total;
+    }
+
+    posting_status ledger::validate(const leg* legs, std::size_t count) noexcept {
+        if (count == 0) {
+            return posting_status::empty;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            const leg& l = legs[i];
+            if (l.account >= _balances.size()) {
+                impl::undo_legs_(_check, legs, i);
+                return posting_status::unknown_account;
+            }
+            if (_currencies[l.account] != l.currency) {
+                impl::undo_legs_(_check, legs, i);
+                return posting_status::currency_mismatch;
+            }
+            // a leg that cannot be negated or overflows the check can never balance
+            if (l.amount == std::numeric_limits<std::int64_t>::min() || !_check.try_add(l.currency, l.amount)) {
+                impl::undo_legs_(_check, legs, i);
+                return posting_status::unbalanced;
+            }
+        }
+        if (!_check.is_zero()) {
+            impl::undo_legs_(_check, legs, count);
+            return posting_status::unbalanced;
+        }
+        return posting_status::posted;
+    }
+
+    posting_status ledger::post(const leg* legs, std::size_t count) noexcept {
+        const posting_status status = validate(legs, count);
+        if (status == posting_status::posted) {
+            for (std::size_t i = 0; i < count; ++i) {
+                _balances[legs[i].account] += legs[i].amount;
+            }
+        }
+        return status;
+    }
+
+    std::size_t ledger::post(const journal_batch& batch, std::vector<posting_status>* statuses) {
+        if (statuses != nullptr) {
+            statuses->assign(batch.size(), posting_status::posted);
+        }
+        std::vector<leg> accepted;
+        bool all_valid = true;
+        std::size_t posted = 0;
+        for (std::size_t e = 0; e < batch.size(); ++e) {
+            const leg* legs = batch.entry(e);
+            const std::size_t count = batch.entry_size(e);
+            const posting_status status = validate(legs, count);
+            if (status == posting_status::posted) {
+                ++posted;
+                if (!all_valid) {
+                    accepted.insert(accepted.end(), legs, legs + count);
+                }
+            } else {
+                if (all_valid) {
+                    // first rejected entry: keep the valid legs seen so far
+                    all_valid = false;
+                    accepted.assign(batch.entry(0), legs);
+                }
+                if (statuses != nullptr) {
+                    (*statuses)[e] = status;
+                }
+            }
+        }
+        if (all_valid) {
+            apply(batch.entry(0), batch.legs());
+        } else {
+            apply(accepted.data(), accepted.size());
+        }
+        return posted;
+    }
+
+    void ledger::restore(const leg* legs, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (legs[i].account >= _balances.size()) {
+                throw std::out_of_range("unknown account!");
+            }
+            if (_currencies[legs[i].account] != legs[i].currency) {
+                throw std::invalid_argument("incompatible currencies!");
+            }
+        }
+        apply(legs, count);
+    }
+
+    void ledger::apply(const leg* legs, std::size_t count) {
+        const std::size_t shards = std::min(_threads, count / impl::legs_per_shard_);
+        if (shards <= 1) {
+            for (std::size_t i = 0; i < count; ++i) {
+                _balances[legs[i].account] += legs[i].amount;
+            }
+            return;
+        }
+
+        // bucket the legs by account range, so every shard owns a disjoint set of accounts
+        const std::uint64_t accounts = _balances.size();
+        auto shard_of = [accounts, shards](account_id account) {
+            return static_cast<std::size_t>(account * shards / accounts);
+        };
+        std::vector<std::size_t> offsets(shards + 1, 0);
+        for (std::size_t i = 0; i < count; ++i) {
+            ++offsets[shard_of(legs[i].account) + 1];
+        }
+        for (std::size_t s = 0; s < shards; ++s) {
+            offsets[s + 1] += offsets[s];
+        }
+        std::vector<leg> sharded(count);
+        std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+        for (std::size_t i = 0; i < count; ++i) {
+            sharded[next[shard_of(legs[i].account)]++] = legs[i];
+        }
+
+        std::vector<std::thread> workers;
+        workers.reserve(shards);
+        for (std::size_t s = 0; s < shards; ++s) {
+            workers.emplace_back([this, &sharded, &offsets, s] {
+                for (std::size_t i = offsets[s]; i < offsets[s + 1]; ++i) {
+                    _balances[sharded[i].account] += sharded[i].amount;
+                }
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+}
@@ -0,0 +1,239 @@
+/**
+ * @file ledger.hpp
+ * @brief Double-entry ledger with batched posting.
+ *
+ * Accounts are identified by dense integer IDs and their balances are kept
+ * in a column indexed by ID. Journal entries are sets of legs that must
+ * balance per currency; a batch of entries is validated first and then
+ * applied by sharding the legs by account, so no posting takes a lock.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef LEDGER_HPP
+#define LEDGER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+#include "money.hpp"
+#include "money_bag.hpp"
+
+namespace mc {
+
+    /**
+     * @brief Dense identifier of a ledger account.
+     */
+    using account_id = std::uint32_t;
+
+    /**
+     * @brief One side of a journal entry: a signed amount posted to an account.
+     *
+     * Debits are positive and credits negative, so an account balance is its
+     * debits minus its credits.
+     */
+    struct leg {
+        account_id account;     ///< Account the amount is posted to
+        mc::currency currency;  ///< Currency of the amount, must match the account
+        std::int64_t amount;    ///< Amount in smallest currency units, positive for a debit
+
+        /**
+         * @brief Creates a debit leg.
+         * @param account The account to debit
+         * @param value The amount to debit
+         * @return A leg with a positive amount
+         * @throws std::overflow_error if the amount does not fit into a signed 64-bit value
+         */
+        static leg debit(account_id account, const money& value);
+
+        /**
+         * @brief Creates a credit leg.
+         * @param account The account to credit
+         * @param value The amount to credit
+         * @return A leg with a negative amount
+         * @throws std::overflow_error if the amount does not fit into a signed 64-bit value
+         */
+        static leg credit(account_id account, const money& value);
+    };
+
+    /**
+     * @brief Outcome of posting a journal entry.
+     */
+    enum class posting_status : std::uint8_t {
+        posted,            ///< The entry was applied
+        empty,             ///< The entry has no legs
+        unbalanced,        ///< Debits and credits differ in at least one currency
+        unknown_account,   ///< A leg refers to an account that was not opened
+        currency_mismatch  ///< A leg currency differs from its account currency
+    };
+
+    /**
+     * @brief A batch of journal entries with their legs stored contiguously.
+     */
+    class journal_batch {
+        std::vector<leg> _legs;         ///< Legs of all entries, in entry order
+        std::vector<std::size_t> _ends; ///< End offset of every entry in _legs
+    public:
+        /**
+         * @brief Appends a journal entry.
+         * @param legs Pointer to the first leg of the entry
+         * @param count Number of legs
+         */
+        void add(const leg* legs, std::size_t count);
+
+        /**
+         * @brief Appends a journal entry.
+         * @param legs The legs of the entry
+         */
+        void add(std::initializer_list<leg> legs);
+
+        /**
+         * @brief Gets the number of entries.
+         * @return The number of entries
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * @brief Gets the number of legs of all entries.
+         * @return The number of legs
+         */
+        std::size_t legs() const noexcept;
+
+        /**
+         * @brief Gets the first leg of an entry.
+         * @param index Index of the entry
+         * @return Pointer to the first leg
+         */
+        const leg* entry(std::size_t index) const noexcept;
+
+        /**
+         * @brief Gets the number of legs of an entry.
+         * @param index Index of the entry
+         * @return The number of legs
+         */
+        std::size_t entry_size(std::size_t index) const noexcept;
+
+        /**
+         * @brief Reserves storage for entries and legs.
+         * @param entries Expected number of entries
+         * @param legs Expected number of legs
+         */
+        void reserve(std::size_t entries, std::size_t legs);
+
+        /**
+         * @brief Removes all entries.
+         */
+        void clear() noexcept;
+    };
+
+    /**
+     * @brief Account balances updated by balanced journal entries.
+     *
+     * A ledger is not safe for concurrent posting; callers serialize batches
+     * while the ledger parallelizes the work inside a batch.
+     */
+    class ledger {
+        std::vector<std::int64_t> _balances;   ///< Balance column, indexed by account ID
+        std::vector<mc::currency> _currencies; ///< Currency column, indexed by account ID
+        money_bag _check;                      ///< Scratch bag for entry validation, always zero between calls
+        std::size_t _threads;                  ///< Maximum number of threads applying a batch
+    public:
+        /**
+         * @brief Constructs a ledger without accounts.
+         * @param threads Maximum number of threads applying a batch;
+         *                zero selects the number of hardware threads
+         */
+        explicit ledger(std::size_t threads = 0);
+
+        /**
+         * @brief Opens a new account with a zero balance.
+         * @param curr The currency of the account
+         * @return The ID of the new account
+         */
+        account_id open_account(mc::currency curr);
+
+        /**
+         * @brief Gets the number of accounts.
+         * @return The number of accounts
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * @brief Gets the currency of an account.
+         * @param account The account ID
+         * @return The currency of the account
+         * @throws std::out_of_range if the account does not exist
+         */
+        mc::currency currency(account_id account) const;
+
+        /**
+         * @brief Gets the balance of an account.
+         * @param account The account ID
+         * @return The balance in smallest currency units, debits minus credits
+         * @throws std::out_of_range if the account does not exist
+         */
+        std::int64_t balance(account_id account) const;
+
+        /**
+         * @brief Sums all account balances per currency.
+         *
+         * Since every posted entry balances, the result is zero.
+         *
+         * @return The trial balance
+         */
+        money_bag trial_balance() const;
+
+        /**
+         * @brief Checks whether a journal entry can be posted.
+         * @param legs Pointer to the first leg of the entry
+         * @param count Number of legs
+         * @return posting_status::posted if the entry is valid, the reason otherwise
+         */
+        posting_status validate(const leg* legs, std::size_t count) noexcept;
+
+        /**
+         * @brief Validates and posts a single journal entry.
+         * @param legs Pointer to the first leg of the entry
+         * @param count Number of legs
+         * @return posting_status::posted if the entry was applied, the reason otherwise
+         */
+        posting_status post(const leg* legs, std::size_t count) noexcept;
+
+        /**
+         * @brief Validates and posts a batch of journal entries.
+         *
+         * Invalid entries are skipped. Valid legs are sharded by account
+         * across threads for large batches and applied without locks.
+         *
+         * @param batch The journal entries
+         * @param statuses If not null, receives one status per entry
+         * @return The number of entries posted
+         */
+        std::size_t post(const journal_batch& batch, std::vector<posting_status>* statuses = nullptr);
+
+        /**
+         * @brief Applies legs without checking that they balance.
+         *
+         * Used to rebuild balances from legs that were validated when they
+         * were first posted, e.g. when replaying a journal.
+         *
+         * @param legs Pointer to the first leg
+         * @param count Number of legs
+         * @throws std::out_of_range if a leg refers to an account that is not open
+         * @throws std::invalid_argument if a leg currency differs from its account currency
+         */
+        void restore(const leg* legs, std::size_t count);
+
+    private:
+        friend class balance_snapshot;
+        friend class transfer_executor;
+        friend std::size_t replay_journal(const std::vector<std::string>& segments, ledger& book, std::size_t threads);
+
+        void apply(const leg* legs, std::size_t count);
+    };
+}
+
+#endif /* LEDGER_HPP */
@@ -0,0 +1,108 @@
+#include "mapped_file.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mc {
+
+#if defined(_WIN32)
+
+    mapped_file::mapped_file(const std::string& path) :
+    _data(nullptr), _size(0) {
+        std::ifstream fin(path, std::ios::binary | std::ios::ate);
+        if (!fin) {
+            throw std::runtime_error("cannot open file: " + path);
+        }
+        _buffer.resize(static_cast<std::size_t>(fin.tellg()));
+        fin.seekg(0);
+        fin.read(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+        _data = _buffer.data();
+        _size = _buffer.size();
+    }
+
+    void mapped_file::release() noexcept {
+        _buffer.clear();
+        _data = nullptr;
+        _size = 0;
+    }
+
+#else
+
+    mapped_file::mapped_file(const std::string& path) :
+    _data(nullptr), _size(0) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("cannot open file: " + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot stat file: " + path);
+        }
+        _size = static_cast<std::size_t>(st.st_size);
+        if (_size > 0) {
+            void* addr = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("cannot map file: " + path);
+            }
+            ::madvise(addr, _size, MADV_SEQUENTIAL);
+            _data = static_cast<const char*>(addr);
+        }
+        ::close(fd);
+    }
+
+    void mapped_file::release() noexcept {
+        if (_data != nullptr && _buffer.empty()) {
+            ::munmap(const_cast<char*>(_data), _size);
+        }
+        _buffer.clear();
+        _data = nullptr;
+        _size = 0;
+    }
+
+#endif
+
+    mapped_file::mapped_file(mapped_file&& other) noexcept :
+    _data(other._data), _size(other._size), _buffer(std::move(other._buffer)) {
+        other._data = nullptr;
+        other._size = 0;
+    }
+
+    mapped_file& mapped_file::operator=(mapped_file&& other) noexcept {
+        if (this != &other) {
+            release();
+            _data = other._data;
+            _size = other._size;
+            _buffer = std::move(other._buffer);
+            other._data = nullptr;
+            other._size = 0;
+        }
+        return *this;
+    }
+
+    mapped_file::~mapped_file() {
+        release();
+    }
+
+    const char* mapped_file::data() const noexcept {
+        return _data;
+    }
+
+    std::size_t mapped_file::size() const noexcept {
+        return _size;
+    }
+
+    std::string_view mapped_file::view() const noexcept {
+        return std::string_view(_data, _size);
+    }
+}
@@ -0,0 +1,85 @@
+/**
+ * @file mapped_file.hpp
+ * @brief Read-only memory-mapped file used by the library's file loaders.
+ *
+ * On POSIX systems the file is mapped with mmap(), so loaders parse the page
+ * cache directly without copying the file through a stream. On other
+ * platforms the file contents are read into an owned buffer instead.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mc {
+
+    /**
+     * @brief A read-only view of a whole file kept in memory.
+     *
+     * The view stays valid for the lifetime of the object. The class is
+     * movable but not copyable.
+     */
+    class mapped_file {
+        const char* _data;        ///< Start of the file contents
+        std::size_t _size;        ///< Size of the file contents in bytes
+        std::vector<char> _buffer; ///< Owned copy when memory mapping is unavailable
+    public:
+        /**
+         * @brief Maps the file at the given path.
+         * @param path Path to the file
+         * @throws std::runtime_error if the file cannot be opened or mapped
+         */
+        explicit mapped_file(const std::string& path);
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        /**
+         * @brief Move constructor, the source is left empty.
+         * @param other The mapped file to move from
+         */
+        mapped_file(mapped_file&& other) noexcept;
+
+        /**
+         * @brief Move assignment, the source is left empty.
+         * @param other The mapped file to move from
+         * @return Reference to this mapped file
+         */
+        mapped_file& operator=(mapped_file&& other) noexcept;
+
+        /**
+         * @brief Unmaps the file.
+         */
+        ~mapped_file();
+
+        /**
+         * @brief Gets the start of the file contents.
+         * @return Pointer to the first byte, may be null for an empty file
+         */
+        const char* data() const noexcept;
+
+        /**
+         * @brief Gets the size of the file contents.
+         * @return Size in bytes
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * @brief Gets the file contents as a string view.
+         * @return View over the whole file
+         */
+        std::string_view view() const noexcept;
+
+    private:
+        void release() noexcept;
+    };
+}
+
+#endif /* MAPPED_FILE_HPP */
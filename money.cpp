@@ -1,5 +1,8 @@
+#include <algorithm>
+#include <ostream>
 #include <sstream>
 #include "money.hpp"
+#include "money_format.hpp"
 
 namespace mc {
 
@@ -17,6 +20,12 @@ namespace mc {
         _amount = (uint64_t) (sum * 100);
     }
 
+    money money::from_amount(mc::currency c, std::uint64_t amount) {
+        money tmp(c);
+        tmp._amount = amount;
+        return tmp;
+    }
+
     const uint64_t money::integral() const {
         return _amount / 100;
     }
@@ -97,8 +106,33 @@ namespace mc {
         return strout.str();
     }
 
-    bool operator==(const money& m1, const money& m2) {
-        return m1.equal(m2);
+    namespace impl {
+        void write_fill_(std::ostream& os, std::streamsize count) {
+            char fill[32];
+            std::fill_n(fill, sizeof (fill), os.fill());
+            while (count > 0) {
+                const std::streamsize chunk = std::min<std::streamsize>(count, sizeof (fill));
+                os.write(fill, chunk);
+                count -= chunk;
+            }
+        }
+    }
+
+    std::ostream& operator<<(std::ostream& os, const money& m) {
+        char buffer[max_money_size];
+        const std::streamsize length = format_to(buffer, m) - buffer;
+        const std::streamsize width = os.width();
+        if (width <= length) {
+            os.write(buffer, length);
+        } else if ((os.flags() & std::ios_base::adjustfield) == std::ios_base::left) {
+            os.write(buffer, length);
+            impl::write_fill_(os, width - length);
+        } else {
+            impl::write_fill_(os, width - length);
+            os.write(buffer, length);
+        }
+        os.width(0);
+        return os;
     }
 
     money operator+(const money& m1, const money& m2) {
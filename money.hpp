@@ -22,8 +22,14 @@
 #define MONEY_HPP
 
 #include <cstdint>
+#include <iosfwd>
 #include "currency.hpp"
 
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#include <compare>
+#define MC_HAS_THREE_WAY_COMPARISON 1
+#endif
+
 namespace mc {
 
     /**
@@ -56,6 +62,17 @@ namespace mc {
          * @param amount The monetary amount (will be converted to smallest units)
          */
         money(mc::currency curr, double amount);
+
+        /**
+         * @brief Creates a money object from an amount in the smallest currency units.
+         * 
+         * Unlike the constructor taking a double, the amount is stored exactly.
+         * 
+         * @param curr The currency type for this monetary value
+         * @param amount The amount in smallest currency units (e.g., cents for USD)
+         * @return A money object holding exactly the given amount
+         */
+        static money from_amount(mc::currency curr, std::uint64_t amount);
         
         /**
          * @brief Virtual destructor (default implementation).
@@ -140,6 +157,65 @@ namespace mc {
          */
         bool equal(const money& other) const;
 
+        /**
+         * @brief Compares with another money object.
+         * 
+         * Values are ordered by currency, in the order of the currency
+         * enumeration with registered units last, and then by amount. The
+         * comparison is inline and reads the members directly, so sorting
+         * and searching need no custom comparator.
+         * 
+         * @param other The money object to compare with
+         * @return A negative value, zero or a positive value if this object
+         * is less than, equal to or greater than the other
+         */
+        int compare(const money& other) const noexcept {
+            if (_currency != other._currency) {
+                return static_cast<int>(_currency) < static_cast<int>(other._currency) ? -1 : 1;
+            }
+            return _amount < other._amount ? -1 : _amount != other._amount;
+        }
+
+        /**
+         * @brief Equality operator for money objects.
+         * 
+         * Objects are equal if they have the same currency and amount.
+         * 
+         * @param lhs Left-hand side money object
+         * @param rhs Right-hand side money object
+         * @return true if objects are equal, false otherwise
+         */
+        friend bool operator==(const money& lhs, const money& rhs) noexcept {
+            return lhs.compare(rhs) == 0;
+        }
+
+        friend bool operator!=(const money& lhs, const money& rhs) noexcept {
+            return lhs.compare(rhs) != 0;
+        }
+
+        /// Ordering by currency, then by amount
+        friend bool operator<(const money& lhs, const money& rhs) noexcept {
+            return lhs.compare(rhs) < 0;
+        }
+
+        friend bool operator<=(const money& lhs, const money& rhs) noexcept {
+            return lhs.compare(rhs) <= 0;
+        }
+
+        friend bool operator>(const money& lhs, const money& rhs) noexcept {
+            return lhs.compare(rhs) > 0;
+        }
+
+        friend bool operator>=(const money& lhs, const money& rhs) noexcept {
+            return lhs.compare(rhs) >= 0;
+        }
+
+#if defined(MC_HAS_THREE_WAY_COMPARISON)
+        friend std::strong_ordering operator<=>(const money& lhs, const money& rhs) noexcept {
+            return lhs.compare(rhs) <=> 0;
+        }
+#endif
+
         /**
          * @brief Converts this money object to a different currency.
          * 
@@ -224,18 +300,6 @@ namespace mc {
         std::string to_string() const;
     };
     
-    /**
-     * @brief Equality operator for money objects.
-     * 
-     * Compares two money objects for equality. Objects are equal if they
-     * have the same currency and amount.
-     * 
-     * @param lhs Left-hand side money object
-     * @param rhs Right-hand side money object
-     * @return true if objects are equal, false otherwise
-     */
-    bool operator==(const money& lhs, const money& rhs);
-
     /**
      * @brief Addition operator for two money objects.
      * 
@@ -319,6 +383,22 @@ namespace mc {
      */
     money operator/(const money& money_obj, const double& divisor);
 
+    /**
+     * @brief Stream output operator for money objects.
+     * 
+     * Writes the value as "integral,part CODE" with a two-digit part, e.g.
+     * "123,45 USD". The value is formatted into a stack buffer and written
+     * with a single write call, so no string or string stream is created.
+     * The stream width and fill are honoured: std::left pads on the right,
+     * any other adjustment on the left, and the width is reset afterwards
+     * as for built-in types.
+     * 
+     * @param os The output stream
+     * @param value The money object to write
+     * @return The output stream
+     */
+    std::ostream& operator<<(std::ostream& os, const money& value);
+
     /// User-defined literals for currency creation
     /// These operators allow creation of money objects using syntax like: 100.50_USD, 75.25_EUR, etc.
     /// Each operator creates a money object with the specified amount and corresponding currency.
@@ -0,0 +1,92 @@
+#include "money_bag.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+namespace mc {
+
+    namespace impl {
+        bool checked_add_(std::int64_t a, std::int64_t b, std::int64_t& sum) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return !__builtin_add_overflow(a, b, &sum);
+#else
+            if ((b > 0 && a > std::numeric_limits<std::int64_t>::max() - b)
+                    || (b < 0 && a < std::numeric_limits<std::int64_t>::min() - b)) {
+                return false;
+            }
+            sum = a + b;
+            return true;
+#endif
+        }
+
+        std::int64_t signed_amount_(const money& m) {
+            if (m.amount() > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+                throw std::overflow_error("amount does not fit into money_bag");
+            }
+            return static_cast<std::int64_t>(m.amount());
+        }
+    }
+
+    money_bag::money_bag() noexcept : _nonzero(0) {
+        _amounts.fill(0);
+    }
+
+    bool money_bag::try_add(mc::currency c, std::int64_t amount) noexcept {
+        std::int64_t& total = _amounts[static_cast<std::size_t>(c)];
+        std::int64_t sum;
+        if (!impl::checked_add_(total, amount, sum)) {
+            return false;
+        }
+        const bool was_zero = total == 0;
+        total = sum;
+        const bool is_zero = total == 0;
+        _nonzero += static_cast<std::size_t>(was_zero) - static_cast<std::size_t>(is_zero);
+        return true;
+    }
+
+    void money_bag::add(mc::currency c, std::int64_t amount) {
+        if (!try_add(c, amount)) {
+            throw std::overflow_error("money_bag total overflow");
+        }
+    }
+
+    void money_bag::add(const money& m) {
+        add(m.currency(), impl::signed_amount_(m));
+    }
+
+    void money_bag::subtract(const money& m) {
+        add(m.currency(), -impl::signed_amount_(m));
+    }
+
+    void money_bag::operator+=(const money_bag& other) {
+        const std::size_t n = known_currency_count();
+        std::int64_t sum;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!impl::checked_add_(_amounts[i], other._amounts[i], sum)) {
+                throw std::overflow_error("money_bag total overflow");
+            }
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            if (other._amounts[i] != 0) {
+                try_add(static_cast<mc::currency>(i), other._amounts[i]);
+            }
+        }
+    }
+
+    std::int64_t money_bag::amount(mc::currency c) const noexcept {
+        return _amounts[static_cast<std::size_t>(c)];
+    }
+
+    bool money_bag::is_zero() const noexcept {
+        return _nonzero == 0;
+    }
+
+    std::size_t money_bag::size() const noexcept {
+        return _nonzero;
+    }
+
+    void money_bag::clear() noexcept {
+        _amounts.fill(0);
+        _nonzero = 0;
+    }
+}
@@ -0,0 +1,110 @@
+/**
+ * @file money_bag.hpp
+ * @brief Multi-currency accumulator of signed monetary amounts.
+ *
+ * A money bag holds one signed total per currency, so amounts in different
+ * currencies can be summed without conversion. It is typically used to check
+ * that a set of movements balances: the bag is zero when, for every
+ * currency, the additions equal the subtractions.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef MONEY_BAG_HPP
+#define MONEY_BAG_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "money.hpp"
+
+namespace mc {
+
+    namespace impl {
+        /// Sum of two signed amounts, false if it does not fit
+        bool checked_add_(std::int64_t a, std::int64_t b, std::int64_t& sum) noexcept;
+    }
+
+    /**
+     * @brief Signed totals of smallest currency units, one per currency.
+     *
+     * The bag tracks how many totals are non-zero, so is_zero() is O(1) and a
+     * balanced bag needs no clearing before reuse.
+     */
+    class money_bag {
+        std::array<std::int64_t, max_currency_count> _amounts; ///< Total per currency, registered units included
+        std::size_t _nonzero;                              ///< Number of non-zero totals
+    public:
+        /**
+         * @brief Constructs an empty bag.
+         */
+        money_bag() noexcept;
+
+        /**
+         * @brief Adds a signed amount to a currency total unless the total overflows.
+         * @param curr The currency of the amount
+         * @param amount The amount in smallest currency units, negative to subtract
+         * @return true if the amount was added, false if the total would overflow
+         */
+        bool try_add(mc::currency curr, std::int64_t amount) noexcept;
+
+        /**
+         * @brief Adds a signed amount to a currency total.
+         * @param curr The currency of the amount
+         * @param amount The amount in smallest currency units, negative to subtract
+         * @throws std::overflow_error if the total does not fit into a signed 64-bit value
+         */
+        void add(mc::currency curr, std::int64_t amount);
+
+        /**
+         * @brief Adds a money object to its currency total.
+         * @param value The amount to add
+         * @throws std::overflow_error if the amount or the total does not fit into a signed 64-bit value
+         */
+        void add(const money& value);
+
+        /**
+         * @brief Subtracts a money object from its currency total.
+         * @param value The amount to subtract
+         * @throws std::overflow_error if the amount or the total does not fit into a signed 64-bit value
+         */
+        void subtract(const money& value);
+
+        /**
+         * @brief Adds all totals of another bag.
+         *
+         * The bag is left unchanged if any total would overflow.
+         *
+         * @param other The bag to add
+         * @throws std::overflow_error if a total does not fit into a signed 64-bit value
+         */
+        void operator+=(const money_bag& other);
+
+        /**
+         * @brief Gets the total of a currency.
+         * @param curr The currency of the total
+         * @return The total in smallest currency units
+         */
+        std::int64_t amount(mc::currency curr) const noexcept;
+
+        /**
+         * @brief Checks whether every currency total is zero.
+         * @return true if the bag is balanced, false otherwise
+         */
+        bool is_zero() const noexcept;
+
+        /**
+         * @brief Gets the number of currencies with a non-zero total.
+         * @return The number of non-zero totals
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * @brief Resets every total to zero.
+         */
+        void clear() noexcept;
+    };
+}
+
+#endif /* MONEY_BAG_HPP */
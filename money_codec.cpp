@@ -0,0 +1,186 @@
+#include "money_codec.hpp"
+
+#include <stdexcept>
+
+namespace mc {
+
+    namespace impl {
+        /// Maps signed values to unsigned ones, small magnitudes to small values
+        constexpr std::uint64_t zigzag_(std::int64_t value) noexcept {
+            return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+        }
+
+        constexpr std::int64_t unzigzag_(std::uint64_t value) noexcept {
+            return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+        }
+
+        /// Zigzag amount shifted left by one, the low bit set when it was divided by 100
+        constexpr std::uint64_t tag_amount_(std::int64_t amount, bool scale) noexcept {
+            return scale && amount != 0 && amount % 100 == 0
+                    ? (zigzag_(amount / 100) << 1) | 1
+                    : zigzag_(amount) << 1;
+        }
+
+        std::size_t put_varint_(std::uint64_t value, std::uint8_t* out) noexcept {
+            std::size_t n = 0;
+            while (value >= 0x80) {
+                out[n++] = static_cast<std::uint8_t>(value | 0x80);
+                value >>= 7;
+            }
+            out[n++] = static_cast<std::uint8_t>(value);
+            return n;
+        }
+
+        /// Reads a varint of at most 9 bytes, returns the bytes read or 0 if malformed
+        std::size_t get_varint_(const std::uint8_t* data, std::size_t size, std::uint64_t& value) noexcept {
+            value = 0;
+            const std::size_t limit = size < 9 ? size : 9;
+            for (std::size_t n = 0; n < limit; ++n) {
+                value |= static_cast<std::uint64_t>(data[n] & 0x7F) << (7 * n);
+                if ((data[n] & 0x80) == 0) {
+                    return n + 1;
+                }
+            }
+            return 0;
+        }
+
+        /// Rebuilds a value from its currency byte and tagged amount
+        bool untag_(std::uint8_t curr, std::uint64_t tagged, packed_money& value) noexcept {
+            std::int64_t amount = unzigzag_(tagged >> 1);
+            if (tagged & 1) {
+                if (amount > packed_money::max_amount / 100 || amount < packed_money::min_amount / 100) {
+                    return false;
+                }
+                amount *= 100;
+            }
+            if (curr >= known_currency_count() || amount > packed_money::max_amount || amount < packed_money::min_amount) {
+                return false;
+            }
+            value = packed_money::from_bits((static_cast<std::uint64_t>(amount) << 8) | curr);
+            return true;
+        }
+
+        [[noreturn]] void malformed_() {
+            throw std::invalid_argument("malformed money encoding");
+        }
+
+        /// Decodes the groups of an array, passing every value from index first on to sink
+        template<typename Sink>
+        std::size_t decode_groups_(const std::uint8_t* data, std::size_t size, std::size_t first, Sink sink) {
+            std::size_t pos = 0;
+            std::size_t index = 0;
+            std::size_t decoded = 0;
+            while (pos < size) {
+                const std::size_t count = data[pos++];
+                std::uint64_t length = 0;
+                const std::size_t n = get_varint_(data + pos, size - pos, length);
+                if (count == 0 || count > encoded_group_size || n == 0 || length > size - pos - n || length < 2 * count) {
+                    malformed_();
+                }
+                pos += n;
+                const std::uint8_t* currencies = data + pos;
+                const std::uint8_t* amounts = currencies + count;
+                const std::size_t amount_bytes = static_cast<std::size_t>(length) - count;
+                pos += static_cast<std::size_t>(length);
+                if (index + count <= first) {
+                    index += count;
+                    continue;
+                }
+
+                const std::size_t skip = first > index ? first - index : 0;
+                packed_money value;
+                if (amount_bytes == count) {
+                    // every amount fits into one byte, no continuation bits to follow
+                    for (std::size_t j = 0; j < count; ++j) {
+                        if ((amounts[j] & 0x80) != 0 || !untag_(currencies[j], amounts[j], value)) {
+                            malformed_();
+                        }
+                        if (j >= skip) {
+                            sink(value);
+                        }
+                    }
+                } else {
+                    std::size_t offset = 0;
+                    for (std::size_t j = 0; j < count; ++j) {
+                        std::uint64_t tagged = 0;
+                        const std::size_t read = get_varint_(amounts + offset, amount_bytes - offset, tagged);
+                        if (read == 0 || !untag_(currencies[j], tagged, value)) {
+                            malformed_();
+                        }
+                        offset += read;
+                        if (j >= skip) {
+                            sink(value);
+                        }
+                    }
+                    if (offset != amount_bytes) {
+                        malformed_();
+                    }
+                }
+                decoded += count - skip;
+                index += count;
+            }
+            return decoded;
+        }
+    }
+
+    std::size_t encode(const packed_money& value, std::uint8_t* out, bool scale) noexcept {
+        out[0] = static_cast<std::uint8_t>(value.currency());
+        return 1 + impl::put_varint_(impl::tag_amount_(value.amount(), scale), out + 1);
+    }
+
+    std::size_t encode(const money& value, std::uint8_t* out, bool scale) {
+        return encode(packed_money(value), out, scale);
+    }
+
+    std::size_t decode(const std::uint8_t* data, std::size_t size, packed_money& value) noexcept {
+        if (size < 2) {
+            return 0;
+        }
+        std::uint64_t tagged = 0;
+        const std::size_t n = impl::get_varint_(data + 1, size - 1, tagged);
+        if (n == 0 || !impl::untag_(data[0], tagged, value)) {
+            return 0;
+        }
+        return 1 + n;
+    }
+
+    void encode(const packed_money* values, std::size_t count, std::vector<std::uint8_t>& out, bool scale) {
+        std::uint8_t amounts[encoded_group_size * 9];
+        for (std::size_t begin = 0; begin < count; begin += encoded_group_size) {
+            const std::size_t group = count - begin < encoded_group_size ? count - begin : encoded_group_size;
+            std::size_t amount_bytes = 0;
+            for (std::size_t j = 0; j < group; ++j) {
+                amount_bytes += impl::put_varint_(impl::tag_amount_(values[begin + j].amount(), scale), amounts + amount_bytes);
+            }
+            std::uint8_t header[1 + 9];
+            header[0] = static_cast<std::uint8_t>(group);
+            const std::size_t header_size = 1 + impl::put_varint_(group + amount_bytes, header + 1);
+            out.insert(out.end(), header, header + header_size);
+            for (std::size_t j = 0; j < group; ++j) {
+                out.push_back(static_cast<std::uint8_t>(values[begin + j].currency()));
+            }
+            out.insert(out.end(), amounts, amounts + amount_bytes);
+        }
+    }
+
+    void encode(const money* values, std::size_t count, std::vector<std::uint8_t>& out, bool scale) {
+        packed_money packed[encoded_group_size];
+        for (std::size_t begin = 0; begin < count; begin += encoded_group_size) {
+            const std::size_t group = count - begin < encoded_group_size ? count - begin : encoded_group_size;
+            pack(values + begin, group, packed);
+            encode(packed, group, out, scale);
+        }
+    }
+
+    std::size_t decode(const std::uint8_t* data, std::size_t size, std::vector<packed_money>& out, std::size_t first) {
+        return impl::decode_groups_(data, size, first, [&out](const packed_money& value) {
+            out.push_back(value);
+        });
+    }
+
+    std::size_t decode(const std::uint8_t* data, std::size_t size, std::vector<money>& out, std::size_t first) {
+        return impl::decode_groups_(data, size, first, [&out](const packed_money& value) {
+            out.push_back(value.to_money());
+        });
+    }
+}
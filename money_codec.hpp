@@ -0,0 +1,108 @@
+/**
+ * @file money_codec.hpp
+ * @brief Compact binary encoding of monetary values.
+ *
+ * A value is encoded as its currency index in one byte followed by its
+ * amount as a zigzag varint. The lowest bit of the varint tells whether the
+ * amount was divided by 100, so whole-unit amounts (e.g. 1500.00) take a
+ * byte less. Arrays are encoded in groups of up to 16 values whose header
+ * holds the group's byte length, so a decoder can skip whole groups, and
+ * whose currency bytes are stored together ahead of the amounts.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef MONEY_CODEC_HPP
+#define MONEY_CODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "money.hpp"
+#include "packed_money.hpp"
+
+namespace mc {
+
+    /// Largest number of bytes one encoded value takes
+    constexpr std::size_t max_encoded_size = 10;
+
+    /// Number of values per group of an encoded array
+    constexpr std::size_t encoded_group_size = 16;
+
+    /**
+     * @brief Encodes a packed value.
+     * @param value The value to encode
+     * @param out Receives the encoding, must hold max_encoded_size bytes
+     * @param scale Whether whole-unit amounts are stored divided by 100
+     * @return The number of bytes written
+     */
+    std::size_t encode(const packed_money& value, std::uint8_t* out, bool scale = true) noexcept;
+
+    /**
+     * @brief Encodes a money object.
+     * @param value The value to encode
+     * @param out Receives the encoding, must hold max_encoded_size bytes
+     * @param scale Whether whole-unit amounts are stored divided by 100
+     * @return The number of bytes written
+     * @throws std::overflow_error if the amount does not fit into packed money
+     */
+    std::size_t encode(const money& value, std::uint8_t* out, bool scale = true);
+
+    /**
+     * @brief Decodes one value.
+     * @param data Pointer to the encoding
+     * @param size Number of bytes available
+     * @param value Receives the decoded value
+     * @return The number of bytes read, or 0 if the encoding is malformed or truncated
+     */
+    std::size_t decode(const std::uint8_t* data, std::size_t size, packed_money& value) noexcept;
+
+    /**
+     * @brief Encodes an array of values in groups.
+     * @param values Pointer to the first value
+     * @param count Number of values
+     * @param out Receives the encoding, appended to its current contents
+     * @param scale Whether whole-unit amounts are stored divided by 100
+     */
+    void encode(const packed_money* values, std::size_t count, std::vector<std::uint8_t>& out, bool scale = true);
+
+    /**
+     * @brief Encodes an array of money objects in groups.
+     * @param values Pointer to the first value
+     * @param count Number of values
+     * @param out Receives the encoding, appended to its current contents
+     * @param scale Whether whole-unit amounts are stored divided by 100
+     * @throws std::overflow_error if an amount does not fit into packed money
+     */
+    void encode(const money* values, std::size_t count, std::vector<std::uint8_t>& out, bool scale = true);
+
+    /**
+     * @brief Decodes an array of values.
+     *
+     * Groups that end before the first requested value are skipped using
+     * their byte length, without decoding them.
+     *
+     * @param data Pointer to the encoding
+     * @param size Number of bytes of the encoding
+     * @param out Receives the decoded values, appended to its current contents
+     * @param first Index of the first value to decode
+     * @return The number of values decoded
+     * @throws std::invalid_argument if the encoding is malformed or truncated
+     */
+    std::size_t decode(const std::uint8_t* data, std::size_t size, std::vector<packed_money>& out, std::size_t first = 0);
+
+    /**
+     * @brief Decodes an array of money objects.
+     * @param data Pointer to the encoding
+     * @param size Number of bytes of the encoding
+     * @param out Receives the decoded values, appended to its current contents
+     * @param first Index of the first value to decode
+     * @return The number of values decoded
+     * @throws std::invalid_argument if the encoding is malformed or truncated
+     * @throws std::logic_error if an amount is negative
+     */
+    std::size_t decode(const std::uint8_t* data, std::size_t size, std::vector<money>& out, std::size_t first = 0);
+}
+
+#endif /* MONEY_CODEC_HPP */
@@ -0,0 +1,82 @@
+#include "money_column.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+namespace mc {
+
+    void money_column::push_back(mc::currency c, std::int64_t amount) {
+        _amounts.push_back(amount);
+        _currencies.push_back(static_cast<std::uint8_t>(c));
+    }
+
+    void money_column::push_back(const money& m) {
+        if (m.amount() > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+            throw std::overflow_error("amount does not fit into money_column");
+        }
+        push_back(m.currency(), static_cast<std::int64_t>(m.amount()));
+    }
+
+    std::size_t money_column::size() const noexcept {
+        return _amounts.size();
+    }
+
+    bool money_column::empty() const noexcept {
+        return _amounts.empty();
+    }
+
+    void money_column::reserve(std::size_t count) {
+        _amounts.reserve(count);
+        _currencies.reserve(count);
+    }
+
+    void money_column::resize(std::size_t count) {
+        _amounts.resize(count);
+        _currencies.resize(count);
+    }
+
+    void money_column::clear() noexcept {
+        _amounts.clear();
+        _currencies.clear();
+    }
+
+    const std::int64_t* money_column::amounts() const noexcept {
+        return _amounts.data();
+    }
+
+    std::int64_t* money_column::amounts() noexcept {
+        return _amounts.data();
+    }
+
+    const std::uint8_t* money_column::currencies() const noexcept {
+        return _currencies.data();
+    }
+
+    std::uint8_t* money_column::currencies() noexcept {
+        return _currencies.data();
+    }
+
+    std::int64_t money_column::amount(std::size_t index) const noexcept {
+        return _amounts[index];
+    }
+
+    mc::currency money_column::currency(std::size_t index) const noexcept {
+        return static_cast<mc::currency>(_currencies[index]);
+    }
+
+    money money_column::at(std::size_t index) const {
+        const std::int64_t value = _amounts.at(index);
+        if (value < 0) {
+            throw std::logic_error("negative balance!");
+        }
+        return money::from_amount(currency(index), static_cast<std::uint64_t>(value));
+    }
+
+    bool money_column::operator==(const money_column& other) const noexcept {
+        return _amounts == other._amounts && _currencies == other._currencies;
+    }
+
+    bool money_column::operator!=(const money_column& other) const noexcept {
+        return !(*this == other);
+    }
+}
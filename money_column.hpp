@@ -0,0 +1,136 @@
+/**
+ * @file money_column.hpp
+ * @brief Column-oriented storage of many monetary values.
+ *
+ * A money column keeps the amounts and the currencies of its values in two
+ * separate contiguous arrays, so scans, filters and file formats work on
+ * plain integer arrays instead of arrays of money objects.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef MONEY_COLUMN_HPP
+#define MONEY_COLUMN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "money.hpp"
+
+namespace mc {
+
+    /**
+     * @brief Signed amounts and their currencies stored as two arrays.
+     */
+    class money_column {
+        std::vector<std::int64_t> _amounts;    ///< Amounts in smallest currency units
+        std::vector<std::uint8_t> _currencies; ///< Currency index of every amount
+    public:
+        /**
+         * @brief Appends a value.
+         * @param curr The currency
+         * @param amount The amount in smallest currency units
+         */
+        void push_back(mc::currency curr, std::int64_t amount);
+
+        /**
+         * @brief Appends a money object.
+         * @param value The value to append
+         * @throws std::overflow_error if the amount does not fit into a signed 64-bit value
+         */
+        void push_back(const money& value);
+
+        /**
+         * @brief Gets the number of values.
+         * @return The number of values
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * @brief Checks whether the column has no values.
+         * @return true if the column is empty, false otherwise
+         */
+        bool empty() const noexcept;
+
+        /**
+         * @brief Reserves storage for values.
+         * @param count Expected number of values
+         */
+        void reserve(std::size_t count);
+
+        /**
+         * @brief Resizes the column, new values are zero amounts of the first currency.
+         * @param count The new number of values
+         */
+        void resize(std::size_t count);
+
+        /**
+         * @brief Removes all values.
+         */
+        void clear() noexcept;
+
+        /**
+         * @brief Gets the amount array.
+         * @return Pointer to the first amount
+         */
+        const std::int64_t* amounts() const noexcept;
+
+        /**
+         * @brief Gets the amount array for writing.
+         * @return Pointer to the first amount
+         */
+        std::int64_t* amounts() noexcept;
+
+        /**
+         * @brief Gets the currency index array.
+         * @return Pointer to the currency index of the first value
+         */
+        const std::uint8_t* currencies() const noexcept;
+
+        /**
+         * @brief Gets the currency index array for writing.
+         * @return Pointer to the currency index of the first value
+         */
+        std::uint8_t* currencies() noexcept;
+
+        /**
+         * @brief Gets the amount of a value.
+         * @param index Index of the value
+         * @return The amount in smallest currency units
+         */
+        std::int64_t amount(std::size_t index) const noexcept;
+
+        /**
+         * @brief Gets the currency of a value.
+         * @param index Index of the value
+         * @return The currency
+         */
+        mc::currency currency(std::size_t index) const noexcept;
+
+        /**
+         * @brief Gets a value as a money object.
+         * @param index Index of the value
+         * @return The money object
+         * @throws std::out_of_range if the index is out of range
+         * @throws std::logic_error if the amount is negative
+         */
+        money at(std::size_t index) const;
+
+        /**
+         * @brief Checks whether two columns hold the same values.
+         * @param other The column to compare with
+         * @return true if the columns are equal, false otherwise
+         */
+        bool operator==(const money_column& other) const noexcept;
+
+        /**
+         * @brief Checks whether two columns differ.
+         * @param other The column to compare with
+         * @return true if the columns differ, false otherwise
+         */
+        bool operator!=(const money_column& other) const noexcept;
+    };
+}
+
+#endif /* MONEY_COLUMN_HPP */
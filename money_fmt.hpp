@@ -0,0 +1,208 @@
+/**
+ * @file money_fmt.hpp
+ * @brief Formatting of monetary values with std::format and the {fmt} library.
+ *
+ * Including this header specializes std::formatter for money when the
+ * standard library provides std::format, and fmt::formatter when
+ * <fmt/format.h> is available and MC_NO_FMT is not defined. Both write the
+ * digits from a stack buffer straight into the output iterator, so
+ * formatting a value never creates a temporary string.
+ *
+ * The format spec is [[fill]align][width][.precision][type]:
+ * - type 'c' (the default) writes the ISO code, 's' the currency symbol;
+ * - precision 0 rounds half up to whole units, 2 (the default) keeps the
+ *   minor units;
+ * - align is '<', '>' (the default) or '^', fill is a single ASCII character.
+ *
+ * For example "{}" gives "1234,50 USD", "{:s}" gives "1234,50 $", "{:.0}"
+ * gives "1235 USD" for 1234,50 and "{:*>12}" gives "*1234,50 USD". Specs are checked
+ * when the format string is, at compile time where the library does so.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef MONEY_FMT_HPP
+#define MONEY_FMT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "currency.hpp"
+#include "currency_info.hpp"
+#include "money.hpp"
+#include "money_format.hpp"
+
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#include <version>
+#endif
+
+namespace mc {
+
+    /**
+     * @brief Parsed format spec of a money value.
+     */
+    struct money_spec {
+        char fill = ' ';          ///< Character used for padding
+        char align = '>';         ///< '<', '>' or '^'
+        std::size_t width = 0;    ///< Smallest number of characters
+        bool minor_units = true;  ///< Whether the part after the decimal point is written
+        bool symbol = false;      ///< Whether the symbol is written instead of the ISO code
+    };
+
+    /**
+     * @brief Parses a format spec.
+     * @param begin Start of the spec, after the colon
+     * @param end End of the format string
+     * @param spec Receives the parsed spec
+     * @param valid Set to false if the spec is malformed
+     * @return Iterator to the closing brace or to end
+     */
+    template <class It>
+    constexpr It parse_money_spec(It begin, It end, money_spec& spec, bool& valid) noexcept {
+        valid = true;
+        const auto is_align = [](char c) {
+            return c == '<' || c == '>' || c == '^';
+        };
+        It p = begin;
+        if (p != end && *p != '}') {
+            It next = p;
+            ++next;
+            if (next != end && is_align(*next)) {
+                if (*p == '{' || *p == '}' || static_cast<unsigned char>(*p) >= 0x80) {
+                    valid = false;
+                    return p;
+                }
+                spec.fill = *p;
+                spec.align = *next;
+                p = ++next;
+            } else if (is_align(*p)) {
+                spec.align = *p;
+                ++p;
+            }
+        }
+        while (p != end && *p >= '0' && *p <= '9') {
+            spec.width = spec.width * 10 + static_cast<std::size_t>(*p - '0');
+            if (spec.width > 255) {
+                valid = false;
+                return p;
+            }
+            ++p;
+        }
+        if (p != end && *p == '.') {
+            ++p;
+            if (p == end || (*p != '0' && *p != '2')) {
+                valid = false;
+                return p;
+            }
+            spec.minor_units = *p == '2';
+            ++p;
+        }
+        if (p != end && (*p == 'c' || *p == 's')) {
+            spec.symbol = *p == 's';
+            ++p;
+        }
+        if (p != end && *p != '}') {
+            valid = false;
+        }
+        return p;
+    }
+
+    namespace impl {
+        /// Number of UTF-8 code points, as the display width of a symbol
+        constexpr std::size_t code_points_(std::string_view text) noexcept {
+            std::size_t count = 0;
+            for (char c : text) {
+                count += (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+            }
+            return count;
+        }
+    }
+
+    /**
+     * @brief Writes a value into an output iterator by a parsed spec.
+     * @param out The output iterator
+     * @param value The value to write
+     * @param spec The spec
+     * @return The iterator past the last written character
+     */
+    template <class OutputIt>
+    OutputIt write_money(OutputIt out, const money& value, const money_spec& spec) {
+        char amount[max_amount_size];
+        const char* amount_end;
+        if (spec.minor_units) {
+            amount_end = format_amount(amount, value.amount(), ',');
+        } else {
+            // rounding up cannot overflow: the largest amount ends in 15
+            const std::uint64_t part = value.amount() % 100;
+            amount_end = format_amount(amount, value.amount() - part + (part >= 50 ? 100 : 0), ',') - 3;
+        }
+        const std::string_view unit = spec.symbol ? symbol(value.currency()) : to_code(value.currency());
+        const std::size_t length = static_cast<std::size_t>(amount_end - amount) + 1 + impl::code_points_(unit);
+        const std::size_t padding = spec.width > length ? spec.width - length : 0;
+        const std::size_t before = spec.align == '<' ? 0 : spec.align == '^' ? padding / 2 : padding;
+
+        out = std::fill_n(out, before, spec.fill);
+        out = std::copy(static_cast<const char*>(amount), amount_end, out);
+        *out++ = ' ';
+        out = std::copy(unit.begin(), unit.end(), out);
+        return std::fill_n(out, padding - before, spec.fill);
+    }
+}
+
+#if defined(__cpp_lib_format)
+#include <format>
+
+/**
+ * @brief std::format support for money values.
+ */
+template <>
+struct std::formatter<mc::money, char> {
+    mc::money_spec spec; ///< Parsed format spec
+
+    constexpr auto parse(std::format_parse_context& ctx) -> decltype(ctx.begin()) {
+        bool valid = true;
+        const auto end = mc::parse_money_spec(ctx.begin(), ctx.end(), spec, valid);
+        if (!valid) {
+            throw std::format_error("invalid format spec for money");
+        }
+        return end;
+    }
+
+    template <class FormatContext>
+    auto format(const mc::money& value, FormatContext& ctx) const -> decltype(ctx.out()) {
+        return mc::write_money(ctx.out(), value, spec);
+    }
+};
+#endif
+
+#if defined(__has_include) && !defined(MC_NO_FMT)
+#if __has_include(<fmt/format.h>)
+#include <fmt/format.h>
+
+/**
+ * @brief {fmt} support for money values.
+ */
+template <>
+struct fmt::formatter<mc::money, char> {
+    mc::money_spec spec; ///< Parsed format spec
+
+    constexpr auto parse(fmt::format_parse_context& ctx) -> decltype(ctx.begin()) {
+        bool valid = true;
+        const auto end = mc::parse_money_spec(ctx.begin(), ctx.end(), spec, valid);
+        if (!valid) {
+            throw fmt::format_error("invalid format spec for money");
+        }
+        return end;
+    }
+
+    template <class FormatContext>
+    auto format(const mc::money& value, FormatContext& ctx) const -> decltype(ctx.out()) {
+        return mc::write_money(ctx.out(), value, spec);
+    }
+};
+#endif
+#endif
+
+#endif /* MONEY_FMT_HPP */
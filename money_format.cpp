@@ -0,0 +1,130 @@
+#include "money_format.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include "currency.hpp"
+
+namespace mc {
+
+    namespace impl {
+        /// The numbers 00 to 99 as pairs of digits
+        constexpr char digit_pairs_[201] =
+                "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                "8081828384858687888990919293949596979899";
+
+        unsigned count_digits_(std::uint64_t value) noexcept {
+            unsigned digits = 1;
+            while (value >= 100) {
+                value /= 100;
+                digits += 2;
+            }
+            return digits + (value >= 10);
+        }
+
+        /// Writes value right-aligned so that its last digit is at end[-1]
+        void write_digits_(char* end, std::uint64_t value) noexcept {
+            while (value >= 100) {
+                end -= 2;
+                std::memcpy(end, digit_pairs_ + (value % 100) * 2, 2);
+                value /= 100;
+            }
+            if (value >= 10) {
+                std::memcpy(end - 2, digit_pairs_ + value * 2, 2);
+            } else {
+                end[-1] = static_cast<char>('0' + value);
+            }
+        }
+
+        /// Writes a value whose integral part has the given number of digits
+        char* write_money_(char* out, std::uint64_t amount, unsigned digits, currency curr, const format_options& options) noexcept {
+            write_digits_(out + digits, amount / 100);
+            out += digits;
+            *out = options.decimal_point;
+            std::memcpy(out + 1, digit_pairs_ + (amount % 100) * 2, 2);
+            out += 3;
+            if (options.code) {
+                const std::string_view code = to_code(curr);
+                *out = ' ';
+                std::memcpy(out + 1, code.data(), code.size());
+                out += 1 + code.size();
+            }
+            return out;
+        }
+    }
+
+    output_buffer::output_buffer(std::size_t capacity) :
+    _data(capacity > 0 ? new char[capacity] : nullptr), _size(0), _capacity(capacity) {
+    }
+
+    char* output_buffer::prepare(std::size_t count) {
+        if (_capacity - _size < count) {
+            const std::size_t capacity = std::max(_size + count, _capacity * 2);
+            std::unique_ptr<char[]> data(new char[capacity]);
+            if (_size > 0) {
+                std::memcpy(data.get(), _data.get(), _size);
+            }
+            _data = std::move(data);
+            _capacity = capacity;
+        }
+        return _data.get() + _size;
+    }
+
+    void output_buffer::commit(const char* end) noexcept {
+        _size = static_cast<std::size_t>(end - _data.get());
+    }
+
+    void output_buffer::append(std::string_view text) {
+        char* out = prepare(text.size());
+        std::memcpy(out, text.data(), text.size());
+        commit(out + text.size());
+    }
+
+    void output_buffer::clear() noexcept {
+        _size = 0;
+    }
+
+    const char* output_buffer::data() const noexcept {
+        return _data.get();
+    }
+
+    std::size_t output_buffer::size() const noexcept {
+        return _size;
+    }
+
+    std::string_view output_buffer::view() const noexcept {
+        return std::string_view(_data.get(), _size);
+    }
+
+    char* format_amount(char* out, std::uint64_t amount, char decimal_point) noexcept {
+        const std::uint64_t integral = amount / 100;
+        const unsigned digits = impl::count_digits_(integral);
+        impl::write_digits_(out + digits, integral);
+        out += digits;
+        *out++ = decimal_point;
+        std::memcpy(out, impl::digit_pairs_ + (amount % 100) * 2, 2);
+        return out + 2;
+    }
+
+    char* format_to(char* out, const money& value, const format_options& options) noexcept {
+        const std::uint64_t amount = value.amount();
+        const unsigned digits = impl::count_digits_(amount / 100);
+        const std::size_t length = digits + 3 + (options.code ? 4 : 0);
+        if (options.width > length) {
+            std::memset(out, options.fill, options.width - length);
+            out += options.width - length;
+        }
+        return impl::write_money_(out, amount, digits, value.currency(), options);
+    }
+
+    void format_column(const money* values, std::size_t count, const format_options& options, output_buffer& out) {
+        const std::size_t per_value = std::max(options.width, max_money_size) + 1;
+        char* p = out.prepare(count * per_value);
+        for (std::size_t i = 0; i < count; ++i) {
+            p = format_to(p, values[i], options);
+            *p = options.separator;
+            p += options.separator != '\0';
+        }
+        out.commit(p);
+    }
+}
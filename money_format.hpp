@@ -0,0 +1,150 @@
+/**
+ * @file money_format.hpp
+ * @brief Allocation-free formatting of monetary values.
+ *
+ * The functions write into caller-supplied character buffers and never
+ * allocate; digits are produced two at a time from a 200-byte table and
+ * currency codes are copied from a table of three-byte codes. For whole
+ * columns, format_column() writes all values into one growing buffer.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef MONEY_FORMAT_HPP
+#define MONEY_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include "money.hpp"
+
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#include <span>
+#endif
+
+namespace mc {
+
+    /// Largest number of characters format_amount() writes
+    constexpr std::size_t max_amount_size = 21;
+
+    /// Largest number of characters format_to() writes for an unpadded value
+    constexpr std::size_t max_money_size = max_amount_size + 4;
+
+    /**
+     * @brief Layout of formatted values.
+     *
+     * The defaults give the layout of money::to_string(), "123,45 USD",
+     * with the part always written with two digits.
+     */
+    struct format_options {
+        char decimal_point = ',';  ///< Character between the integral part and the part
+        bool code = true;          ///< Whether a space and the currency code follow the amount
+        std::size_t width = 0;     ///< Smallest number of characters per value, shorter values are padded on the left
+        char fill = ' ';           ///< Character used for padding
+        char separator = '\n';     ///< Character format_column() writes after every value, '\0' for none
+    };
+
+    /**
+     * @brief A growing character buffer that formatting functions append to.
+     */
+    class output_buffer {
+        std::unique_ptr<char[]> _data; ///< Characters, without a terminating zero
+        std::size_t _size;             ///< Number of characters written
+        std::size_t _capacity;         ///< Number of characters allocated
+    public:
+        /**
+         * @brief Creates an empty buffer.
+         * @param capacity Number of characters to allocate up front
+         */
+        explicit output_buffer(std::size_t capacity = 0);
+
+        /**
+         * @brief Makes room for more characters.
+         * @param count Number of characters to be written
+         * @return Pointer to write the characters to, then passed to commit()
+         */
+        char* prepare(std::size_t count);
+
+        /**
+         * @brief Appends the characters written after prepare().
+         * @param end Pointer past the last written character
+         */
+        void commit(const char* end) noexcept;
+
+        /**
+         * @brief Appends characters.
+         * @param text The characters to append
+         */
+        void append(std::string_view text);
+
+        /**
+         * @brief Removes all characters, keeping the allocation.
+         */
+        void clear() noexcept;
+
+        /**
+         * @brief Gets the characters.
+         * @return Pointer to the first character
+         */
+        const char* data() const noexcept;
+
+        /**
+         * @brief Gets the number of characters.
+         * @return The number of characters
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * @brief Gets the characters as a view.
+         * @return View of all characters
+         */
+        std::string_view view() const noexcept;
+    };
+
+    /**
+     * @brief Writes an amount in smallest currency units as "integral.part".
+     *
+     * The part always has two digits, e.g. 12345 is written as "123.45" and
+     * 5 as "0.05".
+     *
+     * @param out Receives the characters, must hold max_amount_size characters
+     * @param amount The amount in smallest currency units
+     * @param decimal_point Character written between the integral part and the part
+     * @return Pointer past the last written character
+     */
+    char* format_amount(char* out, std::uint64_t amount, char decimal_point = '.') noexcept;
+
+    /**
+     * @brief Writes a value.
+     * @param out Receives the characters, must hold the larger of max_money_size and options.width characters
+     * @param value The value to write
+     * @param options The layout
+     * @return Pointer past the last written character
+     */
+    char* format_to(char* out, const money& value, const format_options& options = format_options()) noexcept;
+
+    /**
+     * @brief Writes many values, each followed by the separator.
+     * @param values Pointer to the first value
+     * @param count Number of values
+     * @param options The layout
+     * @param out Receives the characters, appended to its current contents
+     */
+    void format_column(const money* values, std::size_t count, const format_options& options, output_buffer& out);
+
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+    /**
+     * @brief Writes many values, each followed by the separator.
+     * @param values The values to write
+     * @param options The layout
+     * @param out Receives the characters, appended to its current contents
+     */
+    inline void format_column(std::span<const money> values, const format_options& options, output_buffer& out) {
+        format_column(values.data(), values.size(), options, out);
+    }
+#endif
+}
+
+#endif /* MONEY_FORMAT_HPP */
@@ -0,0 +1,216 @@
+#include "money_formatter.hpp"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include "currency.hpp"
+
+namespace mc {
+
+    namespace impl {
+        /// Rules of the built-in locales, after CLDR with plain ASCII where it agrees
+        constexpr locale_rules builtin_locales_[] = {
+            {"bg_BG", currency::BGN, "\xD0\xBB\xD0\xB2.", ',', "\xC2\xA0", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"cs_CZ", currency::CZK, "K\xC4\x8D", ',', "\xC2\xA0", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"da_DK", currency::DKK, "kr.", ',', ".", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"de_AT", currency::EUR, "\xE2\x82\xAC", ',', "\xC2\xA0", 3, 3, symbol_placement::before, "\xC2\xA0"},
+            {"de_CH", currency::CHF, "CHF", '.', "\xE2\x80\x99", 3, 3, symbol_placement::before, "\xC2\xA0"},
+            {"de_DE", currency::EUR, "\xE2\x82\xAC", ',', ".", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"el_GR", currency::EUR, "\xE2\x82\xAC", ',', ".", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"en_AU", currency::AUD, "$", '.', ",", 3, 3, symbol_placement::before, ""},
+            {"en_CA", currency::CAD, "$", '.', ",", 3, 3, symbol_placement::before, ""},
+            {"en_GB", currency::GBP, "\xC2\xA3", '.', ",", 3, 3, symbol_placement::before, ""},
+            {"en_IE", currency::EUR, "\xE2\x82\xAC", '.', ",", 3, 3, symbol_placement::before, ""},
+            {"en_IN", currency::INR, "\xE2\x82\xB9", '.', ",", 3, 2, symbol_placement::before, ""},
+            {"en_NZ", currency::NZD, "$", '.', ",", 3, 3, symbol_placement::before, ""},
+            {"en_SG", currency::SGD, "$", '.', ",", 3, 3, symbol_placement::before, ""},
+            {"en_US", currency::USD, "$", '.', ",", 3, 3, symbol_placement::before, ""},
+            {"en_ZA", currency::ZAR, "R", ',', "\xC2\xA0", 3, 3, symbol_placement::before, ""},
+            {"es_ES", currency::EUR, "\xE2\x82\xAC", ',', ".", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"es_MX", currency::MXN, "$", '.', ",", 3, 3, symbol_placement::before, ""},
+            {"fi_FI", currency::EUR, "\xE2\x82\xAC", ',', "\xC2\xA0", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"fr_CA", currency::CAD, "$", ',', "\xC2\xA0", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"fr_CH", currency::CHF, "CHF", '.', "\xE2\x80\xAF", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"fr_FR", currency::EUR, "\xE2\x82\xAC", ',', "\xE2\x80\xAF", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"he_IL", currency::ILS, "\xE2\x82\xAA", '.', ",", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"hi_IN", currency::INR, "\xE2\x82\xB9", '.', ",", 3, 2, symbol_placement::before, ""},
+            {"hu_HU", currency::HUF, "Ft", ',', "\xC2\xA0", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"id_ID", currency::IDR, "Rp", ',', ".", 3, 3, symbol_placement::before, ""},
+            {"it_IT", currency::EUR, "\xE2\x82\xAC", ',', ".", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"ms_MY", currency::MYR, "RM", '.', ",", 3, 3, symbol_placement::before, ""},
+            {"nb_NO", currency::NOK, "kr", ',', "\xC2\xA0", 3, 3, symbol_placement::before, "\xC2\xA0"},
+            {"nl_NL", currency::EUR, "\xE2\x82\xAC", ',', ".", 3, 3, symbol_placement::before, "\xC2\xA0"},
+            {"pl_PL", currency::PLN, "z\xC5\x82", ',', "\xC2\xA0", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"pt_BR", currency::BRL, "R$", ',', ".", 3, 3, symbol_placement::before, "\xC2\xA0"},
+            {"pt_PT", currency::EUR, "\xE2\x82\xAC", ',', "\xC2\xA0", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"ro_MD", currency::MDL, "MDL", ',', ".", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"ro_RO", currency::RON, "RON", ',', ".", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"ru_RU", currency::RUB, "\xE2\x82\xBD", ',', "\xC2\xA0", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"sv_SE", currency::SEK, "kr", ',', "\xC2\xA0", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"th_TH", currency::THB, "\xE0\xB8\xBF", '.', ",", 3, 3, symbol_placement::before, ""},
+            {"tr_TR", currency::TRY, "\xE2\x82\xBA", ',', ".", 3, 3, symbol_placement::before, ""},
+            {"uk_UA", currency::UAH, "\xE2\x82\xB4", ',', "\xC2\xA0", 3, 3, symbol_placement::after, "\xC2\xA0"},
+            {"zh_CN", currency::CNY, "\xC2\xA5", '.', ",", 3, 3, symbol_placement::before, ""},
+            {"zh_HK", currency::HKD, "HK$", '.', ",", 3, 3, symbol_placement::before, ""},
+        };
+
+        /// Formatters created so far, keyed by locale ID
+        struct formatter_cache_ {
+            std::shared_mutex mutex;
+            std::map<std::string, std::unique_ptr<money_formatter>, std::less<>> formatters;
+        };
+
+        formatter_cache_& formatter_cache_instance_() {
+            static formatter_cache_ cache;
+            return cache;
+        }
+
+        const locale_rules* find_builtin_(std::string_view locale) noexcept {
+            for (const locale_rules& rules : builtin_locales_) {
+                if (rules.id == locale) {
+                    return &rules;
+                }
+            }
+            return nullptr;
+        }
+
+        /// Copies size characters, text may be null when size is zero
+        char* copy_(char* out, const char* text, std::size_t size) noexcept {
+            return std::copy_n(text, size, out);
+        }
+    }
+
+    money_formatter::money_formatter(const locale_rules& rules) :
+    _locale(rules.id), _currency(rules.currency), _placement(rules.placement), _decimal_point(rules.decimal_point),
+    _group(rules.group), _next_group(rules.next_group) {
+        if (rules.id.empty()) {
+            throw std::invalid_argument("locale ID is empty");
+        }
+        if (rules.symbol.size() > 8 || rules.group_separator.size() > sizeof (_separator)
+                || rules.spacing.size() > sizeof (_code_spacing)) {
+            throw std::invalid_argument("locale rules string too long");
+        }
+        if (rules.group > 9 || rules.next_group > 9 || (rules.group > 0 && rules.next_group == 0)) {
+            throw std::invalid_argument("invalid digit grouping");
+        }
+        _separator_size = static_cast<std::uint8_t>(rules.group_separator.size());
+        impl::copy_(_separator, rules.group_separator.data(), _separator_size);
+
+        const std::string_view code_spacing = rules.spacing.empty() ? std::string_view(" ") : rules.spacing;
+        _code_spacing_size = static_cast<std::uint8_t>(code_spacing.size());
+        impl::copy_(_code_spacing, code_spacing.data(), _code_spacing_size);
+
+        char* p = _symbol;
+        if (_placement == symbol_placement::after) {
+            p = impl::copy_(p, rules.spacing.data(), rules.spacing.size());
+        }
+        p = impl::copy_(p, rules.symbol.data(), rules.symbol.size());
+        if (_placement == symbol_placement::before) {
+            p = impl::copy_(p, rules.spacing.data(), rules.spacing.size());
+        }
+        _symbol_size = static_cast<std::uint8_t>(p - _symbol);
+    }
+
+    const std::string& money_formatter::locale() const noexcept {
+        return _locale;
+    }
+
+    char* money_formatter::format_to(char* out, const money& value) const noexcept {
+        char digits[max_amount_size];
+        const char* end = mc::format_amount(digits, value.amount(), _decimal_point);
+        const std::size_t integral = static_cast<std::size_t>(end - digits) - 3;
+        const bool symbol = value.currency() == _currency;
+
+        if (_placement == symbol_placement::before) {
+            if (symbol) {
+                out = impl::copy_(out, _symbol, _symbol_size);
+            } else {
+                const std::string_view code = to_code(value.currency());
+                out = impl::copy_(out, code.data(), code.size());
+                out = impl::copy_(out, _code_spacing, _code_spacing_size);
+            }
+        }
+
+        if (_group == 0 || integral <= _group) {
+            out = impl::copy_(out, digits, integral);
+        } else {
+            // the leading group holds what is left over by the full groups
+            const std::size_t upper = integral - _group;
+            std::size_t lead = upper % _next_group;
+            lead = lead == 0 ? _next_group : lead;
+            out = impl::copy_(out, digits, lead);
+            for (std::size_t i = lead; i < upper; i += _next_group) {
+                out = impl::copy_(out, _separator, _separator_size);
+                out = impl::copy_(out, digits + i, _next_group);
+            }
+            out = impl::copy_(out, _separator, _separator_size);
+            out = impl::copy_(out, digits + upper, _group);
+        }
+        out = impl::copy_(out, digits + integral, 3);
+
+        if (_placement == symbol_placement::after) {
+            if (symbol) {
+                out = impl::copy_(out, _symbol, _symbol_size);
+            } else {
+                const std::string_view code = to_code(value.currency());
+                out = impl::copy_(out, _code_spacing, _code_spacing_size);
+                out = impl::copy_(out, code.data(), code.size());
+            }
+        }
+        return out;
+    }
+
+    std::string money_formatter::format(const money& value) const {
+        char buffer[max_formatted_size];
+        return std::string(buffer, format_to(buffer, value));
+    }
+
+    void money_formatter::format_column(const money* values, std::size_t count, output_buffer& out, char separator) const {
+        char* p = out.prepare(count * (max_formatted_size + 1));
+        for (std::size_t i = 0; i < count; ++i) {
+            p = format_to(p, values[i]);
+            *p = separator;
+            p += separator != '\0';
+        }
+        out.commit(p);
+    }
+
+    const money_formatter& find_formatter(std::string_view locale) {
+        impl::formatter_cache_& cache = impl::formatter_cache_instance_();
+        {
+            std::shared_lock<std::shared_mutex> lock(cache.mutex);
+            const auto found = cache.formatters.find(locale);
+            if (found != cache.formatters.end()) {
+                return *found->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(cache.mutex);
+        const auto found = cache.formatters.find(locale);
+        if (found != cache.formatters.end()) {
+            return *found->second;
+        }
+        const locale_rules* rules = impl::find_builtin_(locale);
+        if (rules == nullptr) {
+            throw std::invalid_argument("unknown locale: " + std::string(locale));
+        }
+        std::unique_ptr<money_formatter> formatter(new money_formatter(*rules));
+        std::unique_ptr<money_formatter>& slot = cache.formatters[std::string(locale)];
+        slot = std::move(formatter);
+        return *slot;
+    }
+
+    const money_formatter& add_locale(const locale_rules& rules) {
+        std::unique_ptr<money_formatter> formatter(new money_formatter(rules));
+        impl::formatter_cache_& cache = impl::formatter_cache_instance_();
+        std::unique_lock<std::shared_mutex> lock(cache.mutex);
+        if (cache.formatters.count(rules.id) > 0 || impl::find_builtin_(rules.id) != nullptr) {
+            throw std::invalid_argument("locale already known: " + std::string(rules.id));
+        }
+        std::unique_ptr<money_formatter>& slot = cache.formatters[std::string(rules.id)];
+        slot = std::move(formatter);
+        return *slot;
+    }
+}
@@ -0,0 +1,135 @@
+/**
+ * @file money_formatter.hpp
+ * @brief Locale-specific formatting of monetary values.
+ *
+ * A money_formatter is built once from the formatting rules of a locale:
+ * the decimal point, the group separator and grouping, and the placement
+ * and spacing of the currency symbol. Formatting then writes into a caller
+ * buffer without allocating or consulting std::locale. Formatters of the
+ * built-in locales, and of locales added with add_locale(), are created on
+ * first use and cached by locale ID.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef MONEY_FORMATTER_HPP
+#define MONEY_FORMATTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "money.hpp"
+#include "money_format.hpp"
+
+namespace mc {
+
+    /**
+     * @brief Position of the currency symbol relative to the amount.
+     */
+    enum class symbol_placement : std::uint8_t {
+        before, ///< "$1,234.56"
+        after   ///< "1.234,56 €"
+    };
+
+    /**
+     * @brief Formatting rules of a locale.
+     *
+     * Strings are UTF-8. The locale's own currency is written with its
+     * symbol; every other currency is written with its ISO code in the same
+     * place, separated by the spacing or, if there is none, by a space.
+     */
+    struct locale_rules {
+        std::string_view id;              ///< Locale ID, e.g. "de_DE"
+        mc::currency currency;            ///< Currency written with the symbol
+        std::string_view symbol;          ///< Currency symbol, at most 8 bytes
+        char decimal_point;               ///< Character between the integral part and the part
+        std::string_view group_separator; ///< Separator between digit groups, at most 4 bytes, empty for none
+        std::uint8_t group;               ///< Digits in the rightmost group, 0 for no grouping
+        std::uint8_t next_group;          ///< Digits in every further group, e.g. 2 for en_IN
+        symbol_placement placement;       ///< Where the symbol goes
+        std::string_view spacing;         ///< Text between the symbol and the amount, at most 4 bytes
+    };
+
+    /// Largest number of characters money_formatter::format_to() writes
+    constexpr std::size_t max_formatted_size = 128;
+
+    /**
+     * @brief Formats values by the rules of one locale.
+     */
+    class money_formatter {
+        std::string _locale;             ///< Locale ID
+        mc::currency _currency;          ///< Currency written with the symbol
+        symbol_placement _placement;     ///< Where the symbol or code goes
+        char _decimal_point;             ///< Character between the integral part and the part
+        std::uint8_t _group;             ///< Digits in the rightmost group, 0 for no grouping
+        std::uint8_t _next_group;        ///< Digits in every further group
+        std::uint8_t _separator_size;    ///< Length of _separator
+        std::uint8_t _symbol_size;       ///< Length of _symbol, including the spacing
+        std::uint8_t _code_spacing_size; ///< Length of _code_spacing
+        char _separator[4];              ///< Group separator
+        char _symbol[12];                ///< Symbol with the spacing, in output order
+        char _code_spacing[4];           ///< Text between an ISO code and the amount
+    public:
+        /**
+         * @brief Precomputes the layout of a locale.
+         * @param rules The formatting rules
+         * @throws std::invalid_argument if the ID is empty, a string is too long, or the grouping is invalid
+         */
+        explicit money_formatter(const locale_rules& rules);
+
+        /**
+         * @brief Gets the locale ID.
+         * @return The locale ID
+         */
+        const std::string& locale() const noexcept;
+
+        /**
+         * @brief Writes a value.
+         * @param out Receives the characters, must hold max_formatted_size characters
+         * @param value The value to write
+         * @return Pointer past the last written character
+         */
+        char* format_to(char* out, const money& value) const noexcept;
+
+        /**
+         * @brief Formats a value into a string.
+         * @param value The value to format
+         * @return The formatted value
+         */
+        std::string format(const money& value) const;
+
+        /**
+         * @brief Writes many values, each followed by a separator.
+         * @param values Pointer to the first value
+         * @param count Number of values
+         * @param out Receives the characters, appended to its current contents
+         * @param separator Character written after every value, '\0' for none
+         */
+        void format_column(const money* values, std::size_t count, output_buffer& out, char separator = '\n') const;
+    };
+
+    /**
+     * @brief Gets the cached formatter of a locale.
+     *
+     * The formatter is created on first use from the built-in rules or the
+     * rules added with add_locale(), and lives until the program ends. Safe
+     * to call from several threads.
+     *
+     * @param locale Locale ID, e.g. "en_US"
+     * @return The formatter
+     * @throws std::invalid_argument if the locale is unknown
+     */
+    const money_formatter& find_formatter(std::string_view locale);
+
+    /**
+     * @brief Adds the rules of a locale to the formatter cache.
+     * @param rules The formatting rules
+     * @return The formatter of the locale
+     * @throws std::invalid_argument if the rules are invalid or the locale is already known
+     */
+    const money_formatter& add_locale(const locale_rules& rules);
+}
+
+#endif /* MONEY_FORMATTER_HPP */
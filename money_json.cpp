@@ -0,0 +1,247 @@
+#include "money_json.hpp"
+
+#include <cstring>
+#include "currency.hpp"
+#include "money_format.hpp"
+
+namespace mc {
+
+    namespace impl {
+        constexpr char json_amount_[] = "{\"amount\":\"";
+        constexpr char json_currency_[] = "\",\"currency\":\"";
+        constexpr char json_end_[] = "\"}";
+
+        /// Writes a value, out must hold max_json_size characters
+        char* write_json_(char* out, const money& value) noexcept {
+            std::memcpy(out, json_amount_, sizeof (json_amount_) - 1);
+            out = format_amount(out + sizeof (json_amount_) - 1, value.amount());
+            std::memcpy(out, json_currency_, sizeof (json_currency_) - 1);
+            out += sizeof (json_currency_) - 1;
+            const std::string_view code = to_code(value.currency());
+            std::memcpy(out, code.data(), code.size());
+            out += code.size();
+            std::memcpy(out, json_end_, sizeof (json_end_) - 1);
+            return out + sizeof (json_end_) - 1;
+        }
+
+        /// Cursor over the text being read; every function returns false on malformed input
+        struct json_cursor_ {
+            const char* p;
+            const char* end;
+
+            void skip_whitespace() noexcept {
+                while (p != end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) {
+                    ++p;
+                }
+            }
+
+            bool consume(char c) noexcept {
+                skip_whitespace();
+                if (p == end || *p != c) {
+                    return false;
+                }
+                ++p;
+                return true;
+            }
+
+            /// Reads a string without escape sequences, as a view of its contents
+            bool string(std::string_view& result) noexcept {
+                if (!consume('"')) {
+                    return false;
+                }
+                const char* begin = p;
+                while (p != end && *p != '"') {
+                    if (*p == '\\' || static_cast<unsigned char>(*p) < 0x20) {
+                        return false;
+                    }
+                    ++p;
+                }
+                if (p == end) {
+                    return false;
+                }
+                result = std::string_view(begin, static_cast<std::size_t>(p - begin));
+                ++p;
+                return true;
+            }
+
+            /// Reads the characters of a number or literal
+            std::string_view token() noexcept {
+                skip_whitespace();
+                const char* begin = p;
+                while (p != end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r') {
+                    ++p;
+                }
+                return std::string_view(begin, static_cast<std::size_t>(p - begin));
+            }
+
+            /// Skips a scalar value of a member that is not read
+            bool skip_value() noexcept {
+                skip_whitespace();
+                if (p != end && *p == '"') {
+                    std::string_view ignored;
+                    return string(ignored);
+                }
+                const std::string_view value = token();
+                if (value == "true" || value == "false" || value == "null") {
+                    return true;
+                }
+                for (char c : value) {
+                    if ((c < '0' || c > '9') && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E') {
+                        return false;
+                    }
+                }
+                return !value.empty();
+            }
+        };
+
+        /// Parses "integral[.d[d]]" exactly into smallest currency units
+        bool parse_json_amount_(std::string_view text, std::uint64_t& amount) noexcept {
+            std::size_t i = 0;
+            std::uint64_t integral = 0;
+            while (i < text.size() && text[i] >= '0' && text[i] <= '9') {
+                const unsigned digit = static_cast<unsigned>(text[i] - '0');
+                if (integral > (~std::uint64_t(0) / 100 - digit) / 10) {
+                    return false;
+                }
+                integral = integral * 10 + digit;
+                ++i;
+            }
+            if (i == 0) {
+                return false;
+            }
+            std::uint64_t part = 0;
+            if (i < text.size()) {
+                const std::size_t decimals = text.size() - i - 1;
+                if (text[i] != '.' || decimals < 1 || decimals > 2) {
+                    return false;
+                }
+                for (std::size_t d = 0; d < 2; ++d) {
+                    const char c = d < decimals ? text[i + 1 + d] : '0';
+                    if (c < '0' || c > '9') {
+                        return false;
+                    }
+                    part = part * 10 + static_cast<unsigned>(c - '0');
+                }
+            }
+            if (integral * 100 > ~std::uint64_t(0) - part) {
+                return false;
+            }
+            amount = integral * 100 + part;
+            return true;
+        }
+
+        bool read_json_(json_cursor_& in, money& value) noexcept {
+            if (!in.consume('{')) {
+                return false;
+            }
+            bool has_amount = false;
+            bool has_currency = false;
+            std::uint64_t amount = 0;
+            currency curr = currency::AED;
+            do {
+                std::string_view key;
+                if (!in.string(key) || !in.consume(':')) {
+                    return false;
+                }
+                if (key == "amount" && !has_amount) {
+                    in.skip_whitespace();
+                    std::string_view text;
+                    if (in.p != in.end && *in.p == '"' ? !in.string(text) : (text = in.token()).empty()) {
+                        return false;
+                    }
+                    if (!parse_json_amount_(text, amount)) {
+                        return false;
+                    }
+                    has_amount = true;
+                } else if (key == "currency" && !has_currency) {
+                    std::string_view code;
+                    if (!in.string(code) || !find_currency(code, curr)) {
+                        return false;
+                    }
+                    has_currency = true;
+                } else if (key == "amount" || key == "currency" || !in.skip_value()) {
+                    return false;
+                }
+            } while (in.consume(','));
+            if (!in.consume('}') || !has_amount || !has_currency) {
+                return false;
+            }
+            value = money::from_amount(curr, amount);
+            return true;
+        }
+    }
+
+    std::size_t write_json(const money& value, char* out, std::size_t size) noexcept {
+        char buffer[max_json_size];
+        const std::size_t length = static_cast<std::size_t>(impl::write_json_(buffer, value) - buffer);
+        if (length > size) {
+            return 0;
+        }
+        std::memcpy(out, buffer, length);
+        return length;
+    }
+
+    std::size_t write_json(const money* values, std::size_t count, char* out, std::size_t size) noexcept {
+        char* const begin = out;
+        char* const end = out + size;
+        if (size < 2) {
+            return 0;
+        }
+        *out++ = '[';
+        for (std::size_t i = 0; i < count; ++i) {
+            if (static_cast<std::size_t>(end - out) >= max_json_size + 2) {
+                // room for a value of any length, the separator and the closing bracket
+                if (i > 0) {
+                    *out++ = ',';
+                }
+                out = impl::write_json_(out, values[i]);
+                continue;
+            }
+            char buffer[max_json_size + 1];
+            char* last = buffer;
+            if (i > 0) {
+                *last++ = ',';
+            }
+            last = impl::write_json_(last, values[i]);
+            const std::size_t length = static_cast<std::size_t>(last - buffer);
+            if (length + 1 > static_cast<std::size_t>(end - out)) {
+                return 0;
+            }
+            std::memcpy(out, buffer, length);
+            out += length;
+        }
+        if (out == end) {
+            return 0;
+        }
+        *out++ = ']';
+        return static_cast<std::size_t>(out - begin);
+    }
+
+    std::size_t read_json(std::string_view text, money& value) noexcept {
+        impl::json_cursor_ in{text.data(), text.data() + text.size()};
+        if (!impl::read_json_(in, value)) {
+            return 0;
+        }
+        return static_cast<std::size_t>(in.p - text.data());
+    }
+
+    std::size_t read_json(std::string_view text, money* values, std::size_t capacity, std::size_t& count) noexcept {
+        impl::json_cursor_ in{text.data(), text.data() + text.size()};
+        count = 0;
+        if (!in.consume('[')) {
+            return 0;
+        }
+        if (!in.consume(']')) {
+            do {
+                if (count == capacity || !impl::read_json_(in, values[count])) {
+                    return 0;
+                }
+                ++count;
+            } while (in.consume(','));
+            if (!in.consume(']')) {
+                return 0;
+            }
+        }
+        return static_cast<std::size_t>(in.p - text.data());
+    }
+}
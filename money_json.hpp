@@ -0,0 +1,71 @@
+/**
+ * @file money_json.hpp
+ * @brief Allocation-free JSON encoding of monetary values.
+ *
+ * A value is written as {"amount":"123.45","currency":"USD"}, with the
+ * amount as a string holding exactly two decimals so no JSON reader turns
+ * it into a binary floating-point number. Arrays of values are written as
+ * JSON arrays. Writers fill caller-supplied buffers, readers parse from a
+ * string view straight into smallest currency units; neither builds a
+ * document tree, allocates or throws.
+ *
+ * The reader accepts whitespace between tokens, the two members in any
+ * order, amounts as strings or as plain numbers with at most two decimals,
+ * and skips other members whose values are strings, numbers, true, false
+ * or null. Strings with escape sequences are rejected.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef MONEY_JSON_HPP
+#define MONEY_JSON_HPP
+
+#include <cstddef>
+#include <string_view>
+#include "money.hpp"
+
+namespace mc {
+
+    /// Largest number of characters write_json() takes for one value
+    constexpr std::size_t max_json_size = 51;
+
+    /**
+     * @brief Writes a value as a JSON object.
+     * @param value The value to write
+     * @param out Receives the characters
+     * @param size Number of characters available
+     * @return The number of characters written, or 0 if they do not fit
+     */
+    std::size_t write_json(const money& value, char* out, std::size_t size) noexcept;
+
+    /**
+     * @brief Writes values as a JSON array of objects.
+     * @param values Pointer to the first value
+     * @param count Number of values
+     * @param out Receives the characters
+     * @param size Number of characters available, at most count * (max_json_size + 1) + 2 are needed
+     * @return The number of characters written, or 0 if they do not fit
+     */
+    std::size_t write_json(const money* values, std::size_t count, char* out, std::size_t size) noexcept;
+
+    /**
+     * @brief Reads a value from a JSON object.
+     * @param text The text, starting with the object or whitespace
+     * @param value Receives the value
+     * @return The number of characters read, or 0 if the text is not a valid money object
+     */
+    std::size_t read_json(std::string_view text, money& value) noexcept;
+
+    /**
+     * @brief Reads values from a JSON array of objects.
+     * @param text The text, starting with the array or whitespace
+     * @param values Receives the values
+     * @param capacity Number of values that fit into values
+     * @param count Receives the number of values read
+     * @return The number of characters read, or 0 if the text is not a valid array or holds more than capacity values
+     */
+    std::size_t read_json(std::string_view text, money* values, std::size_t capacity, std::size_t& count) noexcept;
+}
+
+#endif /* MONEY_JSON_HPP */
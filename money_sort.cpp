@@ -0,0 +1,107 @@
+#include "money_sort.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace mc {
+
+    namespace impl {
+        /// Number of radix digits: eight amount bytes and the currency
+        constexpr std::size_t sort_digits_ = 9;
+
+        /**
+         * Sorts amounts and currencies together, the currency being the most
+         * significant digit. Digits whose values all fall into one bucket
+         * leave the order unchanged and are skipped.
+         */
+        void radix_sort_(std::uint64_t* amounts, std::uint8_t* currencies, std::size_t n) {
+            if (n < 2) {
+                return;
+            }
+            std::vector<std::size_t> counts(sort_digits_ * 256, 0);
+            for (std::size_t i = 0; i < n; ++i) {
+                std::uint64_t amount = amounts[i];
+                for (std::size_t d = 0; d < 8; ++d) {
+                    ++counts[d * 256 + (amount & 0xFF)];
+                    amount >>= 8;
+                }
+                ++counts[8 * 256 + currencies[i]];
+            }
+
+            std::vector<std::uint64_t> amount_scratch(n);
+            std::vector<std::uint8_t> currency_scratch(n);
+            std::uint64_t* from_amounts = amounts;
+            std::uint8_t* from_currencies = currencies;
+            std::uint64_t* to_amounts = amount_scratch.data();
+            std::uint8_t* to_currencies = currency_scratch.data();
+
+            for (std::size_t d = 0; d < sort_digits_; ++d) {
+                std::size_t* count = counts.data() + d * 256;
+                const std::uint8_t first = d < 8
+                        ? static_cast<std::uint8_t>(from_amounts[0] >> (d * 8))
+                        : from_currencies[0];
+                if (count[first] == n) {
+                    continue;
+                }
+                std::size_t offset = 0;
+                for (std::size_t b = 0; b < 256; ++b) {
+                    const std::size_t size = count[b];
+                    count[b] = offset;
+                    offset += size;
+                }
+                if (d < 8) {
+                    const unsigned shift = static_cast<unsigned>(d * 8);
+                    for (std::size_t i = 0; i < n; ++i) {
+                        const std::size_t to = count[(from_amounts[i] >> shift) & 0xFF]++;
+                        to_amounts[to] = from_amounts[i];
+                        to_currencies[to] = from_currencies[i];
+                    }
+                } else {
+                    for (std::size_t i = 0; i < n; ++i) {
+                        const std::size_t to = count[from_currencies[i]]++;
+                        to_amounts[to] = from_amounts[i];
+                        to_currencies[to] = from_currencies[i];
+                    }
+                }
+                std::swap(from_amounts, to_amounts);
+                std::swap(from_currencies, to_currencies);
+            }
+
+            if (from_amounts != amounts) {
+                std::memcpy(amounts, from_amounts, n * sizeof (std::uint64_t));
+                std::memcpy(currencies, from_currencies, n);
+            }
+        }
+    }
+
+    void radix_sort(money_column& column) {
+        const std::size_t n = column.size();
+        // an unsigned view of a signed array may alias it; flipping the sign
+        // bit orders signed amounts as unsigned keys
+        std::uint64_t* keys = reinterpret_cast<std::uint64_t*>(column.amounts());
+        constexpr std::uint64_t sign = std::uint64_t(1) << 63;
+        for (std::size_t i = 0; i < n; ++i) {
+            keys[i] ^= sign;
+        }
+        impl::radix_sort_(keys, column.currencies(), n);
+        for (std::size_t i = 0; i < n; ++i) {
+            keys[i] ^= sign;
+        }
+    }
+
+    void radix_sort(std::vector<money>& values) {
+        const std::size_t n = values.size();
+        std::vector<std::uint64_t> amounts(n);
+        std::vector<std::uint8_t> currencies(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            amounts[i] = values[i].amount();
+            currencies[i] = static_cast<std::uint8_t>(values[i].currency());
+        }
+        impl::radix_sort_(amounts.data(), currencies.data(), n);
+        for (std::size_t i = 0; i < n; ++i) {
+            values[i] = money::from_amount(static_cast<currency>(currencies[i]), amounts[i]);
+        }
+    }
+}
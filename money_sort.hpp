@@ -0,0 +1,46 @@
+/**
+ * @file money_sort.hpp
+ * @brief Radix sort of monetary values.
+ *
+ * Values are sorted by currency and then by amount, the order of the money
+ * comparison operators, with a least significant digit radix sort over the
+ * 72-bit key of an 8-bit currency and a 64-bit amount. The byte histograms
+ * of all digits are counted in one pass, and digits shared by every value,
+ * such as the high bytes of small amounts, are skipped, so typical data
+ * takes three or four scatter passes.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef MONEY_SORT_HPP
+#define MONEY_SORT_HPP
+
+#include <vector>
+#include "money.hpp"
+#include "money_column.hpp"
+
+namespace mc {
+
+    /**
+     * @brief Sorts the values of a column by currency, then by signed amount.
+     *
+     * The sort is stable and takes linear time; it uses scratch memory of
+     * the size of the column.
+     *
+     * @param column The values to sort
+     */
+    void radix_sort(money_column& column);
+
+    /**
+     * @brief Sorts money objects by currency, then by amount.
+     *
+     * Gives the same order as std::sort with operator<, in linear time; it
+     * uses scratch memory of about the size of the values.
+     *
+     * @param values The values to sort
+     */
+    void radix_sort(std::vector<money>& values);
+}
+
+#endif /* MONEY_SORT_HPP */
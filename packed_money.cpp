@@ -0,0 +1,126 @@
+#include "packed_money.hpp"
+
+#include <array>
+
+namespace mc {
+
+    namespace impl {
+        constexpr std::uint64_t amount_mask_ = ~std::uint64_t(0xFF);
+
+        /// Values per unchecked block sum: 255 amounts of at most 2^55 fit into 63 bits
+        constexpr std::size_t sum_block_ = 255;
+
+        /// Whether adding two packed words overflowed, given their sum
+        constexpr bool add_overflows_(std::uint64_t left, std::uint64_t right, std::uint64_t sum) noexcept {
+            return ((left ^ sum) & (right ^ sum)) >> 63;
+        }
+
+        /// Whether subtracting two packed words overflowed, given their difference
+        constexpr bool subtract_overflows_(std::uint64_t left, std::uint64_t right, std::uint64_t difference) noexcept {
+            return ((left ^ right) & (left ^ difference)) >> 63;
+        }
+    }
+
+    packed_money::packed_money(const money& m) :
+    _bits(0) {
+        if (m.amount() > static_cast<std::uint64_t>(max_amount)) {
+            throw std::overflow_error("amount does not fit into packed money!");
+        }
+        _bits = pack(m.currency(), static_cast<std::int64_t>(m.amount()));
+    }
+
+    money packed_money::to_money() const {
+        if (amount() < 0) {
+            throw std::logic_error("negative balance!");
+        }
+        return money::from_amount(currency(), static_cast<std::uint64_t>(amount()));
+    }
+
+    void packed_money::operator+=(const packed_money& other) {
+        if (currency() != other.currency()) {
+            throw std::logic_error("incompatible currencies!");
+        }
+        const std::uint64_t right = other._bits & impl::amount_mask_;
+        const std::uint64_t result = _bits + right;
+        if (impl::add_overflows_(_bits, right, result)) {
+            throw std::overflow_error("amount does not fit into packed money!");
+        }
+        _bits = result;
+    }
+
+    void packed_money::operator-=(const packed_money& other) {
+        if (currency() != other.currency()) {
+            throw std::logic_error("incompatible currencies!");
+        }
+        const std::uint64_t right = other._bits & impl::amount_mask_;
+        const std::uint64_t result = _bits - right;
+        if (impl::subtract_overflows_(_bits, right, result)) {
+            throw std::overflow_error("amount does not fit into packed money!");
+        }
+        _bits = result;
+    }
+
+    packed_money operator+(packed_money left, const packed_money& right) {
+        left += right;
+        return left;
+    }
+
+    packed_money operator-(packed_money left, const packed_money& right) {
+        left -= right;
+        return left;
+    }
+
+    void pack(const money* values, std::size_t count, packed_money* out) {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = packed_money(values[i]);
+        }
+    }
+
+    bool add(const packed_money* left, const packed_money* right, packed_money* out, std::size_t count) noexcept {
+        std::uint64_t invalid = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::uint64_t a = left[i].bits();
+            const std::uint64_t b = right[i].bits() & impl::amount_mask_;
+            const std::uint64_t result = a + b;
+            invalid |= ((a ^ right[i].bits()) & 0xFF) | impl::add_overflows_(a, b, result);
+            out[i] = packed_money::from_bits(result);
+        }
+        return invalid == 0;
+    }
+
+    bool sum(const packed_money* values, std::size_t count, mc::currency c, std::int64_t& total) noexcept {
+        const std::uint64_t index = static_cast<std::uint8_t>(c);
+        bool valid = true;
+        total = 0;
+        for (std::size_t begin = 0; begin < count; begin += impl::sum_block_) {
+            const std::size_t end = count - begin < impl::sum_block_ ? count : begin + impl::sum_block_;
+            std::int64_t block = 0;
+            for (std::size_t i = begin; i < end; ++i) {
+                const std::uint64_t bits = values[i].bits();
+                const std::int64_t mask = -static_cast<std::int64_t>((bits & 0xFF) == index);
+                block += (static_cast<std::int64_t>(bits) >> 8) & mask;
+            }
+            valid = impl::checked_add_(total, block, total) && valid;
+        }
+        return valid;
+    }
+
+    void sum(const packed_money* values, std::size_t count, money_bag& totals) {
+        std::array<std::int64_t, 256> partial{};
+        bool valid = true;
+        for (std::size_t i = 0; i < count; ++i) {
+            std::int64_t& total = partial[values[i].bits() & 0xFF];
+            valid = impl::checked_add_(total, values[i].amount(), total) && valid;
+        }
+        if (!valid) {
+            throw std::overflow_error("packed money total overflow");
+        }
+        money_bag bag;
+        for (std::size_t c = 0; c < max_currency_count; ++c) {
+            if (partial[c] != 0) {
+                bag.add(static_cast<mc::currency>(c), partial[c]);
+            }
+        }
+        totals += bag;
+    }
+}
@@ -0,0 +1,218 @@
+/**
+ * @file packed_money.hpp
+ * @brief Monetary value packed into a single 64-bit word.
+ *
+ * packed_money stores a 56-bit signed amount of smallest currency units and
+ * an 8-bit currency index in one uint64_t, a third of the size of money.
+ * Large arrays of amounts therefore take less memory and are scanned at a
+ * higher rate; the kernels below add and sum packed values directly.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef PACKED_MONEY_HPP
+#define PACKED_MONEY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include "money.hpp"
+#include "money_bag.hpp"
+
+namespace mc {
+
+    /**
+     * @brief A signed amount and its currency in one 64-bit word.
+     *
+     * The amount occupies the upper 56 bits and the currency index the lower
+     * 8 bits, so adding two words with the same currency adds the amounts
+     * and keeps the currency.
+     */
+    class packed_money {
+        std::uint64_t _bits; ///< Amount shifted left by 8, or-ed with the currency index
+    public:
+        /// Largest amount that can be packed
+        static constexpr std::int64_t max_amount = (std::int64_t(1) << 55) - 1;
+        /// Smallest amount that can be packed
+        static constexpr std::int64_t min_amount = -(std::int64_t(1) << 55);
+
+        /**
+         * @brief Constructs a zero amount of the first currency.
+         */
+        constexpr packed_money() noexcept : _bits(0) {}
+
+        /**
+         * @brief Constructs a packed value.
+         * @param curr The currency
+         * @param amount The amount in smallest currency units
+         * @throws std::overflow_error if the amount does not fit into 56 bits
+         */
+        constexpr packed_money(mc::currency curr, std::int64_t amount) :
+        _bits(pack(curr, amount)) {}
+
+        /**
+         * @brief Packs a money object.
+         * @param value The money object
+         * @throws std::overflow_error if the amount does not fit into 56 bits
+         */
+        explicit packed_money(const money& value);
+
+        /**
+         * @brief Reinterprets a raw word as a packed value.
+         * @param bits A word previously returned by bits()
+         * @return The packed value
+         */
+        static constexpr packed_money from_bits(std::uint64_t bits) noexcept {
+            packed_money tmp;
+            tmp._bits = bits;
+            return tmp;
+        }
+
+        /**
+         * @brief Gets the raw word.
+         * @return The amount shifted left by 8, or-ed with the currency index
+         */
+        constexpr std::uint64_t bits() const noexcept {
+            return _bits;
+        }
+
+        /**
+         * @brief Gets the currency.
+         * @return The currency
+         */
+        constexpr mc::currency currency() const noexcept {
+            return static_cast<mc::currency>(_bits & 0xFF);
+        }
+
+        /**
+         * @brief Gets the signed amount.
+         * @return The amount in smallest currency units
+         */
+        constexpr std::int64_t amount() const noexcept {
+            return static_cast<std::int64_t>(_bits) >> 8;
+        }
+
+        /**
+         * @brief Converts back to a money object.
+         * @return A money object with the same amount and currency
+         * @throws std::logic_error if the amount is negative
+         */
+        money to_money() const;
+
+        /**
+         * @brief Adds a packed value of the same currency.
+         * @param other The value to add
+         * @throws std::logic_error if currencies don't match
+         * @throws std::overflow_error if the sum does not fit into 56 bits
+         */
+        void operator+=(const packed_money& other);
+
+        /**
+         * @brief Subtracts a packed value of the same currency.
+         * @param other The value to subtract
+         * @throws std::logic_error if currencies don't match
+         * @throws std::overflow_error if the difference does not fit into 56 bits
+         */
+        void operator-=(const packed_money& other);
+
+        /**
+         * @brief Checks whether two packed values are equal.
+         * @param other The value to compare with
+         * @return true if currency and amount are equal, false otherwise
+         */
+        constexpr bool operator==(const packed_money& other) const noexcept {
+            return _bits == other._bits;
+        }
+
+        /**
+         * @brief Checks whether two packed values differ.
+         * @param other The value to compare with
+         * @return true if currency or amount differ, false otherwise
+         */
+        constexpr bool operator!=(const packed_money& other) const noexcept {
+            return _bits != other._bits;
+        }
+
+    private:
+        static constexpr std::uint64_t pack(mc::currency curr, std::int64_t amount) {
+            return amount < min_amount || amount > max_amount
+                    ? throw std::overflow_error("amount does not fit into packed money!")
+                    : (static_cast<std::uint64_t>(amount) << 8) | static_cast<std::uint8_t>(curr);
+        }
+    };
+
+    static_assert(sizeof(packed_money) == 8, "packed money must be one word");
+
+    /**
+     * @brief Adds a packed value of the same currency.
+     * @param left The first value
+     * @param right The value to add
+     * @return The sum
+     * @throws std::logic_error if currencies don't match
+     * @throws std::overflow_error if the sum does not fit into 56 bits
+     */
+    packed_money operator+(packed_money left, const packed_money& right);
+
+    /**
+     * @brief Subtracts a packed value of the same currency.
+     * @param left The first value
+     * @param right The value to subtract
+     * @return The difference
+     * @throws std::logic_error if currencies don't match
+     * @throws std::overflow_error if the difference does not fit into 56 bits
+     */
+    packed_money operator-(packed_money left, const packed_money& right);
+
+    /**
+     * @brief Packs an array of money objects.
+     * @param values Pointer to the first money object
+     * @param count Number of values
+     * @param out Receives count packed values
+     * @throws std::overflow_error if an amount does not fit into 56 bits
+     */
+    void pack(const money* values, std::size_t count, packed_money* out);
+
+    /**
+     * @brief Adds two arrays of packed values element by element.
+     *
+     * The loop has no branches, so compilers vectorize it. Elements whose
+     * currencies differ or whose sum overflows are reported through the
+     * return value rather than by exceptions.
+     *
+     * @param left Pointer to the first array
+     * @param right Pointer to the second array
+     * @param out Receives count sums, may alias left or right
+     * @param count Number of elements
+     * @return true if every sum is valid, false if any pair has different
+     *         currencies or overflows, in which case out is unspecified
+     */
+    bool add(const packed_money* left, const packed_money* right, packed_money* out, std::size_t count) noexcept;
+
+    /**
+     * @brief Sums the amounts of one currency.
+     *
+     * Values of other currencies are masked out without branching. Blocks
+     * of 255 values are summed without checks, since their totals cannot
+     * overflow, and the block totals are added with an overflow check.
+     *
+     * @param values Pointer to the first value
+     * @param count Number of values
+     * @param curr The currency to sum
+     * @param total Receives the total in smallest currency units
+     * @return true if the total fits into a signed 64-bit value, false if it
+     *         overflows, in which case total is unspecified
+     */
+    bool sum(const packed_money* values, std::size_t count, mc::currency curr, std::int64_t& total) noexcept;
+
+    /**
+     * @brief Sums packed values per currency.
+     * @param values Pointer to the first value
+     * @param count Number of values
+     * @param totals Receives the totals, added to its current contents, left unchanged on overflow
+     * @throws std::overflow_error if a total does not fit into a signed 64-bit value
+     */
+    void sum(const packed_money* values, std::size_t count, money_bag& totals);
+}
+
+#endif /* PACKED_MONEY_HPP */
@@ -0,0 +1,155 @@
+#include "rate_table.hpp"
+#include "mapped_file.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace mc {
+
+    namespace impl {
+        inline std::size_t rate_index_(mc::currency from, mc::currency to) noexcept {
+            return static_cast<std::size_t>(from) * max_currency_count + static_cast<std::size_t>(to);
+        }
+
+        inline bool is_blank_(char c) noexcept {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        inline const char* skip_blanks_(const char* p, const char* end) noexcept {
+            while (p != end && is_blank_(*p)) {
+                ++p;
+            }
+            return p;
+        }
+
+        [[noreturn]] void malformed_rate_(std::size_t line) {
+            throw std::invalid_argument("malformed exchange rate at line " + std::to_string(line));
+        }
+
+        /// Reads a currency code followed by a blank or the end of the line
+        const char* parse_code_(const char* p, const char* end, std::size_t line, mc::currency& result) {
+            if (end - p < 3 || (end - p > 3 && !is_blank_(p[3]))) {
+                malformed_rate_(line);
+            }
+            if (!find_currency(std::string_view(p, 3), result)) {
+                throw unknown_currency_shortname();
+            }
+            return p + 3;
+        }
+
+        /// Reads a positive rate and the blanks following it
+        const char* parse_rate_(const char* p, const char* end, std::size_t line, double& result) {
+            auto parsed = std::from_chars(p, end, result);
+            if (parsed.ec != std::errc() || !(result > 0.)) {
+                malformed_rate_(line);
+            }
+            if (parsed.ptr != end && !is_blank_(*parsed.ptr)) {
+                malformed_rate_(line);
+            }
+            return skip_blanks_(parsed.ptr, end);
+        }
+    }
+
+    rate_table::rate_table() : _rates(max_currency_count * max_currency_count, two_sided_rate{{0., 0.}}) {
+        for (std::size_t i = 0; i < max_currency_count; ++i) {
+            _rates[i * max_currency_count + i] = two_sided_rate{{1., 1.}};
+        }
+    }
+
+    void rate_table::set(mc::currency from, mc::currency to, double rate) {
+        set(from, to, two_sided_rate{{rate, rate}});
+    }
+
+    void rate_table::set(mc::currency from, mc::currency to, const two_sided_rate& rate) {
+        if (!(rate.bid() > 0.) || !(rate.ask() > 0.)) {
+            throw std::invalid_argument("exchange rate must be positive");
+        }
+        if (rate.bid() > rate.ask()) {
+            throw std::invalid_argument("bid rate must not exceed ask rate");
+        }
+        _rates[impl::rate_index_(from, to)] = rate;
+    }
+
+    bool rate_table::has(mc::currency from, mc::currency to) const noexcept {
+        return _rates[impl::rate_index_(from, to)].bid() != 0.;
+    }
+
+    double rate_table::rate(mc::currency from, mc::currency to) const {
+        return quote(from, to).mid();
+    }
+
+    const two_sided_rate& rate_table::quote(mc::currency from, mc::currency to) const {
+        const two_sided_rate& r = _rates[impl::rate_index_(from, to)];
+        if (r.bid() == 0.) {
+            throw unknown_rate();
+        }
+        return r;
+    }
+
+    money rate_table::convert(const money& value, mc::currency to) const {
+        return value.convert(to, rate(value.currency(), to));
+    }
+
+    money rate_table::convert(const money& value, mc::currency to, mc::side s) const {
+        return value.convert(to, quote(value.currency(), to).at(s));
+    }
+
+    void rate_table::convert(const money* values, std::size_t count, mc::currency to,
+            std::vector<money>& bid, std::vector<money>& ask) const {
+        bid.clear();
+        ask.clear();
+        bid.reserve(count);
+        ask.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const two_sided_rate& r = quote(values[i].currency(), to);
+            bid.push_back(values[i].convert(to, r.bid()));
+            ask.push_back(values[i].convert(to, r.ask()));
+        }
+    }
+
+    rate_table parse_rates(std::string_view text) {
+        using namespace impl;
+        rate_table table;
+        const char* p = text.data();
+        const char* const end = p + text.size();
+        std::size_t line = 0;
+        while (p != end) {
+            ++line;
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            if (eol == nullptr) {
+                eol = end;
+            }
+            p = skip_blanks_(p, eol);
+            if (p != eol) {
+                mc::currency from, to;
+                double bid, ask;
+                p = skip_blanks_(parse_code_(p, eol, line, from), eol);
+                p = skip_blanks_(parse_code_(p, eol, line, to), eol);
+                p = parse_rate_(p, eol, line, bid);
+                ask = bid;
+                if (p != eol) {
+                    p = parse_rate_(p, eol, line, ask);
+                    if (p != eol || bid > ask) {
+                        malformed_rate_(line);
+                    }
+                }
+                table.set(from, to, two_sided_rate{{bid, ask}});
+                table.set(to, from, two_sided_rate{{1. / ask, 1. / bid}});
+            }
+            p = eol == end ? end : eol + 1;
+        }
+        return table;
+    }
+
+    rate_table load_rates(const std::string& path) {
+        mapped_file file(path);
+        return parse_rates(file.view());
+    }
+
+    // exceptions
+
+    const char* unknown_rate::what() const noexcept {
+        return "unknown exchange rate";
+    }
+}
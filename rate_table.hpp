@@ -0,0 +1,216 @@
+/**
+ * @file rate_table.hpp
+ * @brief Exchange rate table and rate file loader for the money library.
+ *
+ * The rate table stores one exchange rate per ordered currency pair in a
+ * dense array indexed by the currency enumeration, so a lookup is a single
+ * array access. Rate files are plain text with one "FROM TO RATE" entry per
+ * line (e.g. "USD MDL 17.1539"); they are memory-mapped and parsed in place.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef RATE_TABLE_HPP
+#define RATE_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "money.hpp"
+
+namespace mc {
+
+    /**
+     * @brief Side of a two-sided exchange rate.
+     *
+     * The values index two_sided_rate::sides, so a side can be selected
+     * without branching.
+     */
+    enum class side : std::uint8_t {
+        bid = 0, ///< Rate at which the source currency is bought from the client
+        ask = 1  ///< Rate at which the source currency is sold to the client
+    };
+
+    /**
+     * @brief Bid and ask exchange rates of one currency pair, packed in 16 bytes.
+     *
+     * Rates are units of the target currency for one unit of the source
+     * currency; for a valid quote bid <= ask.
+     */
+    struct two_sided_rate {
+        double sides[2]; ///< Rates indexed by side: bid, then ask
+
+        /**
+         * @brief Gets the bid rate.
+         * @return The bid rate
+         */
+        double bid() const noexcept {
+            return sides[0];
+        }
+
+        /**
+         * @brief Gets the ask rate.
+         * @return The ask rate
+         */
+        double ask() const noexcept {
+            return sides[1];
+        }
+
+        /**
+         * @brief Gets the mid rate, derived from bid and ask.
+         * @return The mean of bid and ask
+         */
+        double mid() const noexcept {
+            return (sides[0] + sides[1]) / 2.;
+        }
+
+        /**
+         * @brief Gets the rate of the given side without branching.
+         * @param s The side to select
+         * @return The bid or the ask rate
+         */
+        double at(mc::side s) const noexcept {
+            return sides[static_cast<std::size_t>(s)];
+        }
+    };
+
+    /**
+     * @brief Exchange rates between every pair of supported currencies.
+     *
+     * Every pair holds a two-sided rate; a single rate is stored as equal bid
+     * and ask. A zero rate marks a pair without a known rate. Converting a
+     * currency to itself always uses the rate 1.
+     */
+    class rate_table {
+        std::vector<two_sided_rate> _rates; ///< max_currency_count x max_currency_count rates, row is the source currency
+    public:
+        /**
+         * @brief Constructs an empty rate table.
+         */
+        rate_table();
+
+        /**
+         * @brief Sets the exchange rate for a currency pair.
+         * @param from The source currency
+         * @param to The target currency
+         * @param rate Units of the target currency for one unit of the source currency
+         * @throws std::invalid_argument if rate is not positive
+         */
+        void set(mc::currency from, mc::currency to, double rate);
+
+        /**
+         * @brief Sets the two-sided exchange rate for a currency pair.
+         * @param from The source currency
+         * @param to The target currency
+         * @param rate The bid and ask rates
+         * @throws std::invalid_argument if a rate is not positive or bid exceeds ask
+         */
+        void set(mc::currency from, mc::currency to, const two_sided_rate& rate);
+
+        /**
+         * @brief Checks whether a rate is known for a currency pair.
+         * @param from The source currency
+         * @param to The target currency
+         * @return true if the rate is known, false otherwise
+         */
+        bool has(mc::currency from, mc::currency to) const noexcept;
+
+        /**
+         * @brief Gets the mid exchange rate for a currency pair.
+         * @param from The source currency
+         * @param to The target currency
+         * @return Units of the target currency for one unit of the source currency
+         * @throws unknown_rate if the rate is not known
+         */
+        double rate(mc::currency from, mc::currency to) const;
+
+        /**
+         * @brief Gets the two-sided exchange rate for a currency pair.
+         * @param from The source currency
+         * @param to The target currency
+         * @return The bid and ask rates
+         * @throws unknown_rate if the rate is not known
+         */
+        const two_sided_rate& quote(mc::currency from, mc::currency to) const;
+
+        /**
+         * @brief Converts a money object to another currency.
+         * @param value The money object to convert
+         * @param to The target currency
+         * @return A new money object in the target currency
+         * @throws unknown_rate if the rate is not known
+         */
+        money convert(const money& value, mc::currency to) const;
+
+        /**
+         * @brief Converts a money object to another currency at one side of the rate.
+         * @param value The money object to convert
+         * @param to The target currency
+         * @param s The side of the rate to apply
+         * @return A new money object in the target currency
+         * @throws unknown_rate if the rate is not known
+         */
+        money convert(const money& value, mc::currency to, mc::side s) const;
+
+        /**
+         * @brief Converts a batch of money objects at both sides of the rate in one pass.
+         *
+         * The output vectors are cleared and receive one value per input, in
+         * input order. Every input is converted with the rate from its own
+         * currency.
+         *
+         * @param values Pointer to the first money object
+         * @param count Number of money objects
+         * @param to The target currency
+         * @param bid Receives the amounts converted at the bid rate
+         * @param ask Receives the amounts converted at the ask rate
+         * @throws unknown_rate if a rate is not known
+         */
+        void convert(const money* values, std::size_t count, mc::currency to,
+                std::vector<money>& bid, std::vector<money>& ask) const;
+    };
+
+    /**
+     * @brief Parses exchange rates from text in "FROM TO RATE" lines.
+     *
+     * A line may also hold a two-sided rate as "FROM TO BID ASK". Every line
+     * also defines the inverse rate (TO FROM 1/RATE, or 1/ASK and 1/BID).
+     * Blank lines are skipped and later lines override earlier ones, so
+     * historical files ordered by date leave the latest rate in the table.
+     *
+     * @param text The rate file contents
+     * @return The parsed rate table
+     * @throws std::invalid_argument if a line is malformed
+     * @throws unknown_currency_shortname if a line contains an unknown currency code
+     */
+    rate_table parse_rates(std::string_view text);
+
+    /**
+     * @brief Loads exchange rates from a rate file.
+     *
+     * The file is memory-mapped and parsed with parse_rates().
+     *
+     * @param path Path to the rate file
+     * @return The loaded rate table
+     * @throws std::runtime_error if the file cannot be opened
+     * @throws std::invalid_argument if a line is malformed
+     * @throws unknown_currency_shortname if a line contains an unknown currency code
+     */
+    rate_table load_rates(const std::string& path);
+
+    /**
+     * @brief Exception thrown when no exchange rate is known for a currency pair.
+     */
+    struct unknown_rate : public std::exception {
+        /**
+         * @brief Returns a description of the exception.
+         * @return const char* A C-style string describing the exception
+         */
+        virtual const char* what() const noexcept;
+    };
+}
+
+#endif /* RATE_TABLE_HPP */
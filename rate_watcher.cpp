@@ -0,0 +1,140 @@
+#include "rate_watcher.hpp"
+
+#include <cerrno>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace mc {
+
+    rate_watcher::rate_watcher(const std::string& path) :
+    _path(path), _table(std::make_shared<const rate_table>(load_rates(path))),
+    _generation(1), _stop_fd(-1) {
+
+    }
+
+    rate_watcher::~rate_watcher() {
+        stop();
+    }
+
+    std::shared_ptr<const rate_table> rate_watcher::table() const {
+        return std::atomic_load(&_table);
+    }
+
+    std::uint64_t rate_watcher::generation() const noexcept {
+        return _generation.load(std::memory_order_acquire);
+    }
+
+    bool rate_watcher::reload() noexcept {
+        try {
+            auto table = std::make_shared<const rate_table>(load_rates(_path));
+            std::atomic_store(&_table, std::shared_ptr<const rate_table>(std::move(table)));
+            _generation.fetch_add(1, std::memory_order_release);
+            return true;
+        } catch (...) {
+            return false;
+        }
+    }
+
+#if defined(__linux__)
+
+    void rate_watcher::start() {
+        if (_thread.joinable()) {
+            return;
+        }
+        // watch the directory, so replacing the file by rename is noticed too
+        const std::size_t slash = _path.find_last_of('/');
+        const std::string dir = slash == std::string::npos ? "." : (slash == 0 ? "/" : _path.substr(0, slash));
+        const std::string name = slash == std::string::npos ? _path : _path.substr(slash + 1);
+
+        int inotify_fd = ::inotify_init1(IN_CLOEXEC);
+        if (inotify_fd < 0) {
+            throw std::runtime_error("cannot initialize inotify");
+        }
+        if (::inotify_add_watch(inotify_fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+            ::close(inotify_fd);
+            throw std::runtime_error("cannot watch directory: " + dir);
+        }
+        _stop_fd = ::eventfd(0, EFD_CLOEXEC);
+        if (_stop_fd < 0) {
+            ::close(inotify_fd);
+            throw std::runtime_error("cannot create event descriptor");
+        }
+        try {
+            _thread = std::thread(&rate_watcher::watch, this, inotify_fd, name);
+        } catch (...) {
+            ::close(inotify_fd);
+            ::close(_stop_fd);
+            _stop_fd = -1;
+            throw;
+        }
+    }
+
+    void rate_watcher::stop() noexcept {
+        if (!_thread.joinable()) {
+            return;
+        }
+        std::uint64_t one = 1;
+        while (::write(_stop_fd, &one, sizeof (one)) < 0 && errno == EINTR) {
+        }
+        _thread.join();
+        ::close(_stop_fd);
+        _stop_fd = -1;
+    }
+
+    void rate_watcher::watch(int inotify_fd, std::string name) noexcept {
+        alignas(inotify_event) char buffer[4096];
+        pollfd fds[2] = {
+            {inotify_fd, POLLIN, 0},
+            {_stop_fd, POLLIN, 0}
+        };
+        for (;;) {
+            if (::poll(fds, 2, -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            if (fds[1].revents != 0) {
+                break;
+            }
+            ssize_t length = ::read(inotify_fd, buffer, sizeof (buffer));
+            if (length <= 0) {
+                continue;
+            }
+            bool changed = false;
+            for (char* p = buffer; p < buffer + length;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(p);
+                if (event->len > 0 && name == event->name) {
+                    changed = true;
+                }
+                p += sizeof (inotify_event) + event->len;
+            }
+            if (changed) {
+                reload();
+            }
+        }
+        ::close(inotify_fd);
+    }
+
+#else
+
+    void rate_watcher::start() {
+        throw std::logic_error("rate file watching is not supported on this platform");
+    }
+
+    void rate_watcher::stop() noexcept {
+
+    }
+
+    void rate_watcher::watch(int, std::string) noexcept {
+
+    }
+
+#endif
+}
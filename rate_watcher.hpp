@@ -0,0 +1,95 @@
+/**
+ * @file rate_watcher.hpp
+ * @brief Hot reload of exchange rate files.
+ *
+ * The rate watcher keeps the current rate table behind a shared pointer that
+ * is swapped atomically, so readers always see either the old or the new
+ * table in full. On Linux a background thread uses inotify to reload the
+ * table whenever the rate file is rewritten or replaced.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef RATE_WATCHER_HPP
+#define RATE_WATCHER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include "rate_table.hpp"
+
+namespace mc {
+
+    /**
+     * @brief Keeps a rate table in sync with its rate file.
+     *
+     * Readers call table() and keep the returned pointer for as long as they
+     * need a consistent set of rates. A failed reload (e.g. a half-written
+     * file) leaves the previous table in place.
+     */
+    class rate_watcher {
+        std::string _path;                            ///< Watched rate file
+        std::shared_ptr<const rate_table> _table;     ///< Current table, accessed atomically
+        std::atomic<std::uint64_t> _generation;       ///< Number of successful loads
+        std::thread _thread;                          ///< Background watching thread
+        int _stop_fd;                                 ///< Event descriptor used to wake the thread on stop
+    public:
+        /**
+         * @brief Loads the rate file without starting to watch it.
+         * @param path Path to the rate file
+         * @throws std::runtime_error if the file cannot be opened
+         * @throws std::invalid_argument if a line is malformed
+         * @throws unknown_currency_shortname if a line contains an unknown currency code
+         */
+        explicit rate_watcher(const std::string& path);
+
+        rate_watcher(const rate_watcher&) = delete;
+        rate_watcher& operator=(const rate_watcher&) = delete;
+
+        /**
+         * @brief Stops watching the file.
+         */
+        ~rate_watcher();
+
+        /**
+         * @brief Gets the current rate table.
+         * @return Shared pointer to the current table, never null
+         */
+        std::shared_ptr<const rate_table> table() const;
+
+        /**
+         * @brief Gets the number of successful loads, including the initial one.
+         * @return The table generation
+         */
+        std::uint64_t generation() const noexcept;
+
+        /**
+         * @brief Reloads the rate file and swaps in the new table.
+         * @return true if the file was loaded, false if the previous table was kept
+         */
+        bool reload() noexcept;
+
+        /**
+         * @brief Starts a background thread reloading the table on file changes.
+         *
+         * Does nothing if the watcher is already running.
+         *
+         * @throws std::runtime_error if the file cannot be watched
+         * @throws std::logic_error if file watching is not supported on this platform
+         */
+        void start();
+
+        /**
+         * @brief Stops the background thread, if it is running.
+         */
+        void stop() noexcept;
+
+    private:
+        void watch(int inotify_fd, std::string name) noexcept;
+    };
+}
+
+#endif /* RATE_WATCHER_HPP */
@@ -0,0 +1,109 @@
+#include "striped_money_counter.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace mc {
+
+    namespace impl {
+        /// Slots of exited threads, handed out again lowest first
+        struct slot_registry_ {
+            std::mutex mutex;
+            std::vector<std::size_t> free; ///< Min-heap of returned slots
+            std::size_t next = 0;          ///< Lowest slot never handed out
+        };
+
+        slot_registry_& slot_registry_instance_() noexcept {
+            // never destroyed, threads may exit after static destruction
+            static slot_registry_* registry = new slot_registry_();
+            return *registry;
+        }
+
+        /// Holds the slot of a thread and returns it when the thread exits
+        struct thread_slot_holder_ {
+            std::size_t slot;
+
+            thread_slot_holder_() {
+                slot_registry_& registry = slot_registry_instance_();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                if (registry.free.empty()) {
+                    slot = registry.next++;
+                } else {
+                    std::pop_heap(registry.free.begin(), registry.free.end(), std::greater<std::size_t>());
+                    slot = registry.free.back();
+                    registry.free.pop_back();
+                }
+            }
+
+            ~thread_slot_holder_() {
+                slot_registry_& registry = slot_registry_instance_();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                registry.free.push_back(slot);
+                std::push_heap(registry.free.begin(), registry.free.end(), std::greater<std::size_t>());
+            }
+        };
+
+        std::size_t thread_slot_() {
+            thread_local const thread_slot_holder_ holder;
+            return holder.slot;
+        }
+    }
+
+    striped_money_counter::striped_money_counter(std::size_t stripes) {
+        if (stripes == 0) {
+            stripes = std::thread::hardware_concurrency();
+        }
+        std::size_t count = 1;
+        while (count < stripes) {
+            count <<= 1;
+        }
+        _stripes.reset(new stripe[count]);
+        _mask = count - 1;
+        reset();
+    }
+
+    std::size_t striped_money_counter::stripes() const noexcept {
+        return _mask + 1;
+    }
+
+    void striped_money_counter::add(mc::currency c, std::int64_t amount) noexcept {
+        stripe& s = _stripes[impl::thread_slot_() & _mask];
+        s.amounts[static_cast<std::size_t>(c)].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    void striped_money_counter::add(const money& m) {
+        if (m.amount() > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+            throw std::overflow_error("amount does not fit into striped_money_counter");
+        }
+        add(m.currency(), static_cast<std::int64_t>(m.amount()));
+    }
+
+    std::int64_t striped_money_counter::amount(mc::currency c) const noexcept {
+        std::int64_t total = 0;
+        for (std::size_t i = 0; i <= _mask; ++i) {
+            total += _stripes[i].amounts[static_cast<std::size_t>(c)].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    money striped_money_counter::load(mc::currency c) const {
+        const std::int64_t total = amount(c);
+        if (total < 0) {
+            throw std::logic_error("negative balance!");
+        }
+        return money::from_amount(c, static_cast<std::uint64_t>(total));
+    }
+
+    void striped_money_counter::reset() noexcept {
+        for (std::size_t i = 0; i <= _mask; ++i) {
+            for (auto& amount : _stripes[i].amounts) {
+                amount.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}
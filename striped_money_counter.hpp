@@ -0,0 +1,100 @@
+/**
+ * @file striped_money_counter.hpp
+ * @brief Contention-free aggregate counter of monetary amounts.
+ *
+ * Hot aggregates such as "total processed today" are incremented by many
+ * threads at once. The striped counter gives every thread its own
+ * cache-line-aligned stripe of per-currency totals, so increments never
+ * bounce a shared cache line between cores; reads sum the stripes.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef STRIPED_MONEY_COUNTER_HPP
+#define STRIPED_MONEY_COUNTER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "money.hpp"
+
+namespace mc {
+
+    namespace impl {
+        /// Slot of the calling thread: the lowest free one on first use, returned when the thread exits
+        std::size_t thread_slot_();
+    }
+
+    /**
+     * @brief Per-currency running totals updated from many threads.
+     *
+     * A thread takes the lowest free slot on first use and returns it when it
+     * exits, so up to stripes() live threads update disjoint cache lines. Reads are not a snapshot:
+     * increments running concurrently with a read may or may not be included.
+     */
+    class striped_money_counter {
+        /// One thread's totals, aligned so that stripes never share a cache line
+        struct alignas(64) stripe {
+            std::atomic<std::int64_t> amounts[max_currency_count];
+        };
+
+        std::unique_ptr<stripe[]> _stripes; ///< Array of stripes, a power of two long
+        std::size_t _mask;                  ///< Number of stripes minus one
+    public:
+        /**
+         * @brief Constructs a counter with all totals at zero.
+         * @param stripes Number of stripes, rounded up to a power of two;
+         *                zero selects the number of hardware threads
+         */
+        explicit striped_money_counter(std::size_t stripes = 0);
+
+        striped_money_counter(const striped_money_counter&) = delete;
+        striped_money_counter& operator=(const striped_money_counter&) = delete;
+
+        /**
+         * @brief Gets the number of stripes.
+         * @return The number of stripes
+         */
+        std::size_t stripes() const noexcept;
+
+        /**
+         * @brief Adds a signed amount of smallest units to a currency total.
+         * @param curr The currency of the amount
+         * @param amount The amount to add, negative to subtract
+         */
+        void add(mc::currency curr, std::int64_t amount) noexcept;
+
+        /**
+         * @brief Adds a money object to its currency total.
+         * @param value The amount to add
+         * @throws std::overflow_error if the amount does not fit into a signed 64-bit value
+         */
+        void add(const money& value);
+
+        /**
+         * @brief Sums the stripes of a currency total.
+         * @param curr The currency of the total
+         * @return The total in smallest currency units
+         */
+        std::int64_t amount(mc::currency curr) const noexcept;
+
+        /**
+         * @brief Sums the stripes of a currency total into a money object.
+         * @param curr The currency of the total
+         * @return The total as a money object
+         * @throws std::logic_error if the total is negative
+         */
+        money load(mc::currency curr) const;
+
+        /**
+         * @brief Resets all totals to zero.
+         *
+         * Increments running concurrently with the reset may survive it.
+         */
+        void reset() noexcept;
+    };
+}
+
+#endif /* STRIPED_MONEY_COUNTER_HPP */
@@ -0,0 +1,184 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "arrow_column.hpp"
+#include "currency.hpp"
+#include "money_column.hpp"
+
+using mc::currency;
+
+namespace {
+    mc::money_column make_column() {
+        mc::money_column column;
+        const currency currencies[] = {currency::USD, currency::EUR, currency::MDL, currency::ZWD};
+        for (std::int64_t i = 0; i < 1000; ++i) {
+            column.push_back(currencies[i % 4], (i - 500) * 12345);
+        }
+        return column;
+    }
+
+    std::string dictionary_code(const ArrowArray& dictionary, std::size_t index) {
+        const std::int32_t* offsets = static_cast<const std::int32_t*>(dictionary.buffers[1]);
+        const char* data = static_cast<const char*>(dictionary.buffers[2]);
+        return std::string(data + offsets[index], data + offsets[index + 1]);
+    }
+}
+
+TEST_CASE("Arrow C Data Interface structures follow the specification", "[arrow]") {
+    // field order and sizes of the ABI, for 64-bit platforms
+    CHECK(offsetof(ArrowSchema, format) == 0);
+    CHECK(offsetof(ArrowSchema, flags) == 3 * sizeof (void*));
+    CHECK(offsetof(ArrowSchema, dictionary) == 6 * sizeof (void*));
+    CHECK(offsetof(ArrowSchema, private_data) == 8 * sizeof (void*));
+    CHECK(sizeof (ArrowSchema) == 9 * sizeof (void*));
+    CHECK(offsetof(ArrowArray, length) == 0);
+    CHECK(offsetof(ArrowArray, buffers) == 40);
+    CHECK(offsetof(ArrowArray, release) == 40 + 3 * sizeof (void*));
+    CHECK(sizeof (ArrowArray) == 40 + 5 * sizeof (void*));
+}
+
+TEST_CASE("Money columns are exported without copying", "[arrow]") {
+    mc::money_column column = make_column();
+    const std::int64_t* amounts = column.amounts();
+    const std::uint8_t* currencies = column.currencies();
+    ArrowSchema schema;
+    ArrowArray array;
+    mc::export_arrow(std::move(column), &schema, &array);
+
+    CHECK(std::string(schema.format) == "+s");
+    REQUIRE(schema.n_children == 2);
+    CHECK(std::string(schema.children[0]->name) == "amount");
+    CHECK(std::string(schema.children[0]->format) == "l");
+    CHECK(std::string(schema.children[1]->name) == "currency");
+    CHECK(std::string(schema.children[1]->format) == "C");
+    REQUIRE(schema.children[1]->dictionary != nullptr);
+    CHECK(std::string(schema.children[1]->dictionary->format) == "u");
+
+    CHECK(array.length == 1000);
+    CHECK(array.null_count == 0);
+    CHECK(array.n_buffers == 1);
+    CHECK(array.buffers[0] == nullptr);
+    REQUIRE(array.n_children == 2);
+    const ArrowArray& amount_data = *array.children[0];
+    CHECK(amount_data.length == 1000);
+    CHECK(amount_data.n_buffers == 2);
+    CHECK(amount_data.buffers[1] == amounts);
+    const ArrowArray& currency_data = *array.children[1];
+    CHECK(currency_data.buffers[1] == currencies);
+    REQUIRE(currency_data.dictionary != nullptr);
+    CHECK(currency_data.dictionary->length == static_cast<std::int64_t>(mc::known_currency_count()));
+    CHECK(dictionary_code(*currency_data.dictionary, static_cast<std::size_t>(currency::USD)) == "USD");
+    CHECK(dictionary_code(*currency_data.dictionary, static_cast<std::size_t>(currency::ZWD)) == "ZWD");
+    CHECK(static_cast<const std::int64_t*>(amount_data.buffers[1])[3] == -497 * 12345);
+
+    SECTION("Children outlive their released parent") {
+        ArrowArray moved = *array.children[1];
+        array.children[1]->release = nullptr;
+        array.release(&array);
+        CHECK(array.release == nullptr);
+        CHECK(static_cast<const std::uint8_t*>(moved.buffers[1])[2] == static_cast<std::uint8_t>(currency::MDL));
+        CHECK(dictionary_code(*moved.dictionary, static_cast<std::size_t>(currency::EUR)) == "EUR");
+        moved.release(&moved);
+        CHECK(moved.release == nullptr);
+        schema.release(&schema);
+        CHECK(schema.release == nullptr);
+    }
+
+    SECTION("Import reads the exported buffers in place") {
+        mc::arrow_column imported(&schema, &array);
+        CHECK(schema.release == nullptr);
+        CHECK(array.release == nullptr);
+        REQUIRE(imported.size() == 1000);
+        CHECK(imported.amounts() == amounts);
+        CHECK(imported.currencies() == currencies);
+        CHECK(imported.currency(3) == currency::ZWD);
+        mc::money_column copy;
+        imported.to_column(copy);
+        CHECK(copy == make_column());
+    }
+}
+
+TEST_CASE("Decimal amounts and foreign dictionaries are converted on import", "[arrow]") {
+    SECTION("decimal128 round trip") {
+        ArrowSchema schema;
+        ArrowArray array;
+        mc::export_arrow(make_column(), &schema, &array, mc::arrow_amount::decimal128);
+        CHECK(std::string(schema.children[0]->format) == "d:19,2");
+        const std::uint64_t* words = static_cast<const std::uint64_t*>(array.children[0]->buffers[1]);
+        CHECK(words[0] == static_cast<std::uint64_t>(-500 * 12345));
+        CHECK(words[1] == ~std::uint64_t(0));
+        CHECK(words[1000 * 2 - 1] == 0);
+
+        mc::arrow_column imported(&schema, &array);
+        mc::money_column copy;
+        imported.to_column(copy);
+        CHECK(copy == make_column());
+    }
+
+    // a struct array as an Arrow library would build it: int32 indices into its own dictionary
+    const char* codes = "eurUSDMDLGBP";
+    const std::int32_t code_offsets[] = {0, 3, 6, 9, 12};
+    const std::int32_t indices[] = {0, 2, 1, 1, 0};
+    const std::int64_t amounts[] = {100, -200, 300, 400, 500};
+    const void* dictionary_buffers[] = {nullptr, code_offsets, codes};
+    const void* index_buffers[] = {nullptr, indices};
+    const void* amount_buffers[] = {nullptr, amounts};
+    const void* root_buffers[] = {nullptr};
+
+    static int released;
+    released = 0;
+    auto release_array = [](ArrowArray* a) { ++released; a->release = nullptr; };
+    auto release_schema = [](ArrowSchema* s) { ++released; s->release = nullptr; };
+
+    ArrowArray dictionary{3, 0, 1, 3, 0, dictionary_buffers, nullptr, nullptr, release_array, nullptr};
+    ArrowArray currency_data{5, 0, 0, 2, 0, index_buffers, nullptr, &dictionary, release_array, nullptr};
+    ArrowArray amount_data{5, 0, 0, 2, 0, amount_buffers, nullptr, nullptr, release_array, nullptr};
+    ArrowArray* children[] = {&currency_data, &amount_data};
+    ArrowArray array{4, 0, 1, 1, 2, root_buffers, children, nullptr, release_array, nullptr};
+
+    ArrowSchema code_type{"u", nullptr, nullptr, 0, 0, nullptr, nullptr, release_schema, nullptr};
+    ArrowSchema index_type{"i", "currency", nullptr, 0, 0, nullptr, &code_type, release_schema, nullptr};
+    ArrowSchema amount_type{"l", "amount", nullptr, 0, 0, nullptr, nullptr, release_schema, nullptr};
+    ArrowSchema* types[] = {&index_type, &amount_type};
+    ArrowSchema schema{"+s", nullptr, nullptr, 0, 2, types, nullptr, release_schema, nullptr};
+
+    SECTION("int32 indices into a foreign dictionary, with offsets") {
+        {
+            mc::arrow_column imported(&schema, &array);
+            REQUIRE(imported.size() == 4);
+            CHECK(imported.amounts() == amounts + 1);
+            // dictionary offset 1 leaves USD, MDL, GBP, and index 0 is USD
+            CHECK(imported.currency(0) == currency::GBP);
+            CHECK(imported.currency(1) == currency::MDL);
+            CHECK(imported.currency(3) == currency::USD);
+            CHECK(imported.amount(3) == 500);
+        }
+        CHECK(released == 2);
+    }
+
+    SECTION("Invalid layouts are released and rejected") {
+        const std::int32_t bad_indices[] = {0, 2, 7, 1, 0};
+        index_buffers[1] = bad_indices;
+        CHECK_THROWS_AS(mc::arrow_column(&schema, &array), std::invalid_argument);
+        CHECK(released == 2);
+        CHECK(array.release == nullptr);
+
+        array.release = release_array;
+        schema.release = release_schema;
+        index_buffers[1] = indices;
+        amount_type.format = "d:10,4";
+        CHECK_THROWS_AS(mc::arrow_column(&schema, &array), std::invalid_argument);
+
+        array.release = release_array;
+        schema.release = release_schema;
+        amount_type.format = "l";
+        const std::uint8_t validity[] = {0x1f};
+        amount_buffers[0] = validity;
+        amount_data.null_count = 1;
+        CHECK_THROWS_AS(mc::arrow_column(&schema, &array), std::invalid_argument);
+    }
+}
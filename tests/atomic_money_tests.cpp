@@ -0,0 +1,130 @@
+#include <catch2/catch_all.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "atomic_money.hpp"
+#include "currency.hpp"
+#include "money.hpp"
+
+using mc::atomic_money;
+using mc::currency;
+using mc::money;
+
+TEST_CASE("atomic_money basic operations", "[atomic_money]") {
+
+    SECTION("Zero balance") {
+        atomic_money balance(currency::USD);
+        REQUIRE(balance.currency() == currency::USD);
+        REQUIRE(balance.amount() == 0);
+        REQUIRE(balance.load() == money(currency::USD));
+    }
+
+    SECTION("Initial balance from money") {
+        atomic_money balance(money(currency::EUR, 12.34));
+        REQUIRE(balance.currency() == currency::EUR);
+        REQUIRE(balance.amount() == 1234);
+        REQUIRE(balance.load() == money::from_amount(currency::EUR, 1234));
+    }
+
+    SECTION("fetch_add returns the previous balance") {
+        atomic_money balance(currency::USD);
+        REQUIRE(balance.fetch_add(500) == 0);
+        REQUIRE(balance.fetch_add(money(currency::USD, 1.5)) == 500);
+        REQUIRE(balance.fetch_add(-150) == 650);
+        REQUIRE(balance.amount() == 500);
+    }
+
+    SECTION("Incompatible currencies") {
+        atomic_money balance(currency::USD);
+        REQUIRE_THROWS_AS(balance.fetch_add(money(currency::EUR, 1)), std::logic_error);
+        REQUIRE_THROWS_AS(balance.try_debit(money(currency::EUR, 1)), std::logic_error);
+    }
+
+    SECTION("Amounts beyond the signed range") {
+        REQUIRE_THROWS_AS(atomic_money(money::from_amount(currency::USD, UINT64_MAX)), std::overflow_error);
+
+        atomic_money balance(money::from_amount(currency::USD, 100));
+        REQUIRE_THROWS_AS(balance.fetch_add(money::from_amount(currency::USD, UINT64_MAX)), std::overflow_error);
+        REQUIRE(balance.amount() == 100);
+    }
+}
+
+TEST_CASE("atomic_money::try_debit respects the floor", "[atomic_money][debit]") {
+    atomic_money balance(money::from_amount(currency::USD, 1000));
+
+    SECTION("Debit down to zero") {
+        REQUIRE(balance.try_debit(400));
+        REQUIRE(balance.try_debit(money::from_amount(currency::USD, 600)));
+        REQUIRE(balance.amount() == 0);
+        REQUIRE_FALSE(balance.try_debit(1));
+        REQUIRE(balance.amount() == 0);
+    }
+
+    SECTION("Insufficient funds leave the balance unchanged") {
+        REQUIRE_FALSE(balance.try_debit(1001));
+        REQUIRE_FALSE(balance.try_debit(UINT64_MAX));
+        REQUIRE(balance.amount() == 1000);
+    }
+
+    SECTION("Minimum balance") {
+        REQUIRE_FALSE(balance.try_debit(901, 100));
+        REQUIRE(balance.try_debit(900, 100));
+        REQUIRE(balance.amount() == 100);
+    }
+
+    SECTION("Overdraft limit") {
+        REQUIRE(balance.try_debit(1500, -500));
+        REQUIRE(balance.amount() == -500);
+        REQUIRE_FALSE(balance.try_debit(1, -500));
+        REQUIRE_THROWS_AS(balance.load(), std::logic_error);
+        REQUIRE(balance.try_debit(0, INT64_MIN));
+    }
+}
+
+TEST_CASE("atomic_money under concurrency", "[atomic_money][concurrency]") {
+    const int threads = 8;
+    const int operations = 20000;
+
+    SECTION("Concurrent fetch_add loses no updates") {
+        atomic_money balance(currency::USD);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                for (int i = 0; i < operations; ++i) {
+                    balance.fetch_add(3);
+                }
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+        REQUIRE(balance.amount() == 3LL * threads * operations);
+    }
+
+    SECTION("Concurrent debits never overdraw") {
+        const std::int64_t initial = 10000;
+        atomic_money balance(money::from_amount(currency::USD, initial));
+        std::vector<std::int64_t> debited(threads, 0);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                for (int i = 0; i < operations; ++i) {
+                    if (balance.try_debit(7)) {
+                        debited[t] += 7;
+                    }
+                }
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+        std::int64_t total = 0;
+        for (auto d : debited) {
+            total += d;
+        }
+        REQUIRE(balance.amount() >= 0);
+        REQUIRE(balance.amount() < 7);
+        REQUIRE(total + balance.amount() == initial);
+    }
+}
@@ -0,0 +1,147 @@
+#include <catch2/catch_all.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "balance_snapshot.hpp"
+#include "currency.hpp"
+#include "ledger.hpp"
+#include "money.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using mc::currency;
+using mc::leg;
+using mc::money;
+
+namespace {
+    /// Opens accounts alternating between two currencies and moves funds between neighbours
+    mc::ledger make_ledger(std::size_t accounts, std::int64_t amount) {
+        mc::ledger book;
+        for (std::size_t i = 0; i < accounts; ++i) {
+            book.open_account(i % 2 == 0 ? currency::USD : currency::MDL);
+        }
+        mc::journal_batch batch;
+        for (mc::account_id a = 0; a + 2 < accounts; a += 2) {
+            batch.add({{a, currency::USD, amount}, {a + 2, currency::USD, -amount}});
+            batch.add({{a + 1, currency::MDL, amount * 3}, {a + 3, currency::MDL, -amount * 3}});
+        }
+        book.post(batch);
+        return book;
+    }
+
+    bool same_balances(const mc::balance_snapshot& snapshot, const mc::ledger& book) {
+        if (snapshot.size() != book.size()) {
+            return false;
+        }
+        for (mc::account_id a = 0; a < book.size(); ++a) {
+            if (snapshot.balance(a) != book.balance(a) || snapshot.currency(a) != book.currency(a)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST_CASE("balance_snapshot checkpoints ledger balances", "[snapshot]") {
+    const std::string path = "money_tests_snapshot.bin";
+    std::remove(path.c_str());
+    const mc::ledger book = make_ledger(1001, 250);
+
+    SECTION("Write, map and restore") {
+        mc::balance_snapshot::write(path, book, 42);
+        const mc::balance_snapshot snapshot(path);
+        REQUIRE(snapshot.journal_sequence() == 42);
+        REQUIRE(same_balances(snapshot, book));
+        REQUIRE(snapshot.records()[1].amount == 750);
+        REQUIRE_THROWS_AS(snapshot.balance(1001), std::out_of_range);
+
+        mc::ledger restored;
+        snapshot.restore(restored);
+        REQUIRE(restored.size() == book.size());
+        REQUIRE(restored.balance(998) == book.balance(998));
+        REQUIRE(restored.currency(999) == currency::MDL);
+        REQUIRE(restored.trial_balance().is_zero());
+        REQUIRE_THROWS_AS(snapshot.restore(restored), std::logic_error);
+    }
+
+    SECTION("A new checkpoint replaces the previous one") {
+        mc::balance_snapshot::write(path, book, 1);
+        mc::balance_snapshot::write(path, make_ledger(10, 1), 2);
+        const mc::balance_snapshot snapshot(path);
+        REQUIRE(snapshot.size() == 10);
+        REQUIRE(snapshot.journal_sequence() == 2);
+        std::ifstream shadow(path + ".tmp");
+        REQUIRE_FALSE(shadow.good());
+    }
+
+    SECTION("Damaged files are rejected") {
+        mc::balance_snapshot::write(path, book);
+        {
+            std::ofstream fout(path, std::ios::binary | std::ios::app);
+            fout << "x";
+        }
+        REQUIRE_THROWS_AS(mc::balance_snapshot(path), std::runtime_error);
+        {
+            std::ofstream fout(path, std::ios::binary | std::ios::trunc);
+            fout << "not a snapshot at all, but long enough to hold a snapshot header......";
+        }
+        REQUIRE_THROWS_AS(mc::balance_snapshot(path), std::runtime_error);
+    }
+
+    SECTION("Records with unknown currencies are not restored") {
+        mc::balance_snapshot::write(path, make_ledger(10, 1));
+        {
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(sizeof (mc::snapshot_header) + 5 * sizeof (mc::snapshot_record) + offsetof(mc::snapshot_record, currency));
+            file.put(static_cast<char>(mc::known_currency_count()));
+        }
+        const mc::balance_snapshot snapshot(path);
+        mc::ledger restored;
+        REQUIRE_THROWS_AS(snapshot.restore(restored), std::runtime_error);
+        REQUIRE(restored.size() == 0);
+    }
+
+    std::remove(path.c_str());
+    REQUIRE_THROWS_AS(mc::balance_snapshot(path), std::runtime_error);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST_CASE("A writer killed mid-checkpoint leaves a complete snapshot", "[snapshot]") {
+    const std::string path = "money_tests_snapshot_crash.bin";
+    const mc::ledger first = make_ledger(200000, 7);
+    const mc::ledger second = make_ledger(300000, 11);
+    mc::balance_snapshot::write(path, first, 1);
+
+    for (int round = 0; round < 8; ++round) {
+        const pid_t child = ::fork();
+        REQUIRE(child >= 0);
+        if (child == 0) {
+            // checkpoint forever, alternating between the two ledgers
+            for (std::uint64_t i = 0;; ++i) {
+                mc::balance_snapshot::write(path, i % 2 == 0 ? second : first, i % 2 == 0 ? 2 : 1);
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(3 + 7 * round));
+        ::kill(child, SIGKILL);
+        int status = 0;
+        ::waitpid(child, &status, 0);
+        REQUIRE(WIFSIGNALED(status));
+
+        const mc::balance_snapshot snapshot(path);
+        REQUIRE((snapshot.journal_sequence() == 1 || snapshot.journal_sequence() == 2));
+        REQUIRE(same_balances(snapshot, snapshot.journal_sequence() == 1 ? first : second));
+    }
+    std::remove(path.c_str());
+    std::remove((path + ".tmp").c_str());
+}
+#endif
@@ -0,0 +1,194 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "column_file.hpp"
+#include "currency.hpp"
+#include "money.hpp"
+#include "money_column.hpp"
+
+using mc::currency;
+using mc::money;
+
+namespace {
+    /// Sorted-ish transaction amounts in runs of USD and EUR, with a few large EUR payments
+    mc::money_column make_column(std::size_t count) {
+        mc::money_column column;
+        std::uint64_t state = 88172645463325252ULL;
+        for (std::size_t i = 0; i < count; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            const currency c = (i / 1000) % 3 == 0 ? currency::EUR : currency::USD;
+            std::int64_t amount = static_cast<std::int64_t>(state % 500000) - 1000;
+            if (c == currency::EUR && i / 10000 == 4 && i % 97 == 0) {
+                amount = 2000000 + static_cast<std::int64_t>(i);
+            }
+            column.push_back(c, amount);
+        }
+        return column;
+    }
+}
+
+TEST_CASE("money_column stores amounts and currencies", "[column]") {
+    mc::money_column column;
+    CHECK(column.empty());
+    column.push_back(money::from_amount(currency::USD, 12345));
+    column.push_back(currency::MDL, -50);
+    REQUIRE(column.size() == 2);
+    CHECK(column.amount(0) == 12345);
+    CHECK(column.currency(1) == currency::MDL);
+    CHECK(column.amounts()[1] == -50);
+    CHECK(column.at(0) == money::from_amount(currency::USD, 12345));
+    CHECK_THROWS_AS(column.at(1), std::logic_error);
+    CHECK_THROWS_AS(column.at(2), std::out_of_range);
+    CHECK_THROWS_AS(column.push_back(money::from_amount(currency::USD, ~std::uint64_t(0))), std::overflow_error);
+}
+
+TEST_CASE("column_file round trip and zone maps", "[column]") {
+    const std::string path = "money_tests_column.bin";
+    std::remove(path.c_str());
+
+    SECTION("Round trip of mixed data") {
+        const mc::money_column column = make_column(100000);
+        mc::write_column_file(path, column, 10000);
+        const mc::column_file file(path);
+        CHECK(file.size() == column.size());
+        CHECK(file.blocks() == 10);
+        mc::money_column read;
+        file.read(read);
+        CHECK(read == column);
+        CHECK_THROWS_AS(file.block(10), std::out_of_range);
+    }
+
+    SECTION("Encodings follow the data") {
+        mc::money_column column;
+        // block 0: one currency, increasing amounts, so deltas are narrower
+        for (std::int64_t i = 0; i < 1000; ++i) {
+            column.push_back(currency::USD, 1000000 + i * 3);
+        }
+        // block 1: long runs of currencies and scattered amounts
+        for (std::int64_t i = 0; i < 1000; ++i) {
+            column.push_back(i < 500 ? currency::EUR : currency::MDL, (i * 7919) % 1000 - 500);
+        }
+        // block 2: alternating currencies, stored with a dictionary
+        for (std::int64_t i = 0; i < 1000; ++i) {
+            const currency c[] = {currency::USD, currency::EUR, currency::GBP};
+            column.push_back(c[i % 3], std::numeric_limits<std::int64_t>::max() - i);
+        }
+        column.push_back(currency::JPY, std::numeric_limits<std::int64_t>::min());
+        mc::write_column_file(path, column, 1000);
+        const mc::column_file file(path);
+        REQUIRE(file.blocks() == 4);
+
+        const mc::column_block first = file.block(0);
+        CHECK(first.amount_encoding == 1);
+        CHECK(first.amount_width == 3);
+        CHECK(first.currency_encoding == 0);
+        CHECK(first.min_amount == 1000000);
+        CHECK(first.max_amount == 1002997);
+        CHECK(first.contains(currency::USD));
+        CHECK_FALSE(first.contains(currency::EUR));
+
+        const mc::column_block second = file.block(1);
+        CHECK(second.amount_encoding == 0);
+        CHECK(second.currency_encoding == 1);
+        CHECK(second.currency_entries == 2);
+        CHECK(second.min_amount == -500);
+
+        const mc::column_block third = file.block(2);
+        CHECK(third.currency_encoding == 2);
+        CHECK(third.currency_entries == 3);
+        CHECK(third.currency_width == 2);
+        CHECK(third.max_amount == std::numeric_limits<std::int64_t>::max());
+
+        CHECK(file.block(3).rows == 1);
+
+        mc::money_column read;
+        file.read(read);
+        CHECK(read == column);
+    }
+
+    SECTION("Scans skip blocks outside the filter") {
+        const mc::money_column column = make_column(100000);
+        mc::write_column_file(path, column, 10000);
+        const mc::column_file file(path);
+
+        // EUR amounts above 10,000.00
+        mc::column_filter filter;
+        filter.match_currency = true;
+        filter.currency = currency::EUR;
+        filter.min_amount = 1000001;
+        mc::money_column found;
+        std::size_t skipped = 0;
+        const std::size_t matches = file.scan(filter, found, &skipped);
+
+        mc::money_column expected;
+        for (std::size_t i = 0; i < column.size(); ++i) {
+            if (column.currency(i) == currency::EUR && column.amount(i) >= filter.min_amount) {
+                expected.push_back(column.currency(i), column.amount(i));
+            }
+        }
+        CHECK(matches == expected.size());
+        CHECK(found == expected);
+        CHECK(matches > 0);
+        CHECK(skipped == 9);
+
+        mc::money_column all;
+        CHECK(file.scan(mc::column_filter{}, all, &skipped) == column.size());
+        CHECK(skipped == 0);
+        CHECK(all == column);
+
+        mc::column_filter absent;
+        absent.match_currency = true;
+        absent.currency = currency::JPY;
+        mc::money_column none;
+        CHECK(file.scan(absent, none, &skipped) == 0);
+        CHECK(skipped == 10);
+    }
+
+    SECTION("Empty column") {
+        mc::write_column_file(path, mc::money_column{});
+        const mc::column_file file(path);
+        CHECK(file.size() == 0);
+        CHECK(file.blocks() == 0);
+        mc::money_column read;
+        file.read(read);
+        CHECK(read.empty());
+        CHECK_THROWS_AS(mc::write_column_file(path, read, 0), std::invalid_argument);
+    }
+
+    SECTION("Corrupt files are rejected") {
+        mc::write_column_file(path, make_column(5000), 1000);
+        std::vector<char> bytes;
+        {
+            std::ifstream in(path, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        // a block header claiming more rows than it stores
+        std::vector<char> damaged = bytes;
+        const std::size_t first_block = sizeof (mc::column_file_header);
+        damaged[first_block + 6] = 2;
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(damaged.data(), damaged.size());
+        }
+        {
+            const mc::column_file file(path);
+            mc::money_column read;
+            CHECK_THROWS_AS(file.read(read), std::runtime_error);
+        }
+
+        // a truncated block directory
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(bytes.data(), bytes.size() - 4);
+        }
+        CHECK_THROWS_AS(mc::column_file(path), std::runtime_error);
+    }
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,148 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "csv_reader.hpp"
+#include "currency.hpp"
+#include "money_column.hpp"
+
+using mc::currency;
+
+namespace {
+    void write_file(const std::string& path, const std::string& contents) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << contents;
+    }
+
+    /// Rows with ids 0..count-1, varied amount formats and three currencies
+    std::string make_csv(std::size_t count, mc::money_column& expected) {
+        const char* codes[] = {"USD", "eur", "MDL"};
+        const currency currencies[] = {currency::USD, currency::EUR, currency::MDL};
+        std::string text = "id,amount,currency\n";
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::int64_t whole = static_cast<std::int64_t>(i * 7919 % 100000);
+            std::int64_t amount = whole * 100;
+            std::string formatted = std::to_string(whole);
+            switch (i % 4) {
+                case 1:
+                    formatted += "." + std::to_string(i % 10);
+                    amount += static_cast<std::int64_t>(i % 10) * 10;
+                    break;
+                case 2:
+                    formatted += "." + std::to_string(10 + i % 90);
+                    amount += static_cast<std::int64_t>(10 + i % 90);
+                    break;
+                case 3:
+                    formatted = "-" + formatted + ".05";
+                    amount = -(amount + 5);
+                    break;
+            }
+            text += std::to_string(i) + "," + formatted + "," + codes[i % 3] + (i % 5 == 0 ? "\r\n" : "\n");
+            expected.push_back(currencies[i % 3], amount);
+        }
+        return text;
+    }
+}
+
+TEST_CASE("csv_reader parses rows exactly", "[csv]") {
+    const std::string path = "money_tests_rows.csv";
+
+    SECTION("Chunks cover all rows in order") {
+        mc::money_column expected;
+        write_file(path, make_csv(10000, expected));
+        mc::csv_reader reader(path, 0, 1, 3000);
+        mc::csv_chunk chunk;
+        mc::csv_chunk all;
+        std::vector<std::size_t> sizes;
+        while (reader.next(chunk)) {
+            sizes.push_back(chunk.ids.size());
+            all.ids.insert(all.ids.end(), chunk.ids.begin(), chunk.ids.end());
+            for (std::size_t i = 0; i < chunk.values.size(); ++i) {
+                all.values.push_back(chunk.values.currency(i), chunk.values.amount(i));
+            }
+        }
+        CHECK(sizes == std::vector<std::size_t>{3000, 3000, 3000, 1000});
+        CHECK(all.values == expected);
+        REQUIRE(all.ids.size() == 10000);
+        CHECK(all.ids[9999] == 9999);
+        CHECK_FALSE(reader.next(chunk));
+    }
+
+    SECTION("Parts split at line boundaries") {
+        mc::money_column expected;
+        write_file(path, make_csv(5000, expected));
+        for (std::size_t parts : {2, 3, 7, 64}) {
+            mc::csv_chunk all;
+            for (std::size_t p = 0; p < parts; ++p) {
+                mc::csv_reader reader(path, p, parts);
+                reader.read_all(all);
+            }
+            CHECK(all.values == expected);
+            mc::csv_chunk parallel;
+            CHECK(mc::read_csv(path, parallel, parts) == 5000);
+            CHECK(parallel.values == expected);
+            CHECK(parallel.ids == all.ids);
+        }
+    }
+
+    SECTION("Edge cases of the format") {
+        // the same rows far from the end of the file and at its end
+        const std::string rows = "18446744073709551615,9999999999999999.99,EUR\n1,0.5,usd\n\n2,-0,JPY\r\n\r\n"
+                "3,-123456789012345.6,GBP\n";
+        for (const std::string& text : {rows + std::string(100, '\n'), rows.substr(0, rows.size() - 1)}) {
+            write_file(path, text);
+            mc::csv_chunk chunk;
+            REQUIRE(mc::read_csv(path, chunk, 1) == 4);
+            CHECK(chunk.ids[0] == 18446744073709551615ULL);
+            CHECK(chunk.values.amount(0) == 999999999999999999);
+            CHECK(chunk.values.amount(1) == 50);
+            CHECK(chunk.values.currency(1) == currency::USD);
+            CHECK(chunk.values.amount(2) == 0);
+            CHECK(chunk.values.currency(2) == currency::JPY);
+            CHECK(chunk.ids[3] == 3);
+            CHECK(chunk.values.amount(3) == -12345678901234560);
+        }
+
+        write_file(path, "");
+        mc::csv_chunk chunk;
+        CHECK(mc::read_csv(path, chunk, 2) == 0);
+    }
+
+    SECTION("Malformed rows are reported") {
+        const char* rows[] = {
+            "1,12.345,USD\n",
+            "1,12.,USD\n",
+            "1,1.2.3,USD\n",
+            "1,,USD\n",
+            "1,12,USDX\n",
+            "1,12,ABC\n",
+            "1,12\n",
+            "1,2,3,USD\n",
+            "x1,12,USD\n",
+            "1,12345678901234567,USD\n",
+            "184467440737095516150,1,USD\n",
+            "18446744073709551616,1,USD\n"
+        };
+        for (const char* row : rows) {
+            for (const std::string& tail : {std::string(), std::string(100, '\n')}) {
+                write_file(path, std::string("5,1.00,USD\n") + row + tail);
+                mc::csv_chunk chunk;
+                CHECK_THROWS_AS(mc::read_csv(path, chunk, 1), std::invalid_argument);
+            }
+        }
+        write_file(path, "5,1.00,USD\n6,1.00,ABC\n");
+        try {
+            mc::csv_chunk chunk;
+            mc::read_csv(path, chunk, 2);
+            FAIL("expected an exception");
+        } catch (const std::invalid_argument& e) {
+            CHECK(std::string(e.what()) == "malformed csv row at byte 11");
+        }
+        CHECK_THROWS_AS(mc::csv_reader(path, 2, 2), std::invalid_argument);
+    }
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,86 @@
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <vector>
+
+#include "currency.hpp"
+#include "currency_batch.hpp"
+
+using mc::currency;
+
+namespace {
+    /// Reference result of one code through find_currency()
+    std::uint8_t expected_index(const char* code) {
+        currency c;
+        return mc::find_currency(std::string_view(code, 3), c) ? static_cast<std::uint8_t>(c) : mc::invalid_currency;
+    }
+
+    void check_batch(const std::vector<char>& codes, std::size_t stride) {
+        const std::size_t n = codes.size() / stride;
+        std::vector<std::uint8_t> simd(n);
+        std::vector<std::uint8_t> scalar(n);
+        std::vector<mc::bitmask> simd_invalid((n + 63) / 64, ~mc::bitmask(0));
+        std::vector<mc::bitmask> scalar_invalid((n + 63) / 64, ~mc::bitmask(0));
+        const std::size_t failed = mc::to_currency_batch(codes.data(), stride, n, simd.data(), simd_invalid.data());
+        CHECK(mc::to_currency_batch_scalar(codes.data(), stride, n, scalar.data(), scalar_invalid.data()) == failed);
+        CHECK(simd == scalar);
+        CHECK(simd_invalid == scalar_invalid);
+
+        std::size_t expected_failed = 0;
+        bool same = true;
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::uint8_t expected = expected_index(codes.data() + i * stride);
+            const bool flagged = (simd_invalid[i / 64] >> (i % 64)) & 1;
+            same = same && simd[i] == expected && flagged == (expected == mc::invalid_currency);
+            expected_failed += expected == mc::invalid_currency;
+        }
+        CHECK(same);
+        CHECK(failed == expected_failed);
+    }
+}
+
+TEST_CASE("Batch conversion resolves every ISO code", "[currency_batch]") {
+    std::vector<char> codes;
+    for (std::size_t i = 0; i < mc::currency_count; ++i) {
+        const std::string_view code = mc::to_code(static_cast<currency>(i));
+        codes.insert(codes.end(), code.begin(), code.end());
+    }
+    std::vector<std::uint8_t> out(mc::currency_count);
+    CHECK(mc::to_currency_batch(codes.data(), 3, mc::currency_count, out.data(), nullptr) == 0);
+    for (std::size_t i = 0; i < mc::currency_count; ++i) {
+        CHECK(out[i] == i);
+    }
+    check_batch(codes, 3);
+}
+
+TEST_CASE("Batch conversion matches the scalar path and find_currency", "[currency_batch]") {
+    std::uint64_t state = 88172645463325252ULL;
+    const auto next = [&state] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz@[`{ 0\xC1\xE1";
+
+    for (std::size_t stride : {3, 4, 7, 16}) {
+        for (std::size_t n : {0, 1, 15, 16, 17, 63, 64, 65, 1000}) {
+            std::vector<char> codes(n * stride, ',');
+            for (std::size_t i = 0; i < n; ++i) {
+                if (next() % 2 == 0) {
+                    // a valid code in mixed case
+                    const std::string_view code = mc::to_code(static_cast<currency>(next() % mc::currency_count));
+                    for (std::size_t k = 0; k < 3; ++k) {
+                        codes[i * stride + k] = next() % 2 == 0 ? code[k] : static_cast<char>(code[k] | 0x20);
+                    }
+                } else {
+                    for (std::size_t k = 0; k < 3; ++k) {
+                        codes[i * stride + k] = alphabet[next() % (sizeof (alphabet) - 1)];
+                    }
+                }
+            }
+            CAPTURE(stride, n);
+            check_batch(codes, stride);
+        }
+    }
+}
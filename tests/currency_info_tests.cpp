@@ -0,0 +1,53 @@
+#include <catch2/catch_all.hpp>
+
+#include <set>
+
+#include "currency.hpp"
+#include "currency_info.hpp"
+
+using mc::currency;
+
+static_assert(mc::to_numeric(currency::USD) == 840, "info is usable in constant expressions");
+
+TEST_CASE("Currency info of well-known currencies", "[currency_info]") {
+    CHECK(mc::to_numeric(currency::EUR) == 978);
+    CHECK(mc::to_numeric(currency::ALL) == 8);
+    CHECK(mc::to_numeric(currency::GGP) == 0);
+    CHECK(mc::minor_units(currency::USD) == 2);
+    CHECK(mc::minor_units(currency::JPY) == 0);
+    CHECK(mc::minor_units(currency::KWD) == 3);
+    CHECK(mc::peg(currency::XOF) == currency::EUR);
+    CHECK(mc::peg(currency::HKD) == currency::USD);
+    CHECK(mc::peg(currency::USD) == currency::USD);
+    CHECK(mc::symbol(currency::USD) == "$");
+    CHECK(mc::symbol(currency::EUR) == "\xE2\x82\xAC");
+}
+
+TEST_CASE("Currency info matches the enumeration", "[currency_info]") {
+    std::set<std::uint16_t> numerics;
+    for (std::size_t i = 0; i < mc::currency_count; ++i) {
+        const currency c = static_cast<currency>(i);
+        const mc::currency_info& record = mc::info(c);
+        CAPTURE(mc::to_code(c));
+        CHECK(std::string_view(record.code, 3) == mc::to_code(c));
+        CHECK(record.minor_units <= 3);
+        CHECK(record.peg < mc::currency_count);
+        CHECK_FALSE(mc::symbol(c).empty());
+        if (record.numeric != 0) {
+            CHECK(numerics.insert(record.numeric).second);
+            currency found = currency::AED;
+            CHECK(mc::from_numeric(record.numeric, found));
+            CHECK(found == c);
+        }
+    }
+}
+
+TEST_CASE("Unknown numeric codes", "[currency_info]") {
+    currency found = currency::USD;
+    CHECK_FALSE(mc::from_numeric(0, found));
+    CHECK_FALSE(mc::from_numeric(1, found));
+    CHECK_FALSE(mc::from_numeric(999, found));
+    CHECK_FALSE(mc::from_numeric(1000, found));
+    CHECK_FALSE(mc::from_numeric(65535, found));
+    CHECK(found == currency::USD);
+}
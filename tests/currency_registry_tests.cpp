@@ -0,0 +1,123 @@
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "currency.hpp"
+#include "currency_batch.hpp"
+#include "currency_info.hpp"
+#include "money.hpp"
+#include "money_bag.hpp"
+#include "money_json.hpp"
+#include "rate_table.hpp"
+
+using mc::currency;
+using mc::money;
+
+TEST_CASE("Registered units are found by every lookup", "[registry]") {
+    const std::size_t known = mc::known_currency_count();
+    const currency points = mc::register_currency({"qpt", "Quest Points", "qp", 0});
+    CHECK(static_cast<std::size_t>(points) == known);
+    CHECK(mc::known_currency_count() == known + 1);
+
+    currency found = currency::USD;
+    CHECK(mc::find_currency("QPT", found));
+    CHECK(found == points);
+    CHECK(mc::find_currency("qpt", found));
+    CHECK(mc::to_code(points) == "QPT");
+    CHECK(mc::to_shortname(points) == "QPT");
+    CHECK(mc::to_string(points) == "Quest Points");
+    CHECK(mc::to_currency("qpt") == points);
+
+    CHECK(mc::info(points).minor_units == 0);
+    CHECK(mc::info(points).numeric == 0);
+    CHECK(mc::peg(points) == points);
+    CHECK(mc::symbol(points) == "qp");
+    CHECK(std::string_view(mc::info(points).code, 3) == "QPT");
+
+    const currency tokens = mc::register_currency({"QTK", "Quest Tokens", "", 2});
+    CHECK(mc::symbol(tokens) == "QTK");
+    CHECK(mc::info(tokens).minor_units == 2);
+}
+
+TEST_CASE("Registered units work with money and its tables", "[registry]") {
+    const currency credits = mc::register_currency({"QCR", "Quest Credits", ""});
+    const money balance = money::from_amount(credits, 1234);
+    CHECK(balance.to_string() == "12,34 QCR");
+
+    mc::money_bag bag;
+    bag.add(balance);
+    bag.add(money::from_amount(currency::USD, 100));
+    CHECK(bag.amount(credits) == 1234);
+    mc::money_bag total;
+    total += bag;
+    CHECK(total.amount(credits) == 1234);
+    CHECK(total.size() == 2);
+
+    mc::rate_table rates;
+    rates.set(credits, currency::USD, 0.5);
+    CHECK(rates.convert(balance, currency::USD).amount() == 617);
+
+    char json[mc::max_json_size];
+    const std::size_t size = mc::write_json(balance, json, sizeof (json));
+    money parsed(currency::AED);
+    CHECK(mc::read_json(std::string_view(json, size), parsed) == size);
+    CHECK(parsed == balance);
+
+    const char codes[] = "QCRqcrUSDQQQ";
+    std::uint8_t out[4];
+    mc::bitmask invalid[1];
+    CHECK(mc::to_currency_batch(codes, 3, 4, out, invalid) == 1);
+    CHECK(out[0] == static_cast<std::uint8_t>(credits));
+    CHECK(out[1] == static_cast<std::uint8_t>(credits));
+    CHECK(out[2] == static_cast<std::uint8_t>(currency::USD));
+    CHECK(invalid[0] == 8);
+}
+
+TEST_CASE("Invalid registrations", "[registry]") {
+    CHECK_THROWS_AS(mc::register_currency({"USD", "Another Dollar", ""}), std::invalid_argument);
+    CHECK_THROWS_AS(mc::register_currency({"usd", "Another Dollar", ""}), std::invalid_argument);
+    CHECK_THROWS_AS(mc::register_currency({"QP1", "Digits", ""}), std::invalid_argument);
+    CHECK_THROWS_AS(mc::register_currency({"QPTS", "Too Long", ""}), std::invalid_argument);
+    mc::register_currency({"QDU", "Quest Duplicates", ""});
+    CHECK_THROWS_AS(mc::register_currency({"QDU", "Quest Duplicates", ""}), std::invalid_argument);
+
+    currency found = currency::USD;
+    CHECK_FALSE(mc::find_currency("QZZ", found));
+    CHECK(mc::to_code(static_cast<currency>(mc::max_currency_count - 1)).empty());
+    CHECK_THROWS_AS(mc::to_string(static_cast<currency>(mc::max_currency_count - 1)), mc::unknown_currency);
+}
+
+TEST_CASE("Lookups run concurrently with registration", "[registry]") {
+    const char* codes[] = {"QRA", "QRB", "QRC", "QRD", "QRE", "QRF", "QRG", "QRH"};
+    std::atomic<bool> done(false);
+    std::atomic<std::size_t> mismatches(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 2; ++t) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                for (const char* code : codes) {
+                    currency found;
+                    if (mc::find_currency(code, found) && mc::to_code(found) != code) {
+                        ++mismatches;
+                    }
+                }
+            }
+        });
+    }
+    for (const char* code : codes) {
+        mc::register_currency({code, "Quest Unit", ""});
+    }
+    done.store(true);
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    CHECK(mismatches.load() == 0);
+    for (const char* code : codes) {
+        currency found;
+        CHECK(mc::find_currency(code, found));
+    }
+}
@@ -0,0 +1,104 @@
+#include <catch2/catch_all.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include "currency.hpp"
+#include "currency_set.hpp"
+#include "money_column.hpp"
+
+using mc::currency;
+using mc::currency_set;
+
+namespace {
+    constexpr currency_set settled = currency_set::from_codes({"EUR", "USD", "GBP"});
+    static_assert(settled.size() == 3, "sets are built at compile time");
+    static_assert(settled.contains(currency::USD) && !settled.contains(currency::JPY), "membership is constexpr");
+    static_assert(mc::zero_decimal_currencies.contains(currency::JPY), "predefined sets come from the metadata");
+}
+
+TEST_CASE("Currency set membership and iteration", "[currency_set]") {
+    currency_set set{currency::USD, currency::AED, currency::ZWD};
+    CHECK(set.size() == 3);
+    CHECK(set.contains(currency::AED));
+    CHECK_FALSE(set.contains(currency::EUR));
+
+    std::vector<currency> members(set.begin(), set.end());
+    CHECK(members == std::vector<currency>{currency::AED, currency::USD, currency::ZWD});
+
+    set.erase(currency::USD);
+    set.insert(currency::EUR);
+    CHECK(std::vector<currency>(set.begin(), set.end()) == std::vector<currency>{currency::AED, currency::EUR, currency::ZWD});
+
+    const currency_set last{static_cast<currency>(254)};
+    CHECK(std::vector<currency>(last.begin(), last.end()) == std::vector<currency>{static_cast<currency>(254)});
+
+    const currency_set none;
+    CHECK(none.empty());
+    CHECK(none.begin() == none.end());
+}
+
+TEST_CASE("Currency set algebra", "[currency_set]") {
+    const currency_set a{currency::USD, currency::EUR, currency::GBP};
+    const currency_set b{currency::EUR, currency::JPY};
+    CHECK((a | b) == currency_set{currency::USD, currency::EUR, currency::GBP, currency::JPY});
+    CHECK((a & b) == currency_set{currency::EUR});
+    CHECK((a - b) == currency_set{currency::USD, currency::GBP});
+    CHECK((a ^ b) == currency_set{currency::USD, currency::GBP, currency::JPY});
+
+    currency_set c = a;
+    c -= b;
+    c |= currency_set{currency::CHF};
+    CHECK(c == currency_set{currency::USD, currency::GBP, currency::CHF});
+    CHECK(c != a);
+}
+
+TEST_CASE("Currency sets from codes", "[currency_set]") {
+    CHECK(settled == currency_set{currency::EUR, currency::USD, currency::GBP});
+    CHECK_THROWS_AS(currency_set::from_codes({"EUR", "XXZ"}), std::invalid_argument);
+
+    const currency unit = mc::register_currency({"QSU", "Quest Set Unit", ""});
+    CHECK(currency_set::from_codes({"QSU"}).contains(unit));
+}
+
+TEST_CASE("Predefined currency sets", "[currency_set]") {
+    CHECK(mc::eur_pegged_currencies.contains(currency::XOF));
+    CHECK(mc::eur_pegged_currencies.contains(currency::BGN));
+    CHECK_FALSE(mc::eur_pegged_currencies.contains(currency::EUR));
+    CHECK(mc::usd_pegged_currencies.contains(currency::HKD));
+    CHECK(mc::zero_decimal_currencies.contains(currency::KRW));
+    CHECK_FALSE(mc::zero_decimal_currencies.contains(currency::USD));
+    CHECK(mc::three_decimal_currencies.contains(currency::KWD));
+    for (currency c : mc::zero_decimal_currencies) {
+        CHECK(mc::minor_units(c) == 0);
+    }
+}
+
+TEST_CASE("Filtering a column by a currency set", "[currency_set]") {
+    const currency_set set{currency::EUR, currency::ZWD, static_cast<currency>(200)};
+    std::uint64_t state = 88172645463325252ULL;
+    for (std::size_t n : {0, 1, 63, 64, 65, 130, 1000}) {
+        mc::money_column column;
+        for (std::size_t i = 0; i < n; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            const std::uint8_t pick[] = {static_cast<std::uint8_t>(currency::EUR), static_cast<std::uint8_t>(currency::USD), 200, 255,
+                    static_cast<std::uint8_t>(state >> 32)};
+            column.push_back(static_cast<currency>(pick[state % 5]), static_cast<std::int64_t>(i));
+        }
+        std::vector<mc::bitmask> selection((n + 63) / 64, ~mc::bitmask(0));
+        const std::size_t selected = mc::filter(column, set, selection.data());
+
+        std::size_t expected = 0;
+        bool same = true;
+        for (std::size_t i = 0; i < n; ++i) {
+            const bool member = set.contains(column.currency(i));
+            same = same && ((selection[i / 64] >> (i % 64)) & 1) == member;
+            expected += member;
+        }
+        CAPTURE(n);
+        CHECK(same);
+        CHECK(selected == expected);
+    }
+}
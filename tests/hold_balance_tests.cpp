@@ -0,0 +1,134 @@
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "currency.hpp"
+#include "hold_balance.hpp"
+#include "money.hpp"
+
+using mc::currency;
+using mc::hold_balance;
+using mc::money;
+
+TEST_CASE("hold_balance reserve, capture and release", "[hold_balance]") {
+    hold_balance balance(currency::USD, 1000);
+
+    SECTION("Initial state") {
+        REQUIRE(balance.currency() == currency::USD);
+        REQUIRE(balance.load().available == 1000);
+        REQUIRE(balance.load().held == 0);
+        REQUIRE(balance.available() == money::from_amount(currency::USD, 1000));
+        REQUIRE(balance.held() == money(currency::USD));
+    }
+
+    SECTION("Reserve then capture") {
+        REQUIRE(balance.reserve(300));
+        REQUIRE(balance.load().available == 700);
+        REQUIRE(balance.load().held == 300);
+        REQUIRE(balance.capture(300));
+        REQUIRE(balance.load().available == 700);
+        REQUIRE(balance.load().held == 0);
+    }
+
+    SECTION("Reserve then release") {
+        REQUIRE(balance.reserve(300));
+        REQUIRE(balance.release(300));
+        REQUIRE(balance.load().available == 1000);
+        REQUIRE(balance.load().held == 0);
+    }
+
+    SECTION("Partial capture releases the rest of the hold") {
+        REQUIRE(balance.reserve(300));
+        REQUIRE(balance.capture(250, 300));
+        REQUIRE(balance.load().available == 750);
+        REQUIRE(balance.load().held == 0);
+        REQUIRE_FALSE(balance.capture(301, 300));
+    }
+
+    SECTION("Failures leave the balance unchanged") {
+        REQUIRE_FALSE(balance.reserve(1001));
+        REQUIRE_FALSE(balance.capture(1));
+        REQUIRE_FALSE(balance.release(1));
+        REQUIRE(balance.reserve(100));
+        REQUIRE_FALSE(balance.capture(101));
+        REQUIRE_FALSE(balance.capture(100, 200));
+        REQUIRE_FALSE(balance.credit(UINT64_MAX));
+        REQUIRE(balance.load().available == 900);
+        REQUIRE(balance.load().held == 100);
+    }
+
+    SECTION("Credit") {
+        REQUIRE(balance.credit(500));
+        REQUIRE(balance.load().available == 1500);
+    }
+}
+
+TEST_CASE("hold_balance invariants under heavy concurrency", "[hold_balance][concurrency]") {
+    const std::uint64_t initial = 100000;
+    const int threads = 8;
+    const int operations = 20000;
+    hold_balance balance(currency::EUR, initial);
+
+    std::atomic<std::uint64_t> captured(0);
+    std::atomic<bool> done(false);
+    std::atomic<bool> consistent(true);
+
+    // the total may only shrink by captured funds, and a snapshot is never torn
+    std::thread observer([&] {
+        std::uint64_t last_total = initial;
+        while (!done.load()) {
+            const auto s = balance.load();
+            const std::uint64_t total = s.available + s.held;
+            if (s.available > initial || s.held > initial || total > last_total) {
+                consistent.store(false);
+            }
+            last_total = total;
+        }
+    });
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::mt19937 random(t);
+            std::uniform_int_distribution<std::uint64_t> amounts(1, 50);
+            for (int i = 0; i < operations; ++i) {
+                const std::uint64_t amount = amounts(random);
+                if (!balance.reserve(amount)) {
+                    continue;
+                }
+                // our own hold is still there, so completing it must succeed
+                bool completed = false;
+                switch (random() % 3) {
+                    case 0:
+                        completed = balance.capture(amount);
+                        captured += amount;
+                        break;
+                    case 1:
+                        completed = balance.release(amount);
+                        break;
+                    default: {
+                        const std::uint64_t part = amount / 2;
+                        completed = balance.capture(part, amount);
+                        captured += part;
+                    }
+                }
+                if (!completed) {
+                    consistent.store(false);
+                }
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    done.store(true);
+    observer.join();
+
+    const auto s = balance.load();
+    REQUIRE(consistent.load());
+    REQUIRE(s.held == 0);
+    REQUIRE(s.available + captured.load() == initial);
+}
@@ -0,0 +1,252 @@
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "currency.hpp"
+#include "journal.hpp"
+#include "ledger.hpp"
+#include "money.hpp"
+
+using mc::currency;
+using mc::leg;
+using mc::money;
+
+namespace {
+    std::size_t file_size(const std::string& path) {
+        std::ifstream fin(path, std::ios::binary | std::ios::ate);
+        return static_cast<std::size_t>(fin.tellg());
+    }
+}
+
+TEST_CASE("journal_writer appends durable records", "[journal]") {
+    const std::string path = "money_tests_journal.bin";
+    std::remove(path.c_str());
+
+    SECTION("Records are read back in sequence order") {
+        {
+            mc::journal_writer journal(path);
+            REQUIRE(journal.append(leg::debit(1, money(currency::USD, 10))) == 1);
+            const leg entry[] = {leg::debit(2, money(currency::EUR, 5)), leg::credit(3, money(currency::EUR, 5))};
+            const auto last = journal.append(entry, 2);
+            REQUIRE(last == 3);
+            journal.wait_durable(last);
+            REQUIRE(journal.durable() >= 3);
+        }
+        const auto records = mc::read_journal(path);
+        REQUIRE(records.size() == 3);
+        REQUIRE(records[0].account == 1);
+        REQUIRE(records[0].to_leg().currency == currency::USD);
+        REQUIRE(records[0].amount == 1000);
+        REQUIRE(records[1].timestamp == records[2].timestamp);
+        REQUIRE(records[2].amount == -500);
+        REQUIRE(records[0].timestamp > 0);
+    }
+
+    SECTION("Reopening appends after a torn record") {
+        {
+            mc::journal_writer journal(path);
+            journal.append(leg::debit(1, money(currency::USD, 1)));
+        }
+        {
+            std::ofstream fout(path, std::ios::binary | std::ios::app);
+            fout << "torn";
+        }
+        {
+            mc::journal_writer journal(path);
+            journal.append(leg::debit(2, money(currency::USD, 2)));
+            journal.flush();
+        }
+        REQUIRE(file_size(path) == sizeof(mc::journal_header) + 2 * sizeof(mc::journal_record));
+        const auto records = mc::read_journal(path);
+        REQUIRE(records.size() == 2);
+        REQUIRE(records[1].account == 2);
+    }
+
+    SECTION("The latency bound commits incomplete batches") {
+        mc::journal_options options;
+        options.max_batch = 1 << 20;
+        options.max_latency = std::chrono::microseconds(2000);
+        options.sync = false;
+        mc::journal_writer journal(path, options);
+        journal.append(leg::debit(1, money(currency::USD, 1)));
+        const auto start = std::chrono::steady_clock::now();
+        while (journal.durable() < 1 && std::chrono::steady_clock::now() - start < std::chrono::seconds(10)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        REQUIRE(journal.durable() == 1);
+    }
+
+    SECTION("Files that are not journals are rejected") {
+        {
+            std::ofstream fout(path, std::ios::binary);
+            fout << "USD EUR 0.9\n and more text";
+        }
+        REQUIRE_THROWS_AS(mc::journal_writer(path), std::runtime_error);
+        REQUIRE_THROWS_AS(mc::read_journal(path), std::runtime_error);
+    }
+
+    std::remove(path.c_str());
+    REQUIRE_THROWS_AS(mc::read_journal(path), std::runtime_error);
+}
+
+TEST_CASE("Journal replay rebuilds ledger balances", "[journal]") {
+    const std::string path = "money_tests_journal.bin";
+    std::remove(path.c_str());
+    const std::size_t accounts = 1000;
+    const std::size_t producers = 4;
+    const std::size_t entries = 5000;
+
+    mc::ledger book;
+    mc::ledger restored;
+    for (std::size_t i = 0; i < accounts; ++i) {
+        book.open_account(i % 2 == 0 ? currency::USD : currency::EUR);
+        restored.open_account(i % 2 == 0 ? currency::USD : currency::EUR);
+    }
+
+    {
+        mc::journal_options options;
+        options.max_batch = 256;
+        options.queue_capacity = 1024;
+        mc::journal_writer journal(path, options);
+        std::vector<mc::journal_batch> batches(producers);
+        std::atomic<bool> durable{true};
+        std::vector<std::thread> threads;
+        for (std::size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                for (std::size_t e = 0; e < entries; ++e) {
+                    const auto from = static_cast<mc::account_id>((p * 7919 + e * 2) % accounts);
+                    const auto to = static_cast<mc::account_id>((p * 104729 + e * 6 + 2) % accounts);
+                    const currency c = from % 2 == 0 ? currency::USD : currency::EUR;
+                    const std::int64_t amount = static_cast<std::int64_t>(e % 97 + 1);
+                    const leg entry[] = {{to, c, amount}, {from, c, -amount}};
+                    batches[p].add(entry, 2);
+                    const auto sequence = journal.append(entry, 2);
+                    if (e % 1000 == 999) {
+                        journal.wait_durable(sequence);
+                        durable = durable && journal.durable() >= sequence;
+                    }
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        REQUIRE(durable);
+        for (const auto& batch : batches) {
+            REQUIRE(book.post(batch) == entries);
+        }
+    }
+
+    REQUIRE(mc::read_journal(path).size() == producers * entries * 2);
+    REQUIRE(mc::replay_journal(path, restored) == producers * entries * 2);
+    bool same_balances = true;
+    for (mc::account_id a = 0; a < accounts; ++a) {
+        same_balances = same_balances && restored.balance(a) == book.balance(a);
+    }
+    REQUIRE(same_balances);
+    REQUIRE(restored.trial_balance().is_zero());
+
+    mc::ledger empty;
+    REQUIRE_THROWS_AS(mc::replay_journal(path, empty), std::out_of_range);
+    mc::ledger euros;
+    for (std::size_t i = 0; i < accounts; ++i) {
+        euros.open_account(currency::EUR);
+    }
+    REQUIRE_THROWS_AS(mc::replay_journal(path, euros), std::invalid_argument);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Serial journal replay rejects a late record without applying any", "[journal]") {
+    const std::string path = "money_tests_journal_late.bin";
+    std::remove(path.c_str());
+    {
+        mc::journal_options options;
+        options.sync = false;
+        mc::journal_writer journal(path, options);
+        // more records than one replay chunk, the bad one last
+        for (std::size_t i = 0; i < 70000; ++i) {
+            journal.append(leg{static_cast<mc::account_id>(i % 2), currency::USD, 1});
+        }
+        journal.append(leg{2, currency::USD, 1});
+    }
+
+    mc::ledger book;
+    book.open_account(currency::USD);
+    book.open_account(currency::USD);
+    REQUIRE_THROWS_AS(mc::replay_journal(path, book), std::out_of_range);
+    REQUIRE(book.balance(0) == 0);
+    REQUIRE(book.balance(1) == 0);
+
+    book.open_account(currency::EUR);
+    REQUIRE_THROWS_AS(mc::replay_journal(path, book), std::invalid_argument);
+    REQUIRE(book.balance(0) == 0);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Parallel journal replay matches serial replay", "[journal]") {
+    const std::vector<std::string> paths = {"money_tests_segment_0.bin", "money_tests_segment_1.bin", "money_tests_segment_2.bin"};
+    const std::size_t accounts = 5003;
+    for (std::size_t s = 0; s < paths.size(); ++s) {
+        std::remove(paths[s].c_str());
+        mc::journal_options options;
+        options.sync = false;
+        mc::journal_writer journal(paths[s], options);
+        // the middle segment stays empty
+        const std::size_t records = s == 1 ? 0 : 30000 + s;
+        for (std::size_t i = 0; i < records; ++i) {
+            const auto account = static_cast<mc::account_id>((i * 7919 + s) % accounts);
+            journal.append(leg{account, account % 3 == 0 ? currency::MDL : currency::USD,
+                    static_cast<std::int64_t>(i % 1001) - 500});
+        }
+    }
+
+    auto open_accounts = [accounts](mc::ledger& book) {
+        for (std::size_t i = 0; i < accounts; ++i) {
+            book.open_account(i % 3 == 0 ? currency::MDL : currency::USD);
+        }
+    };
+    mc::ledger serial;
+    open_accounts(serial);
+    std::size_t records = 0;
+    for (const auto& path : paths) {
+        records += mc::replay_journal(path, serial);
+    }
+    REQUIRE(records == 60002);
+
+    for (std::size_t threads : {1, 2, 3, 8}) {
+        mc::ledger book;
+        open_accounts(book);
+        REQUIRE(mc::replay_journal(paths, book, threads) == records);
+        bool same_balances = true;
+        for (mc::account_id a = 0; a < accounts; ++a) {
+            same_balances = same_balances && book.balance(a) == serial.balance(a);
+        }
+        REQUIRE(same_balances);
+    }
+
+    SECTION("Rejected records leave the ledger unchanged") {
+        mc::ledger smaller;
+        for (std::size_t i = 0; i < accounts - 1; ++i) {
+            smaller.open_account(i % 3 == 0 ? currency::MDL : currency::USD);
+        }
+        REQUIRE_THROWS_AS(mc::replay_journal(paths, smaller, 4), std::out_of_range);
+        REQUIRE(smaller.balance(0) == 0);
+
+        mc::ledger dollars;
+        for (std::size_t i = 0; i < accounts; ++i) {
+            dollars.open_account(currency::USD);
+        }
+        REQUIRE_THROWS_AS(mc::replay_journal(paths, dollars, 4), std::invalid_argument);
+        REQUIRE(dollars.balance(1) == 0);
+    }
+
+    for (const auto& path : paths) {
+        std::remove(path.c_str());
+    }
+}
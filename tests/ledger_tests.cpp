@@ -0,0 +1,161 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "currency.hpp"
+#include "ledger.hpp"
+#include "money.hpp"
+#include "money_bag.hpp"
+
+using mc::currency;
+using mc::leg;
+using mc::money;
+using mc::posting_status;
+
+TEST_CASE("money_bag sums amounts per currency", "[money_bag]") {
+    mc::money_bag bag;
+    REQUIRE(bag.is_zero());
+
+    SECTION("Balanced movements") {
+        bag.add(money(currency::USD, 10));
+        bag.add(money(currency::EUR, 5));
+        REQUIRE(bag.size() == 2);
+        REQUIRE(bag.amount(currency::USD) == 1000);
+        bag.subtract(money(currency::USD, 10));
+        REQUIRE(bag.size() == 1);
+        bag.add(currency::EUR, -500);
+        REQUIRE(bag.is_zero());
+    }
+
+    SECTION("Adding bags") {
+        mc::money_bag other;
+        other.add(currency::USD, 100);
+        other.add(currency::GBP, -50);
+        bag.add(currency::USD, -100);
+        bag += other;
+        REQUIRE(bag.size() == 1);
+        REQUIRE(bag.amount(currency::USD) == 0);
+        REQUIRE(bag.amount(currency::GBP) == -50);
+        bag.clear();
+        REQUIRE(bag.is_zero());
+        REQUIRE(bag.amount(currency::GBP) == 0);
+    }
+
+    SECTION("Overflowing totals are rejected") {
+        const std::int64_t max = std::numeric_limits<std::int64_t>::max();
+        REQUIRE_THROWS_AS(bag.add(money::from_amount(currency::USD, UINT64_MAX)), std::overflow_error);
+        REQUIRE_THROWS_AS(bag.subtract(money::from_amount(currency::USD, std::uint64_t(1) << 63)), std::overflow_error);
+        bag.add(currency::USD, max);
+        REQUIRE_FALSE(bag.try_add(currency::USD, 1));
+        REQUIRE_THROWS_AS(bag.add(currency::USD, 1), std::overflow_error);
+        REQUIRE(bag.amount(currency::USD) == max);
+
+        mc::money_bag other;
+        other.add(currency::EUR, 7);
+        other.add(currency::USD, 1);
+        REQUIRE_THROWS_AS(bag += other, std::overflow_error);
+        REQUIRE(bag.amount(currency::EUR) == 0);
+        REQUIRE(bag.size() == 1);
+    }
+}
+
+TEST_CASE("ledger posts balanced journal entries", "[ledger]") {
+    mc::ledger book;
+    const auto cash = book.open_account(currency::USD);
+    const auto revenue = book.open_account(currency::USD);
+    const auto euros = book.open_account(currency::EUR);
+
+    SECTION("Accounts") {
+        REQUIRE(book.size() == 3);
+        REQUIRE(book.currency(euros) == currency::EUR);
+        REQUIRE(book.balance(cash) == 0);
+        REQUIRE_THROWS_AS(book.balance(3), std::out_of_range);
+    }
+
+    SECTION("Single entry") {
+        leg entry[] = {leg::debit(cash, money(currency::USD, 10)), leg::credit(revenue, money(currency::USD, 10))};
+        REQUIRE(book.post(entry, 2) == posting_status::posted);
+        REQUIRE(book.balance(cash) == 1000);
+        REQUIRE(book.balance(revenue) == -1000);
+        REQUIRE(book.trial_balance().is_zero());
+    }
+
+    SECTION("Rejected entries leave balances unchanged") {
+        leg unbalanced[] = {leg::debit(cash, money(currency::USD, 10)), leg::credit(revenue, money(currency::USD, 9))};
+        leg unknown[] = {leg::debit(cash, money(currency::USD, 1)), leg::credit(7, money(currency::USD, 1))};
+        leg mismatch[] = {leg::debit(cash, money(currency::EUR, 1)), leg::credit(euros, money(currency::EUR, 1))};
+        REQUIRE(book.post(unbalanced, 2) == posting_status::unbalanced);
+        REQUIRE(book.post(unknown, 2) == posting_status::unknown_account);
+        REQUIRE(book.post(mismatch, 2) == posting_status::currency_mismatch);
+        REQUIRE(book.post(nullptr, 0) == posting_status::empty);
+        REQUIRE(book.balance(cash) == 0);
+        REQUIRE(book.balance(revenue) == 0);
+        REQUIRE(book.balance(euros) == 0);
+    }
+
+    SECTION("Amounts beyond the signed range") {
+        REQUIRE_THROWS_AS(leg::debit(cash, money::from_amount(currency::USD, UINT64_MAX)), std::overflow_error);
+        REQUIRE_THROWS_AS(leg::credit(cash, money::from_amount(currency::USD, std::uint64_t(1) << 63)), std::overflow_error);
+
+        const std::int64_t max = std::numeric_limits<std::int64_t>::max();
+        leg overflowing[] = {leg{cash, currency::USD, max}, leg{cash, currency::USD, max}, leg{revenue, currency::USD, 2}};
+        leg lowest[] = {leg{cash, currency::USD, std::numeric_limits<std::int64_t>::min()}};
+        REQUIRE(book.post(overflowing, 3) == posting_status::unbalanced);
+        REQUIRE(book.post(lowest, 1) == posting_status::unbalanced);
+        REQUIRE(book.balance(cash) == 0);
+
+        leg entry[] = {leg::debit(cash, money(currency::USD, 1)), leg::credit(revenue, money(currency::USD, 1))};
+        REQUIRE(book.post(entry, 2) == posting_status::posted);
+    }
+
+    SECTION("Batch with rejected entries") {
+        mc::journal_batch batch;
+        batch.add({leg::debit(cash, money(currency::USD, 5)), leg::credit(revenue, money(currency::USD, 5))});
+        batch.add({leg::debit(cash, money(currency::USD, 5)), leg::credit(revenue, money(currency::USD, 4))});
+        batch.add({leg::debit(euros, money(currency::USD, 1)), leg::credit(revenue, money(currency::USD, 1))});
+        batch.add({leg::debit(cash, money(currency::USD, 2)), leg::credit(revenue, money(currency::USD, 1)),
+            leg::credit(revenue, money(currency::USD, 1))});
+        REQUIRE(batch.size() == 4);
+        REQUIRE(batch.legs() == 9);
+
+        std::vector<posting_status> statuses;
+        REQUIRE(book.post(batch, &statuses) == 2);
+        REQUIRE(statuses == std::vector<posting_status>{
+            posting_status::posted, posting_status::unbalanced,
+            posting_status::currency_mismatch, posting_status::posted});
+        REQUIRE(book.balance(cash) == 700);
+        REQUIRE(book.balance(revenue) == -700);
+        REQUIRE(book.trial_balance().is_zero());
+    }
+}
+
+TEST_CASE("ledger sharded batch posting matches serial posting", "[ledger][batch]") {
+    const std::size_t accounts = 1000;
+    const std::size_t entries = 200000;
+    mc::ledger sharded(4);
+    mc::ledger serial(1);
+    for (std::size_t i = 0; i < accounts; ++i) {
+        const currency c = i % 2 ? currency::USD : currency::EUR;
+        sharded.open_account(c);
+        serial.open_account(c);
+    }
+
+    mc::journal_batch batch;
+    batch.reserve(entries, entries * 2);
+    for (std::size_t e = 0; e < entries; ++e) {
+        const auto from = static_cast<mc::account_id>((e * 7919) % accounts);
+        const auto to = static_cast<mc::account_id>((from + 2 * (e % 13) + 2) % accounts);
+        const auto amount = static_cast<std::int64_t>(e % 1000 + 1);
+        const currency c = from % 2 ? currency::USD : currency::EUR;
+        batch.add({leg{to, c, amount}, leg{from, c, -amount}});
+    }
+
+    REQUIRE(sharded.post(batch) == entries);
+    REQUIRE(serial.post(batch) == entries);
+    for (mc::account_id a = 0; a < accounts; ++a) {
+        REQUIRE(sharded.balance(a) == serial.balance(a));
+    }
+    REQUIRE(sharded.trial_balance().is_zero());
+}
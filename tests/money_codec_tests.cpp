@@ -0,0 +1,109 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "currency.hpp"
+#include "money.hpp"
+#include "money_codec.hpp"
+#include "packed_money.hpp"
+
+using mc::currency;
+using mc::money;
+using mc::packed_money;
+
+TEST_CASE("Single values round trip through the binary codec", "[codec]") {
+    std::uint8_t buffer[mc::max_encoded_size];
+    packed_money decoded;
+
+    SECTION("Small, whole-unit and extreme amounts") {
+        const packed_money values[] = {
+            packed_money(currency::USD, 0),
+            packed_money(currency::USD, 12345),
+            packed_money(currency::EUR, -1),
+            packed_money(currency::MDL, 150000),
+            packed_money(currency::ZWD, packed_money::max_amount),
+            packed_money(currency::AED, packed_money::min_amount),
+        };
+        for (const packed_money& value : values) {
+            for (bool scale : {true, false}) {
+                const std::size_t n = mc::encode(value, buffer, scale);
+                REQUIRE(n <= mc::max_encoded_size);
+                REQUIRE(mc::decode(buffer, n, decoded) == n);
+                REQUIRE(decoded == value);
+                REQUIRE(mc::decode(buffer, n - 1, decoded) == 0);
+            }
+        }
+    }
+
+    SECTION("Encoded sizes") {
+        REQUIRE(mc::encode(money::from_amount(currency::USD, 1234), buffer) == 3);
+        REQUIRE(mc::encode(money::from_amount(currency::USD, 12345), buffer) == 4);
+        REQUIRE(mc::encode(money::from_amount(currency::USD, 150000), buffer) == 3);
+        REQUIRE(mc::encode(money::from_amount(currency::USD, 150000), buffer, false) == 4);
+        REQUIRE(mc::encode(packed_money(currency::USD, -5), buffer) == 2);
+    }
+
+    SECTION("Malformed input") {
+        const std::uint8_t unknown_currency[] = {200, 2};
+        REQUIRE(mc::decode(unknown_currency, 2, decoded) == 0);
+        const std::uint8_t endless[] = {1, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01};
+        REQUIRE(mc::decode(endless, sizeof(endless), decoded) == 0);
+    }
+}
+
+TEST_CASE("Arrays round trip through the binary codec", "[codec]") {
+    std::vector<money> values;
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        const std::uint64_t amount = i % 5 == 0 ? i * 100 : (i % 7 == 0 ? i * 1000003ULL * 1000003ULL : i);
+        values.push_back(money::from_amount(static_cast<currency>(i % mc::currency_count), amount));
+    }
+    std::vector<std::uint8_t> encoded;
+    mc::encode(values.data(), values.size(), encoded);
+
+    SECTION("Full decode") {
+        std::vector<money> decoded;
+        REQUIRE(mc::decode(encoded.data(), encoded.size(), decoded) == values.size());
+        REQUIRE(decoded == values);
+    }
+
+    SECTION("Decoding from an index skips whole groups") {
+        for (std::size_t first : {1, 16, 17, 500, 999, 1000, 2000}) {
+            std::vector<packed_money> decoded;
+            const std::size_t expected = first < values.size() ? values.size() - first : 0;
+            REQUIRE(mc::decode(encoded.data(), encoded.size(), decoded, first) == expected);
+            REQUIRE(decoded.size() == expected);
+            if (expected > 0) {
+                REQUIRE(decoded.front().to_money() == values[first]);
+                REQUIRE(decoded.back().to_money() == values.back());
+            }
+        }
+    }
+
+    SECTION("Signed values and single-byte groups") {
+        std::vector<packed_money> small;
+        for (int i = -20; i < 20; ++i) {
+            small.push_back(packed_money(currency::USD, i));
+        }
+        std::vector<std::uint8_t> bytes;
+        mc::encode(small.data(), small.size(), bytes, false);
+        REQUIRE(bytes.size() == 3 * 2 + 2 * small.size());
+        std::vector<packed_money> decoded;
+        REQUIRE(mc::decode(bytes.data(), bytes.size(), decoded) == small.size());
+        REQUIRE(decoded == small);
+
+        std::vector<money> as_money;
+        REQUIRE_THROWS_AS(mc::decode(bytes.data(), bytes.size(), as_money), std::logic_error);
+    }
+
+    SECTION("Malformed arrays") {
+        std::vector<packed_money> decoded;
+        REQUIRE_THROWS_AS(mc::decode(encoded.data(), encoded.size() - 1, decoded), std::invalid_argument);
+        std::vector<std::uint8_t> bad(encoded);
+        bad[0] = 0;
+        REQUIRE_THROWS_AS(mc::decode(bad.data(), bad.size(), decoded), std::invalid_argument);
+        bad = encoded;
+        bad[2] = 250;
+        REQUIRE_THROWS_AS(mc::decode(bad.data(), bad.size(), decoded), std::invalid_argument);
+    }
+}
@@ -0,0 +1,103 @@
+#include <catch2/catch_all.hpp>
+
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "currency.hpp"
+#include "money.hpp"
+#include "money_fmt.hpp"
+
+using mc::currency;
+using mc::money;
+
+namespace {
+    constexpr mc::money_spec parsed(std::string_view text) {
+        mc::money_spec spec;
+        bool valid = true;
+        mc::parse_money_spec(text.begin(), text.end(), spec, valid);
+        return spec;
+    }
+
+    static_assert(parsed("*^20.0s}").width == 20, "specs are parsed at compile time");
+    static_assert(parsed("*^20.0s}").fill == '*', "specs are parsed at compile time");
+    static_assert(!parsed(".0}").minor_units, "specs are parsed at compile time");
+
+    bool valid(std::string_view text) {
+        mc::money_spec spec;
+        bool ok = true;
+        const auto end = mc::parse_money_spec(text.begin(), text.end(), spec, ok);
+        return ok && (end == text.end() || *end == '}');
+    }
+
+    std::string written(const money& value, std::string_view text) {
+        mc::money_spec spec;
+        bool ok = true;
+        mc::parse_money_spec(text.begin(), text.end(), spec, ok);
+        std::string out;
+        mc::write_money(std::back_inserter(out), value, spec);
+        return out;
+    }
+}
+
+TEST_CASE("Money format specs", "[fmt]") {
+    CHECK(valid("}"));
+    CHECK(valid(""));
+    CHECK(valid("c}"));
+    CHECK(valid("s}"));
+    CHECK(valid(".0}"));
+    CHECK(valid(".2c}"));
+    CHECK(valid("<12}"));
+    CHECK(valid("_^12.0s}"));
+    CHECK_FALSE(valid("x}"));
+    CHECK_FALSE(valid(".1}"));
+    CHECK_FALSE(valid(".}"));
+    CHECK_FALSE(valid("1000}"));
+    CHECK_FALSE(valid("{<5}"));
+    CHECK_FALSE(valid("cs}"));
+}
+
+TEST_CASE("Money written by a spec", "[fmt]") {
+    const money usd = money::from_amount(currency::USD, 123450);
+    CHECK(written(usd, "}") == "1234,50 USD");
+    CHECK(written(usd, "c}") == "1234,50 USD");
+    CHECK(written(usd, "s}") == "1234,50 $");
+    CHECK(written(usd, ".0}") == "1235 USD");
+    CHECK(written(money::from_amount(currency::USD, 123499), ".0}") == "1235 USD");
+    CHECK(written(money::from_amount(currency::USD, 123449), ".0}") == "1234 USD");
+    CHECK(written(money::from_amount(currency::USD, 49), ".0}") == "0 USD");
+    CHECK(written(money::from_amount(currency::USD, UINT64_MAX), ".0}") == "184467440737095516 USD");
+    CHECK(written(money::from_amount(currency::USD, UINT64_MAX - 16), ".0}") == "184467440737095516 USD");
+    CHECK(written(money::from_amount(currency::USD, 5), "}") == "0,05 USD");
+    CHECK(written(usd, "12}") == " 1234,50 USD");
+    CHECK(written(usd, "*<12}") == "1234,50 USD*");
+    CHECK(written(usd, "*^14}") == "*1234,50 USD**");
+    CHECK(written(usd, "4}") == "1234,50 USD");
+    // the euro sign counts as one character
+    CHECK(written(money::from_amount(currency::EUR, 100), "-^8s}") == "-1,00 \xE2\x82\xAC-");
+}
+
+#if defined(FMT_VERSION)
+TEST_CASE("Money with fmt::format", "[fmt]") {
+    const money usd = money::from_amount(currency::USD, 123450);
+    CHECK(fmt::format(FMT_STRING("{}"), usd) == "1234,50 USD");
+    CHECK(fmt::format(FMT_STRING("{:s}"), usd) == "1234,50 $");
+    CHECK(fmt::format(FMT_STRING("{:.0}"), usd) == "1235 USD");
+    CHECK(fmt::format(FMT_STRING("[{:>13c}]"), usd) == "[  1234,50 USD]");
+    CHECK_THROWS_AS(fmt::format(fmt::runtime("{:x}"), usd), fmt::format_error);
+
+    fmt::memory_buffer out;
+    fmt::format_to(std::back_inserter(out), FMT_STRING("{} {}"), usd, money::from_amount(currency::EUR, 1));
+    CHECK(fmt::to_string(out) == "1234,50 USD 0,01 EUR");
+}
+#endif
+
+#if defined(__cpp_lib_format)
+TEST_CASE("Money with std::format", "[fmt]") {
+    const money usd = money::from_amount(currency::USD, 123450);
+    CHECK(std::format("{}", usd) == "1234,50 USD");
+    CHECK(std::format("{:s}", usd) == "1234,50 $");
+    CHECK(std::format("{:.0}", usd) == "1235 USD");
+    CHECK(std::format("[{:>13c}]", usd) == "[  1234,50 USD]");
+}
+#endif
@@ -0,0 +1,75 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "currency.hpp"
+#include "money.hpp"
+#include "money_format.hpp"
+
+using mc::currency;
+using mc::money;
+
+namespace {
+    std::string format(const money& value, const mc::format_options& options = mc::format_options()) {
+        char buffer[64];
+        return std::string(buffer, mc::format_to(buffer, value, options));
+    }
+}
+
+TEST_CASE("format_amount writes exact decimals", "[format]") {
+    char buffer[mc::max_amount_size];
+    const auto amount = [&](std::uint64_t value, char point = '.') {
+        return std::string(buffer, mc::format_amount(buffer, value, point));
+    };
+    CHECK(amount(0) == "0.00");
+    CHECK(amount(5) == "0.05");
+    CHECK(amount(12345) == "123.45");
+    CHECK(amount(100000, ',') == "1000,00");
+    CHECK(amount(~std::uint64_t(0)) == "184467440737095516.15");
+    CHECK(mc::to_code(currency::MDL) == "MDL");
+    CHECK(mc::to_code(static_cast<currency>(200)).empty());
+}
+
+TEST_CASE("format_to writes single values", "[format]") {
+    CHECK(format(money::from_amount(currency::USD, 20050)) == "200,50 USD");
+    CHECK(format(money::from_amount(currency::USD, 105)) == "1,05 USD");
+    CHECK(format(money::from_amount(currency::USD, 12345)) == money::from_amount(currency::USD, 12345).to_string());
+
+    mc::format_options options;
+    options.decimal_point = '.';
+    options.code = false;
+    CHECK(format(money::from_amount(currency::EUR, 7), options) == "0.07");
+    options.width = 8;
+    CHECK(format(money::from_amount(currency::EUR, 12345), options) == "  123.45");
+    options.fill = '*';
+    options.code = true;
+    options.width = 12;
+    CHECK(format(money::from_amount(currency::EUR, 12345), options) == "**123.45 EUR");
+    options.width = 3;
+    CHECK(format(money::from_amount(currency::EUR, 12345), options) == "123.45 EUR");
+    CHECK(format(money::from_amount(currency::ZWD, ~std::uint64_t(0))).size() == mc::max_money_size);
+}
+
+TEST_CASE("format_column writes all values into one buffer", "[format]") {
+    std::vector<money> values;
+    std::string expected;
+    for (std::uint64_t i = 0; i < 5000; ++i) {
+        values.push_back(money::from_amount(i % 2 ? currency::USD : currency::MDL, i * 1234567));
+        expected += format(values.back()) + "\n";
+    }
+    mc::output_buffer out;
+    out.append("statement\n");
+    mc::format_column(values.data(), values.size(), mc::format_options(), out);
+    CHECK(out.view() == "statement\n" + expected);
+
+    out.clear();
+    mc::format_options options;
+    options.separator = '\0';
+    options.code = false;
+    options.width = 10;
+    mc::format_column(values.data(), 3, options, out);
+    CHECK(out.view() == "      0,00  12345,67  24691,34");
+    CHECK(out.size() == 30);
+}
@@ -0,0 +1,82 @@
+#include <catch2/catch_all.hpp>
+
+#include <stdexcept>
+#include <string>
+
+#include "currency.hpp"
+#include "money.hpp"
+#include "money_formatter.hpp"
+
+using mc::currency;
+using mc::money;
+
+TEST_CASE("Formatters of built-in locales", "[formatter]") {
+    const money usd = money::from_amount(currency::USD, 123456789);
+    const money eur = money::from_amount(currency::EUR, 123456789);
+    const money inr = money::from_amount(currency::INR, 1234567890);
+
+    CHECK(mc::find_formatter("en_US").format(usd) == "$1,234,567.89");
+    CHECK(mc::find_formatter("de_DE").format(eur) == "1.234.567,89\xC2\xA0\xE2\x82\xAC");
+    CHECK(mc::find_formatter("fr_FR").format(eur) == "1\xE2\x80\xAF" "234\xE2\x80\xAF" "567,89\xC2\xA0\xE2\x82\xAC");
+    CHECK(mc::find_formatter("de_CH").format(money::from_amount(currency::CHF, 123456)) == "CHF\xC2\xA0" "1\xE2\x80\x99" "234.56");
+    CHECK(mc::find_formatter("en_IN").format(inr) == "\xE2\x82\xB9" "1,23,45,678.90");
+    CHECK(mc::find_formatter("ro_MD").format(money::from_amount(currency::MDL, 5)) == "0,05\xC2\xA0MDL");
+}
+
+TEST_CASE("Formatters write other currencies with their codes", "[formatter]") {
+    CHECK(mc::find_formatter("en_US").format(money::from_amount(currency::EUR, 100000)) == "EUR 1,000.00");
+    CHECK(mc::find_formatter("de_DE").format(money::from_amount(currency::USD, 100000)) == "1.000,00\xC2\xA0USD");
+}
+
+TEST_CASE("Formatters leave out the code of an unknown currency value", "[formatter]") {
+    const currency unknown = static_cast<currency>(mc::max_currency_count - 1);
+    REQUIRE(mc::to_code(unknown).empty());
+    CHECK(mc::find_formatter("en_US").format(money::from_amount(unknown, 100000)) == " 1,000.00");
+    CHECK(mc::find_formatter("de_DE").format(money::from_amount(unknown, 100000)) == "1.000,00\xC2\xA0");
+}
+
+TEST_CASE("Grouping boundaries", "[formatter]") {
+    const mc::money_formatter& en = mc::find_formatter("en_US");
+    CHECK(en.format(money::from_amount(currency::USD, 0)) == "$0.00");
+    CHECK(en.format(money::from_amount(currency::USD, 99999)) == "$999.99");
+    CHECK(en.format(money::from_amount(currency::USD, 100000)) == "$1,000.00");
+    CHECK(en.format(money::from_amount(currency::USD, 10000000)) == "$100,000.00");
+    CHECK(en.format(money::from_amount(currency::USD, 100000000)) == "$1,000,000.00");
+    CHECK(en.format(money::from_amount(currency::USD, UINT64_MAX)) == "$184,467,440,737,095,516.15");
+
+    const mc::money_formatter& in = mc::find_formatter("hi_IN");
+    CHECK(in.format(money::from_amount(currency::INR, 9999999)) == "\xE2\x82\xB9" "99,999.99");
+    CHECK(in.format(money::from_amount(currency::INR, 10000000)) == "\xE2\x82\xB9" "1,00,000.00");
+}
+
+TEST_CASE("Formatter cache", "[formatter]") {
+    CHECK(&mc::find_formatter("en_GB") == &mc::find_formatter("en_GB"));
+    CHECK(mc::find_formatter("en_GB").locale() == "en_GB");
+    CHECK_THROWS_AS(mc::find_formatter("xx_XX"), std::invalid_argument);
+
+    const mc::locale_rules rules{"en_MD", currency::MDL, "L", '.', " ", 3, 3, mc::symbol_placement::after, " "};
+    const mc::money_formatter& added = mc::add_locale(rules);
+    CHECK(&mc::find_formatter("en_MD") == &added);
+    CHECK(added.format(money::from_amount(currency::MDL, 123456)) == "1 234.56 L");
+    CHECK_THROWS_AS(mc::add_locale(rules), std::invalid_argument);
+
+    const mc::locale_rules builtin{"en_US", currency::USD, "$", '.', ",", 3, 3, mc::symbol_placement::before, ""};
+    CHECK_THROWS_AS(mc::add_locale(builtin), std::invalid_argument);
+}
+
+TEST_CASE("Formatter rules are validated", "[formatter]") {
+    CHECK_THROWS_AS(mc::money_formatter({"", currency::USD, "$", '.', ",", 3, 3, mc::symbol_placement::before, ""}), std::invalid_argument);
+    CHECK_THROWS_AS(mc::money_formatter({"x", currency::USD, "123456789", '.', ",", 3, 3, mc::symbol_placement::before, ""}), std::invalid_argument);
+    CHECK_THROWS_AS(mc::money_formatter({"x", currency::USD, "$", '.', ",,,,,", 3, 3, mc::symbol_placement::before, ""}), std::invalid_argument);
+    CHECK_THROWS_AS(mc::money_formatter({"x", currency::USD, "$", '.', ",", 3, 0, mc::symbol_placement::before, ""}), std::invalid_argument);
+
+    const mc::money_formatter plain({"x", currency::USD, "$", '.', "", 0, 0, mc::symbol_placement::before, ""});
+    CHECK(plain.format(money::from_amount(currency::USD, 123456789)) == "$1234567.89");
+}
+
+TEST_CASE("Formatter columns", "[formatter]") {
+    const money values[] = {money::from_amount(currency::USD, 100), money::from_amount(currency::USD, 123456)};
+    mc::output_buffer out;
+    mc::find_formatter("en_US").format_column(values, 2, out);
+    CHECK(out.view() == "$1.00\n$1,234.56\n");
+}
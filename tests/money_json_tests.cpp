@@ -0,0 +1,101 @@
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <vector>
+
+#include "currency.hpp"
+#include "money.hpp"
+#include "money_json.hpp"
+
+using mc::currency;
+using mc::money;
+
+namespace {
+    std::string to_json(const money& value) {
+        char buffer[mc::max_json_size];
+        return std::string(buffer, mc::write_json(value, buffer, sizeof (buffer)));
+    }
+
+    bool from_json(const std::string& text, money& value) {
+        return mc::read_json(text, value) == text.size();
+    }
+}
+
+TEST_CASE("Money values are written as JSON objects", "[json]") {
+    CHECK(to_json(money::from_amount(currency::USD, 12345)) == R"({"amount":"123.45","currency":"USD"})");
+    CHECK(to_json(money::from_amount(currency::EUR, 7)) == R"({"amount":"0.07","currency":"EUR"})");
+    CHECK(to_json(money::from_amount(currency::ZWD, ~std::uint64_t(0))).size() == mc::max_json_size);
+
+    char small[20];
+    CHECK(mc::write_json(money::from_amount(currency::USD, 1), small, sizeof (small)) == 0);
+
+    const std::vector<money> values = {
+        money::from_amount(currency::USD, 100),
+        money::from_amount(currency::MDL, 250075)
+    };
+    std::string buffer(200, '\0');
+    std::size_t length = mc::write_json(values.data(), values.size(), &buffer[0], buffer.size());
+    CHECK(buffer.substr(0, length) == R"([{"amount":"1.00","currency":"USD"},{"amount":"2500.75","currency":"MDL"}])");
+    // exact fit, then one character short
+    CHECK(mc::write_json(values.data(), values.size(), &buffer[0], length) == length);
+    CHECK(mc::write_json(values.data(), values.size(), &buffer[0], length - 1) == 0);
+    CHECK(mc::write_json(values.data(), 0, &buffer[0], 2) == 2);
+    CHECK(buffer.substr(0, 2) == "[]");
+}
+
+TEST_CASE("Money values are read from JSON objects", "[json]") {
+    money value(currency::AED);
+    REQUIRE(from_json(R"({"amount":"123.45","currency":"USD"})", value));
+    CHECK(value == money::from_amount(currency::USD, 12345));
+
+    // trailing whitespace is left to the caller
+    const std::string spaced = " {\n  \"currency\" : \"eur\",\t\"amount\": 17.5 } ";
+    CHECK(mc::read_json(spaced, value) == spaced.size() - 1);
+    CHECK(value == money::from_amount(currency::EUR, 1750));
+
+    REQUIRE(from_json(R"({"id":42,"amount":"3","note":"a, b","ok":true,"currency":"MDL","x":null})", value));
+    CHECK(value == money::from_amount(currency::MDL, 300));
+
+    REQUIRE(from_json(R"({"amount":"184467440737095516.15","currency":"USD"})", value));
+    CHECK(value.amount() == ~std::uint64_t(0));
+
+    const char* invalid[] = {
+        R"({"amount":"184467440737095516.16","currency":"USD"})",
+        R"({"amount":"1.234","currency":"USD"})",
+        R"({"amount":"1.","currency":"USD"})",
+        R"({"amount":"-1.00","currency":"USD"})",
+        R"({"amount":"","currency":"USD"})",
+        R"({"amount":"1.00","currency":"XYZ"})",
+        R"({"amount":"1.00"})",
+        R"({"amount":"1.00","amount":"2.00","currency":"USD"})",
+        R"({"amount":"1.00","currency":"USD","nested":{}})",
+        R"({"amount":"1.00","currency":"USD")",
+        R"({"amount":1e2,"currency":"USD"})",
+        R"(["amount","1.00"])"
+    };
+    for (const char* text : invalid) {
+        CAPTURE(text);
+        CHECK(mc::read_json(text, value) == 0);
+    }
+}
+
+TEST_CASE("JSON arrays round trip", "[json]") {
+    std::vector<money> values;
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        values.push_back(money::from_amount(i % 2 ? currency::USD : currency::JPY, i * i * 7919));
+    }
+    std::string text(values.size() * (mc::max_json_size + 1) + 2, '\0');
+    text.resize(mc::write_json(values.data(), values.size(), &text[0], text.size()));
+    REQUIRE_FALSE(text.empty());
+
+    std::vector<money> read(values.size(), money(currency::AED));
+    std::size_t count = 0;
+    CHECK(mc::read_json(text, read.data(), read.size(), count) == text.size());
+    CHECK(count == values.size());
+    CHECK(read == values);
+
+    CHECK(mc::read_json(text, read.data(), read.size() - 1, count) == 0);
+    CHECK(mc::read_json(" [ ] ", read.data(), 0, count) == 4);
+    CHECK(count == 0);
+    CHECK(mc::read_json("[{\"amount\":\"1\",\"currency\":\"USD\"},]", read.data(), read.size(), count) == 0);
+}
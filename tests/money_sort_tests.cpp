@@ -0,0 +1,79 @@
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "currency.hpp"
+#include "money.hpp"
+#include "money_column.hpp"
+#include "money_sort.hpp"
+
+using mc::currency;
+using mc::money;
+
+namespace {
+    std::uint64_t next_random(std::uint64_t& state) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+}
+
+TEST_CASE("Radix sort of money objects matches std::sort", "[money_sort]") {
+    std::uint64_t state = 88172645463325252ULL;
+    std::vector<money> values;
+    for (std::size_t i = 0; i < 10000; ++i) {
+        const std::uint64_t r = next_random(state);
+        const std::uint64_t amount = i % 3 == 0 ? r : r % 100000;
+        values.push_back(money::from_amount(static_cast<currency>(r % mc::currency_count), amount));
+    }
+    std::vector<money> expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    mc::radix_sort(values);
+    REQUIRE(values == expected);
+
+    std::vector<money> empty;
+    mc::radix_sort(empty);
+    REQUIRE(empty.empty());
+}
+
+TEST_CASE("Radix sort of a money column orders signed amounts", "[money_sort]") {
+    mc::money_column column;
+    column.push_back(currency::USD, 5);
+    column.push_back(currency::EUR, std::numeric_limits<std::int64_t>::max());
+    column.push_back(currency::USD, -7);
+    column.push_back(currency::EUR, std::numeric_limits<std::int64_t>::min());
+    column.push_back(currency::EUR, 0);
+    column.push_back(currency::USD, -7);
+
+    mc::radix_sort(column);
+
+    const std::int64_t amounts[] = {std::numeric_limits<std::int64_t>::min(), 0,
+        std::numeric_limits<std::int64_t>::max(), -7, -7, 5};
+    const currency currencies[] = {currency::EUR, currency::EUR, currency::EUR,
+        currency::USD, currency::USD, currency::USD};
+    REQUIRE(column.size() == 6);
+    for (std::size_t i = 0; i < column.size(); ++i) {
+        REQUIRE(column.amount(i) == amounts[i]);
+        REQUIRE(column.currency(i) == currencies[i]);
+    }
+}
+
+TEST_CASE("Radix sort of a random money column", "[money_sort]") {
+    std::uint64_t state = 2463534242ULL;
+    mc::money_column column;
+    for (std::size_t i = 0; i < 10000; ++i) {
+        const std::uint64_t r = next_random(state);
+        column.push_back(static_cast<currency>(r % 4), static_cast<std::int64_t>(r >> (i % 60)) - 1000);
+    }
+    mc::radix_sort(column);
+    for (std::size_t i = 1; i < column.size(); ++i) {
+        const bool ordered = column.currency(i - 1) < column.currency(i)
+                || (column.currency(i - 1) == column.currency(i) && column.amount(i - 1) <= column.amount(i));
+        REQUIRE(ordered);
+    }
+}
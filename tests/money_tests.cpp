@@ -1,6 +1,10 @@
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_all.hpp>
 
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
 #include "currency.hpp"
 #include "money.hpp"
 
@@ -78,6 +82,14 @@ TEST_CASE("Money constructors", "[money][constructors]") {
         REQUIRE(m.amount() == 0);
     }
     
+    SECTION("Exact amount in smallest units") {
+        money m = money::from_amount(currency::USD, 9007199254740993ULL);
+        REQUIRE(m.currency() == currency::USD);
+        REQUIRE(m.amount() == 9007199254740993ULL);
+        REQUIRE(m.integral() == 90071992547409ULL);
+        REQUIRE(m.part() == 93);
+    }
+    
     SECTION("Currency and amount constructor") {
         money m(currency::EUR, 123.45);
         REQUIRE(m.currency() == currency::EUR);
@@ -375,4 +387,42 @@ TEST_CASE("Money precision tests", "[money][precision]") {
         // Should handle division remainder appropriately
         REQUIRE(result.part() <= 99);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Money stream output", "[money][stream]") {
+    std::ostringstream os;
+    os << money::from_amount(currency::USD, 123405) << ';' << money::from_amount(currency::EUR, 5);
+    REQUIRE(os.str() == "1234,05 USD;0,05 EUR");
+
+    std::ostringstream padded;
+    padded << std::setw(12) << money::from_amount(currency::USD, 100) << '|'
+           << std::left << std::setfill('*') << std::setw(10) << money::from_amount(currency::USD, 100) << '|'
+           << money::from_amount(currency::USD, 100);
+    REQUIRE(padded.str() == "    1,00 USD|1,00 USD**|1,00 USD");
+
+    std::ostringstream narrow;
+    narrow << std::setw(3) << money::from_amount(currency::GBP, 123456);
+    REQUIRE(narrow.str() == "1234,56 GBP");
+}
+
+TEST_CASE("Money ordering", "[money][ordering]") {
+    const money eur_small = money::from_amount(currency::EUR, 5);
+    const money eur_large = money::from_amount(currency::EUR, 500);
+    const money usd_small = money::from_amount(currency::USD, 1);
+
+    REQUIRE(eur_small < eur_large);
+    REQUIRE(eur_large < usd_small);
+    REQUIRE(eur_small <= money::from_amount(currency::EUR, 5));
+    REQUIRE(usd_small > eur_large);
+    REQUIRE(usd_small >= usd_small);
+    REQUIRE(eur_small != eur_large);
+    REQUIRE_FALSE(eur_small != money::from_amount(currency::EUR, 5));
+    REQUIRE(eur_small.compare(eur_large) < 0);
+    REQUIRE(eur_large.compare(eur_small) > 0);
+    REQUIRE(eur_small.compare(money::from_amount(currency::EUR, 5)) == 0);
+    REQUIRE(money::from_amount(currency::USD, 0) > money::from_amount(currency::EUR, std::numeric_limits<std::uint64_t>::max()));
+#if defined(MC_HAS_THREE_WAY_COMPARISON)
+    REQUIRE((eur_small <=> eur_large) == std::strong_ordering::less);
+    REQUIRE((usd_small <=> usd_small) == std::strong_ordering::equal);
+#endif
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "currency.hpp"
+#include "money.hpp"
+#include "money_bag.hpp"
+#include "packed_money.hpp"
+
+using mc::currency;
+using mc::money;
+using mc::packed_money;
+
+TEST_CASE("packed_money stores amount and currency in one word", "[packed_money]") {
+    SECTION("Construction and accessors") {
+        constexpr packed_money value(currency::EUR, -12345);
+        static_assert(value.amount() == -12345, "amount is unpacked at compile time");
+        REQUIRE(value.currency() == currency::EUR);
+        REQUIRE(packed_money::from_bits(value.bits()) == value);
+        REQUIRE(packed_money(currency::USD, packed_money::max_amount).amount() == packed_money::max_amount);
+        REQUIRE(packed_money(currency::ZWD, packed_money::min_amount).amount() == packed_money::min_amount);
+        REQUIRE(packed_money(currency::ZWD, packed_money::min_amount).currency() == currency::ZWD);
+        REQUIRE_THROWS_AS(packed_money(currency::USD, packed_money::max_amount + 1), std::overflow_error);
+        REQUIRE_THROWS_AS(packed_money(currency::USD, packed_money::min_amount - 1), std::overflow_error);
+    }
+
+    SECTION("Lossless conversion from and to money") {
+        const money m = money::from_amount(currency::MDL, 1234567);
+        const packed_money p(m);
+        REQUIRE(p.amount() == 1234567);
+        REQUIRE(p.to_money() == m);
+        REQUIRE_THROWS_AS(packed_money(money::from_amount(currency::MDL, 1ULL << 55)), std::overflow_error);
+        REQUIRE_THROWS_AS(packed_money(currency::MDL, -1).to_money(), std::logic_error);
+    }
+
+    SECTION("Arithmetic") {
+        packed_money value(currency::USD, 100);
+        value += packed_money(currency::USD, -250);
+        REQUIRE(value.amount() == -150);
+        REQUIRE(value.currency() == currency::USD);
+        value -= packed_money(currency::USD, -1150);
+        REQUIRE(value == packed_money(currency::USD, 1000));
+        REQUIRE(value + value == packed_money(currency::USD, 2000));
+        REQUIRE(value - value == packed_money(currency::USD, 0));
+        REQUIRE_THROWS_AS(value += packed_money(currency::EUR, 1), std::logic_error);
+        packed_money big(currency::USD, packed_money::max_amount);
+        REQUIRE_THROWS_AS(big += packed_money(currency::USD, 1), std::overflow_error);
+        packed_money small(currency::USD, packed_money::min_amount);
+        REQUIRE_THROWS_AS(small -= packed_money(currency::USD, 1), std::overflow_error);
+        REQUIRE(small.amount() == packed_money::min_amount);
+    }
+}
+
+TEST_CASE("packed_money kernels", "[packed_money]") {
+    std::vector<money> values;
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        values.push_back(money::from_amount(i % 3 == 0 ? currency::USD : currency::EUR, i * 1000003));
+    }
+    std::vector<packed_money> packed(values.size());
+    mc::pack(values.data(), values.size(), packed.data());
+
+    SECTION("Sums") {
+        std::int64_t usd = 0;
+        std::int64_t eur = 0;
+        for (const money& m : values) {
+            (m.currency() == currency::USD ? usd : eur) += static_cast<std::int64_t>(m.amount());
+        }
+        std::int64_t total = -1;
+        REQUIRE(mc::sum(packed.data(), packed.size(), currency::USD, total));
+        REQUIRE(total == usd);
+        REQUIRE(mc::sum(packed.data(), packed.size(), currency::EUR, total));
+        REQUIRE(total == eur);
+        REQUIRE(mc::sum(packed.data(), packed.size(), currency::GBP, total));
+        REQUIRE(total == 0);
+
+        mc::money_bag totals;
+        mc::sum(packed.data(), packed.size(), totals);
+        REQUIRE(totals.size() == 2);
+        REQUIRE(totals.amount(currency::USD) == usd);
+        REQUIRE(totals.amount(currency::EUR) == eur);
+    }
+
+    SECTION("Overflowing sums are reported") {
+        std::vector<packed_money> large(512, packed_money(currency::USD, packed_money::max_amount));
+        std::int64_t total = 0;
+        REQUIRE(mc::sum(large.data(), 255, currency::USD, total));
+        REQUIRE(total == 255 * packed_money::max_amount);
+        REQUIRE_FALSE(mc::sum(large.data(), large.size(), currency::USD, total));
+        std::vector<packed_money> low(512, packed_money(currency::USD, packed_money::min_amount));
+        REQUIRE_FALSE(mc::sum(low.data(), low.size(), currency::USD, total));
+
+        mc::money_bag totals;
+        totals.add(currency::EUR, 5);
+        REQUIRE_THROWS_AS(mc::sum(large.data(), large.size(), totals), std::overflow_error);
+        REQUIRE(totals.size() == 1);
+        REQUIRE(totals.amount(currency::USD) == 0);
+        REQUIRE(totals.amount(currency::EUR) == 5);
+    }
+
+    SECTION("Element-wise addition") {
+        std::vector<packed_money> out(packed.size());
+        REQUIRE(mc::add(packed.data(), packed.data(), out.data(), packed.size()));
+        for (std::size_t i = 0; i < packed.size(); ++i) {
+            REQUIRE(out[i] == packed_money(packed[i].currency(), packed[i].amount() * 2));
+        }
+
+        std::vector<packed_money> other(packed);
+        other[500] = packed_money(currency::GBP, 1);
+        REQUIRE_FALSE(mc::add(packed.data(), other.data(), out.data(), packed.size()));
+
+        const packed_money big[] = {packed_money(currency::USD, packed_money::max_amount)};
+        const packed_money one[] = {packed_money(currency::USD, 1)};
+        packed_money sum[1];
+        REQUIRE_FALSE(mc::add(big, one, sum, 1));
+    }
+
+    SECTION("Overflowing values cannot be packed") {
+        values[7] = money::from_amount(currency::USD, ~0ULL);
+        REQUIRE_THROWS_AS(mc::pack(values.data(), values.size(), packed.data()), std::overflow_error);
+    }
+}
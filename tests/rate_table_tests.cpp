@@ -0,0 +1,251 @@
+#include <catch2/catch_all.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "currency.hpp"
+#include "money.hpp"
+#include "rate_table.hpp"
+#include "rate_watcher.hpp"
+
+using mc::currency;
+using mc::money;
+
+namespace {
+    void write_file(const std::string& path, const std::string& contents) {
+        std::ofstream fout(path, std::ios::binary | std::ios::trunc);
+        fout << contents;
+    }
+}
+
+TEST_CASE("find_currency() resolves ISO codes without allocating", "[currency][find_currency]") {
+    currency c = currency::AED;
+
+    SECTION("Upper and lower case codes") {
+        REQUIRE(mc::find_currency("USD", c));
+        REQUIRE(c == currency::USD);
+        REQUIRE(mc::find_currency("eur", c));
+        REQUIRE(c == currency::EUR);
+        REQUIRE(mc::find_currency("mDl", c));
+        REQUIRE(c == currency::MDL);
+    }
+
+    SECTION("First and last currencies in enum") {
+        REQUIRE(mc::find_currency("AED", c));
+        REQUIRE(c == currency::AED);
+        REQUIRE(mc::find_currency("ZWD", c));
+        REQUIRE(c == currency::ZWD);
+    }
+
+    SECTION("Invalid codes") {
+        REQUIRE_FALSE(mc::find_currency("XYZ", c));
+        REQUIRE_FALSE(mc::find_currency("US", c));
+        REQUIRE_FALSE(mc::find_currency("USDX", c));
+        REQUIRE_FALSE(mc::find_currency("U$D", c));
+        REQUIRE_FALSE(mc::find_currency("", c));
+    }
+}
+
+TEST_CASE("rate_table stores rates per currency pair", "[rates]") {
+    mc::rate_table table;
+
+    SECTION("Identity rate is always known") {
+        REQUIRE(table.has(currency::USD, currency::USD));
+        REQUIRE(table.rate(currency::USD, currency::USD) == 1.);
+    }
+
+    SECTION("Unknown rate throws") {
+        REQUIRE_FALSE(table.has(currency::USD, currency::EUR));
+        REQUIRE_THROWS_AS(table.rate(currency::USD, currency::EUR), mc::unknown_rate);
+    }
+
+    SECTION("Set and convert") {
+        table.set(currency::USD, currency::MDL, 17.1539);
+        REQUIRE(table.has(currency::USD, currency::MDL));
+        REQUIRE_FALSE(table.has(currency::MDL, currency::USD));
+        money lei = table.convert(money(currency::USD, 200), currency::MDL);
+        REQUIRE(lei.currency() == currency::MDL);
+        REQUIRE(lei.integral() == 3430);
+        REQUIRE(lei.part() == 78);
+    }
+
+    SECTION("Non-positive rates are rejected") {
+        REQUIRE_THROWS_AS(table.set(currency::USD, currency::EUR, 0.), std::invalid_argument);
+        REQUIRE_THROWS_AS(table.set(currency::USD, currency::EUR, -1.), std::invalid_argument);
+    }
+}
+
+TEST_CASE("rate_table converts at bid, ask and mid rates", "[rates][two_sided]") {
+    mc::rate_table table;
+    table.set(currency::USD, currency::MDL, mc::two_sided_rate{{17., 18.}});
+
+    SECTION("Quote sides") {
+        const auto& quote = table.quote(currency::USD, currency::MDL);
+        REQUIRE(quote.bid() == 17.);
+        REQUIRE(quote.ask() == 18.);
+        REQUIRE(quote.mid() == 17.5);
+        REQUIRE(quote.at(mc::side::bid) == 17.);
+        REQUIRE(quote.at(mc::side::ask) == 18.);
+        REQUIRE(table.rate(currency::USD, currency::MDL) == 17.5);
+    }
+
+    SECTION("Single value conversion per side") {
+        money cash(currency::USD, 100);
+        REQUIRE(table.convert(cash, currency::MDL, mc::side::bid).amount() == 170000);
+        REQUIRE(table.convert(cash, currency::MDL, mc::side::ask).amount() == 180000);
+        REQUIRE(table.convert(cash, currency::MDL).amount() == 175000);
+    }
+
+    SECTION("Batch conversion matches single conversions") {
+        table.set(currency::EUR, currency::MDL, mc::two_sided_rate{{19., 20.}});
+        std::vector<money> values = {
+            money(currency::USD, 1), money(currency::EUR, 2.5), money(currency::USD, 1000.25)
+        };
+        std::vector<money> bid, ask;
+        table.convert(values.data(), values.size(), currency::MDL, bid, ask);
+        REQUIRE(bid.size() == values.size());
+        REQUIRE(ask.size() == values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            REQUIRE(bid[i] == table.convert(values[i], currency::MDL, mc::side::bid));
+            REQUIRE(ask[i] == table.convert(values[i], currency::MDL, mc::side::ask));
+        }
+    }
+
+    SECTION("Batch conversion matches single conversions on random values") {
+        table.set(currency::EUR, currency::MDL, mc::two_sided_rate{{19.37, 19.93}});
+        table.set(currency::GBP, currency::MDL, mc::two_sided_rate{{0.93, 0.97}});
+        std::uint64_t state = 88172645463325252ULL;
+        const currency from[] = {currency::USD, currency::EUR, currency::GBP};
+        std::vector<money> values;
+        for (std::size_t i = 0; i < 20000; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            values.push_back(money::from_amount(from[state % 3], (state >> 8) % 10000000));
+        }
+        std::vector<money> bid, ask;
+        table.convert(values.data(), values.size(), currency::MDL, bid, ask);
+        std::size_t mismatches = 0;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            mismatches += !(bid[i] == table.convert(values[i], currency::MDL, mc::side::bid));
+            mismatches += !(ask[i] == table.convert(values[i], currency::MDL, mc::side::ask));
+        }
+        REQUIRE(mismatches == 0);
+    }
+
+    SECTION("Invalid quotes are rejected") {
+        REQUIRE_THROWS_AS(table.set(currency::USD, currency::EUR, mc::two_sided_rate{{2., 1.}}), std::invalid_argument);
+        REQUIRE_THROWS_AS(table.set(currency::USD, currency::EUR, mc::two_sided_rate{{0., 1.}}), std::invalid_argument);
+    }
+
+    SECTION("Unknown quote throws") {
+        REQUIRE_THROWS_AS(table.quote(currency::EUR, currency::USD), mc::unknown_rate);
+        REQUIRE_THROWS_AS(table.convert(money(currency::EUR, 1), currency::USD, mc::side::ask), mc::unknown_rate);
+    }
+}
+
+TEST_CASE("parse_rates() reads FROM TO RATE lines", "[rates][parse]") {
+
+    SECTION("Rates and their inverses") {
+        auto table = mc::parse_rates("USD EUR 0.5\nGBP USD 1.25\n");
+        REQUIRE(table.rate(currency::USD, currency::EUR) == 0.5);
+        REQUIRE(table.rate(currency::EUR, currency::USD) == 2.);
+        REQUIRE(table.rate(currency::GBP, currency::USD) == 1.25);
+        REQUIRE(table.rate(currency::USD, currency::GBP) == 0.8);
+    }
+
+    SECTION("Two-sided rates and their inverses") {
+        auto table = mc::parse_rates("USD EUR 0.5 0.8\n");
+        REQUIRE(table.quote(currency::USD, currency::EUR).bid() == 0.5);
+        REQUIRE(table.quote(currency::USD, currency::EUR).ask() == 0.8);
+        REQUIRE(table.quote(currency::EUR, currency::USD).bid() == 1.25);
+        REQUIRE(table.quote(currency::EUR, currency::USD).ask() == 2.);
+    }
+
+    SECTION("Last line is read once, with or without a trailing newline") {
+        auto table = mc::parse_rates("USD EUR 0.5\nUSD EUR 0.25");
+        REQUIRE(table.rate(currency::USD, currency::EUR) == 0.25);
+    }
+
+    SECTION("Blank lines, tabs and CRLF line endings") {
+        auto table = mc::parse_rates("\r\n  usd\teur  0.5 \r\n\n\nEUR MDL 20\r\n");
+        REQUIRE(table.rate(currency::USD, currency::EUR) == 0.5);
+        REQUIRE(table.rate(currency::EUR, currency::MDL) == 20.);
+    }
+
+    SECTION("Empty text") {
+        auto table = mc::parse_rates("");
+        REQUIRE_FALSE(table.has(currency::USD, currency::EUR));
+    }
+
+    SECTION("Malformed lines") {
+        REQUIRE_THROWS_AS(mc::parse_rates("USD EUR\n"), std::invalid_argument);
+        REQUIRE_THROWS_AS(mc::parse_rates("USD EUR abc\n"), std::invalid_argument);
+        REQUIRE_THROWS_AS(mc::parse_rates("USD EUR 0\n"), std::invalid_argument);
+        REQUIRE_THROWS_AS(mc::parse_rates("USD EUR 1.5 2 3\n"), std::invalid_argument);
+        REQUIRE_THROWS_AS(mc::parse_rates("USD EUR 2 1.5\n"), std::invalid_argument);
+        REQUIRE_THROWS_AS(mc::parse_rates("USD EUR 1.5x\n"), std::invalid_argument);
+        REQUIRE_THROWS_AS(mc::parse_rates("USDEUR 1.5\n"), std::invalid_argument);
+    }
+
+    SECTION("Unknown currency codes") {
+        REQUIRE_THROWS_AS(mc::parse_rates("USD XYZ 1.5\n"), mc::unknown_currency_shortname);
+    }
+}
+
+TEST_CASE("load_rates() reads a rate file", "[rates][load]") {
+    const std::string path = "money_tests_rates.txt";
+    write_file(path, "USD MDL 17.1539\nEUR USD 1.1\n");
+
+    auto table = mc::load_rates(path);
+    REQUIRE(table.rate(currency::USD, currency::MDL) == 17.1539);
+    REQUIRE(table.rate(currency::EUR, currency::USD) == 1.1);
+
+    std::remove(path.c_str());
+    REQUIRE_THROWS_AS(mc::load_rates(path), std::runtime_error);
+}
+
+TEST_CASE("rate_watcher swaps in reloaded tables", "[rates][watcher]") {
+    const std::string path = "money_tests_watched_rates.txt";
+    write_file(path, "USD EUR 0.5\n");
+
+    mc::rate_watcher watcher(path);
+    auto first = watcher.table();
+    REQUIRE(watcher.generation() == 1);
+    REQUIRE(first->rate(currency::USD, currency::EUR) == 0.5);
+
+    SECTION("Manual reload") {
+        write_file(path, "USD EUR 0.25\n");
+        REQUIRE(watcher.reload());
+        REQUIRE(watcher.generation() == 2);
+        REQUIRE(watcher.table()->rate(currency::USD, currency::EUR) == 0.25);
+        // readers holding the old table keep a consistent view
+        REQUIRE(first->rate(currency::USD, currency::EUR) == 0.5);
+    }
+
+    SECTION("Failed reload keeps the previous table") {
+        write_file(path, "USD EUR\n");
+        REQUIRE_FALSE(watcher.reload());
+        REQUIRE(watcher.generation() == 1);
+        REQUIRE(watcher.table()->rate(currency::USD, currency::EUR) == 0.5);
+    }
+
+#if defined(__linux__)
+    SECTION("Background reload on file change") {
+        watcher.start();
+        write_file(path, "USD EUR 0.125\n");
+        for (int i = 0; i < 200 && watcher.generation() == 1; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        watcher.stop();
+        REQUIRE(watcher.generation() >= 2);
+        REQUIRE(watcher.table()->rate(currency::USD, currency::EUR) == 0.125);
+    }
+#endif
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,95 @@
+#include <catch2/catch_all.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "currency.hpp"
+#include "money.hpp"
+#include "striped_money_counter.hpp"
+
+using mc::currency;
+using mc::money;
+using mc::striped_money_counter;
+
+TEST_CASE("striped_money_counter keeps per-currency totals", "[striped_counter]") {
+
+    SECTION("Stripe count is a power of two") {
+        REQUIRE(striped_money_counter(1).stripes() == 1);
+        REQUIRE(striped_money_counter(3).stripes() == 4);
+        REQUIRE(striped_money_counter(8).stripes() == 8);
+        REQUIRE(striped_money_counter().stripes() >= 1);
+    }
+
+    SECTION("Totals per currency") {
+        striped_money_counter counter(4);
+        counter.add(money(currency::USD, 10.5));
+        counter.add(currency::USD, 50);
+        counter.add(money(currency::EUR, 1));
+        REQUIRE(counter.amount(currency::USD) == 1100);
+        REQUIRE(counter.amount(currency::EUR) == 100);
+        REQUIRE(counter.amount(currency::GBP) == 0);
+        REQUIRE(counter.load(currency::USD) == money(currency::USD, 11));
+    }
+
+    SECTION("Negative totals") {
+        striped_money_counter counter(2);
+        counter.add(currency::USD, -5);
+        REQUIRE(counter.amount(currency::USD) == -5);
+        REQUIRE_THROWS_AS(counter.load(currency::USD), std::logic_error);
+    }
+
+    SECTION("Reset") {
+        striped_money_counter counter(2);
+        counter.add(currency::USD, 5);
+        counter.reset();
+        REQUIRE(counter.amount(currency::USD) == 0);
+    }
+
+    SECTION("Amounts beyond the signed range") {
+        striped_money_counter counter(2);
+        REQUIRE_THROWS_AS(counter.add(money::from_amount(currency::USD, UINT64_MAX)), std::overflow_error);
+        REQUIRE(counter.amount(currency::USD) == 0);
+    }
+}
+
+TEST_CASE("Thread slots of exited threads are reused", "[striped_counter][concurrency]") {
+    mc::impl::thread_slot_();
+    std::size_t first = 0;
+    std::thread([&] { first = mc::impl::thread_slot_(); }).join();
+    std::size_t second = 0;
+    std::thread([&] { second = mc::impl::thread_slot_(); }).join();
+    REQUIRE(second == first);
+
+    // live threads hold distinct slots
+    std::size_t a = 0;
+    std::size_t b = 0;
+    std::thread holder([&] {
+        a = mc::impl::thread_slot_();
+        std::thread([&] { b = mc::impl::thread_slot_(); }).join();
+    });
+    holder.join();
+    REQUIRE(a != b);
+    REQUIRE(a == first);
+}
+
+TEST_CASE("striped_money_counter under concurrency", "[striped_counter][concurrency]") {
+    const int threads = 8;
+    const int operations = 20000;
+
+    // fewer stripes than threads, so some threads share a stripe
+    striped_money_counter counter(4);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            const currency c = t % 2 ? currency::USD : currency::EUR;
+            for (int i = 0; i < operations; ++i) {
+                counter.add(c, 3);
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    REQUIRE(counter.amount(currency::USD) == 3LL * operations * threads / 2);
+    REQUIRE(counter.amount(currency::EUR) == 3LL * operations * threads / 2);
+}
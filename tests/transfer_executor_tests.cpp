@@ -0,0 +1,139 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "currency.hpp"
+#include "ledger.hpp"
+#include "money.hpp"
+#include "transfer_executor.hpp"
+
+using mc::currency;
+using mc::leg;
+using mc::money;
+using mc::transfer;
+using mc::transfer_status;
+
+namespace {
+    /// Opens accounts funded from a bank account, which is returned
+    mc::account_id open_funded(mc::ledger& book, std::size_t accounts, std::int64_t funds) {
+        const auto bank = book.open_account(currency::USD);
+        mc::journal_batch batch;
+        for (std::size_t i = 0; i < accounts; ++i) {
+            const auto account = book.open_account(currency::USD);
+            batch.add({{account, currency::USD, funds}, {bank, currency::USD, -funds}});
+        }
+        book.post(batch);
+        return bank;
+    }
+
+    /// Executes transfers one by one, the behaviour the executor must reproduce
+    std::vector<transfer_status> execute_serially(std::vector<std::int64_t>& balances, const std::vector<transfer>& transfers) {
+        std::vector<transfer_status> statuses;
+        for (const transfer& t : transfers) {
+            const auto amount = static_cast<std::int64_t>(t.amount);
+            if (balances[t.from] < amount) {
+                statuses.push_back(transfer_status::insufficient_funds);
+            } else {
+                balances[t.from] -= amount;
+                balances[t.to] += amount;
+                statuses.push_back(transfer_status::executed);
+            }
+        }
+        return statuses;
+    }
+}
+
+TEST_CASE("transfer_executor moves funds between accounts", "[transfer_executor]") {
+    mc::ledger book;
+    open_funded(book, 3, 1000);
+    const auto euros = book.open_account(currency::EUR);
+    mc::transfer_executor executor(book);
+    std::vector<transfer_status> statuses;
+
+    SECTION("Transfers see the effects of earlier ones") {
+        const std::vector<transfer> transfers = {
+            {2, 3, currency::USD, 1500},
+            {1, 2, currency::USD, 1000},
+            {2, 3, currency::USD, 1500},
+            {3, 1, currency::USD, 2500},
+        };
+        REQUIRE(executor.execute(transfers, statuses) == 3);
+        REQUIRE(statuses == std::vector<transfer_status>{
+            transfer_status::insufficient_funds, transfer_status::executed,
+            transfer_status::executed, transfer_status::executed});
+        REQUIRE(book.balance(1) == 2500);
+        REQUIRE(book.balance(2) == 500);
+        REQUIRE(book.balance(3) == 0);
+        REQUIRE(book.trial_balance().is_zero());
+    }
+
+    SECTION("Invalid transfers are rejected with a status") {
+        const std::vector<transfer> transfers = {
+            {1, 7, currency::USD, 10},
+            {1, euros, currency::USD, 10},
+            {1, 2, currency::EUR, 10},
+            {1, 2, currency::USD, static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) + 1},
+            {1, 1, currency::USD, 1000},
+        };
+        REQUIRE(executor.execute(transfers, statuses) == 1);
+        REQUIRE(statuses == std::vector<transfer_status>{
+            transfer_status::unknown_account, transfer_status::currency_mismatch,
+            transfer_status::currency_mismatch, transfer_status::invalid_amount,
+            transfer_status::executed});
+        REQUIRE(book.balance(1) == 1000);
+        REQUIRE(book.balance(2) == 1000);
+    }
+}
+
+TEST_CASE("transfer_executor matches serial execution", "[transfer_executor]") {
+    const std::size_t accounts = 50000;
+    const std::size_t hot = 4;
+    std::uint64_t state = 88172645463325252ULL;
+    auto next = [&state] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    // most transfers go between random accounts, some to and from a few hot merchants
+    std::vector<transfer> transfers;
+    for (std::size_t i = 0; i < 200000; ++i) {
+        const std::uint64_t r = next();
+        auto from = static_cast<mc::account_id>(r % accounts + 1);
+        auto to = static_cast<mc::account_id>((r >> 24) % accounts + 1);
+        if (r % 7 == 0) {
+            to = static_cast<mc::account_id>(r % hot + 1);
+        } else if (r % 31 == 0) {
+            from = static_cast<mc::account_id>((r >> 8) % hot + 1);
+        }
+        transfers.push_back(transfer{from, to, currency::USD, (r >> 40) % 3000});
+    }
+
+    for (std::size_t threads : {1, 2, 4}) {
+        mc::ledger book;
+        open_funded(book, accounts, 1000);
+        std::vector<std::int64_t> expected_balances(book.size());
+        for (mc::account_id a = 0; a < book.size(); ++a) {
+            expected_balances[a] = book.balance(a);
+        }
+        const auto expected = execute_serially(expected_balances, transfers);
+
+        mc::transfer_executor executor(book, threads);
+        std::vector<transfer_status> statuses;
+        const std::size_t executed = executor.execute(transfers, statuses);
+        REQUIRE(statuses == expected);
+        std::size_t expected_executed = 0;
+        for (auto s : expected) {
+            expected_executed += s == transfer_status::executed;
+        }
+        REQUIRE(executed == expected_executed);
+        bool same_balances = true;
+        for (mc::account_id a = 0; a < book.size(); ++a) {
+            same_balances = same_balances && book.balance(a) == expected_balances[a];
+        }
+        REQUIRE(same_balances);
+        REQUIRE(book.trial_balance().is_zero());
+    }
+}
@@ -0,0 +1,214 @@
+#include "transfer_executor.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+namespace mc {
+
+    namespace impl {
+        /// Smallest number of transfers per thread worth running a wave in parallel
+        constexpr std::size_t transfers_per_thread_ = 1 << 12;
+
+        /// A credit produced by a debit that succeeded, applied after the debits of the wave
+        struct pending_credit_ {
+            account_id account;
+            std::int64_t amount;
+        };
+
+        /// A range of the wave-ordered transfers run either by all threads or by one
+        struct wave_step_ {
+            std::size_t begin;
+            std::size_t end;
+            bool parallel;
+        };
+
+        /// Blocks the threads executing a batch until all of them finish a phase
+        class wave_barrier_ {
+            std::mutex _mutex;
+            std::condition_variable _released;
+            std::size_t _count;
+            std::size_t _waiting = 0;
+            std::size_t _generation = 0;
+        public:
+            explicit wave_barrier_(std::size_t count) : _count(count) {}
+
+            void wait() {
+                std::unique_lock<std::mutex> lock(_mutex);
+                const std::size_t generation = _generation;
+                if (++_waiting == _count) {
+                    _waiting = 0;
+                    ++_generation;
+                    _released.notify_all();
+                } else {
+                    _released.wait(lock, [this, generation] { return generation != _generation; });
+                }
+            }
+        };
+    }
+
+    transfer_executor::transfer_executor(ledger& book, std::size_t threads) :
+    _ledger(book),
+    _threads(threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads) {
+
+    }
+
+    std::size_t transfer_executor::execute(const transfer* transfers, std::size_t count, transfer_status* statuses) {
+        std::vector<std::int64_t>& balances = _ledger._balances;
+        const std::vector<mc::currency>& currencies = _ledger._currencies;
+        const std::size_t accounts = balances.size();
+
+        // Assign every valid transfer to the first wave after the previous
+        // operations it must follow: a debit follows everything on its
+        // account, a credit only the debits, since credits commute.
+        std::vector<std::uint32_t> wave(count, 0);
+        std::vector<std::uint32_t> last_any(accounts, 0);
+        std::vector<std::uint32_t> last_debit(accounts, 0);
+        std::uint32_t waves = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const transfer& t = transfers[i];
+            if (t.from >= accounts || t.to >= accounts) {
+                statuses[i] = transfer_status::unknown_account;
+            } else if (currencies[t.from] != t.currency || currencies[t.to] != t.currency) {
+                statuses[i] = transfer_status::currency_mismatch;
+            } else if (t.amount > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+                statuses[i] = transfer_status::invalid_amount;
+            } else {
+                const std::uint32_t w = std::max(last_any[t.from], last_debit[t.to]) + 1;
+                last_any[t.from] = w;
+                last_debit[t.from] = w;
+                last_any[t.to] = std::max(last_any[t.to], w);
+                wave[i] = w;
+                waves = std::max(waves, w);
+                statuses[i] = transfer_status::executed;
+            }
+        }
+
+        // order the valid transfers by wave, keeping batch order inside a wave
+        std::vector<std::size_t> offsets(static_cast<std::size_t>(waves) + 2, 0);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (wave[i] != 0) {
+                ++offsets[wave[i] + 1];
+            }
+        }
+        std::size_t largest = 0;
+        for (std::size_t w = 1; w <= waves; ++w) {
+            largest = std::max(largest, offsets[w + 1]);
+            offsets[w + 1] += offsets[w];
+        }
+        std::vector<std::size_t> order(offsets[waves + 1]);
+        {
+            std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+            for (std::size_t i = 0; i < count; ++i) {
+                if (wave[i] != 0) {
+                    order[next[wave[i]]++] = i;
+                }
+            }
+        }
+
+        auto run_serial = [&](std::size_t begin, std::size_t end) {
+            std::size_t executed = 0;
+            for (std::size_t k = begin; k < end; ++k) {
+                const std::size_t i = order[k];
+                const transfer& t = transfers[i];
+                const std::int64_t amount = static_cast<std::int64_t>(t.amount);
+                if (balances[t.from] < amount) {
+                    statuses[i] = transfer_status::insufficient_funds;
+                } else {
+                    balances[t.from] -= amount;
+                    balances[t.to] += amount;
+                    ++executed;
+                }
+            }
+            return executed;
+        };
+
+        const std::size_t threads = std::min(_threads, largest / impl::transfers_per_thread_);
+        if (threads <= 1) {
+            return run_serial(0, order.size());
+        }
+
+        // large waves run on all threads, runs of small waves on the first one
+        std::vector<impl::wave_step_> steps;
+        for (std::size_t w = 1; w <= waves; ++w) {
+            const bool parallel = offsets[w + 1] - offsets[w] >= threads * impl::transfers_per_thread_;
+            if (!parallel && !steps.empty() && !steps.back().parallel) {
+                steps.back().end = offsets[w + 1];
+            } else {
+                steps.push_back(impl::wave_step_{offsets[w], offsets[w + 1], parallel});
+            }
+        }
+
+        // credits[source * threads + target] holds the credits found by thread
+        // source for the accounts owned by thread target
+        std::vector<std::vector<impl::pending_credit_>> credits(threads * threads);
+        std::vector<std::size_t> executed(threads, 0);
+        impl::wave_barrier_ barrier(threads);
+
+        auto worker = [&](std::size_t self) {
+            for (const impl::wave_step_& step : steps) {
+                if (!step.parallel) {
+                    if (self == 0) {
+                        executed[0] += run_serial(step.begin, step.end);
+                    }
+                    barrier.wait();
+                    continue;
+                }
+
+                // debits: every source account appears once in a wave and is not credited in it
+                const std::size_t size = step.end - step.begin;
+                const std::size_t begin = step.begin + size * self / threads;
+                const std::size_t end = step.begin + size * (self + 1) / threads;
+                for (std::size_t target = 0; target < threads; ++target) {
+                    credits[self * threads + target].clear();
+                }
+                std::size_t moved = 0;
+                for (std::size_t k = begin; k < end; ++k) {
+                    const std::size_t i = order[k];
+                    const transfer& t = transfers[i];
+                    const std::int64_t amount = static_cast<std::int64_t>(t.amount);
+                    if (balances[t.from] < amount) {
+                        statuses[i] = transfer_status::insufficient_funds;
+                    } else {
+                        balances[t.from] -= amount;
+                        credits[self * threads + t.to % threads].push_back(impl::pending_credit_{t.to, amount});
+                        ++moved;
+                    }
+                }
+                executed[self] += moved;
+                barrier.wait();
+
+                // credits: every thread applies the ones for the accounts it owns
+                for (std::size_t source = 0; source < threads; ++source) {
+                    for (const impl::pending_credit_& c : credits[source * threads + self]) {
+                        balances[c.account] += c.amount;
+                    }
+                }
+                barrier.wait();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (std::size_t self = 1; self < threads; ++self) {
+            workers.emplace_back(worker, self);
+        }
+        worker(0);
+        for (auto& w : workers) {
+            w.join();
+        }
+
+        std::size_t total = 0;
+        for (std::size_t n : executed) {
+            total += n;
+        }
+        return total;
+    }
+
+    std::size_t transfer_executor::execute(const std::vector<transfer>& transfers, std::vector<transfer_status>& statuses) {
+        statuses.resize(transfers.size());
+        return execute(transfers.data(), transfers.size(), statuses.data());
+    }
+}
@@ -0,0 +1,86 @@
+/**
+ * @file transfer_executor.hpp
+ * @brief Deterministic parallel execution of transfer batches.
+ *
+ * Transfers move funds between two ledger accounts and are rejected when the
+ * source account cannot cover them. The executor partitions a batch into
+ * waves in which no account is debited twice or both debited and credited,
+ * then runs each wave across threads without locks. Every account sees its
+ * debits and credits in batch order, so the statuses and final balances are
+ * identical to executing the transfers one by one.
+ *
+ * @author Mihail Croitor
+ * @date 2025
+ */
+
+#ifndef TRANSFER_EXECUTOR_HPP
+#define TRANSFER_EXECUTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ledger.hpp"
+
+namespace mc {
+
+    /**
+     * @brief A movement of funds from one account to another.
+     */
+    struct transfer {
+        account_id from;        ///< Account the amount is taken from
+        account_id to;          ///< Account the amount is given to
+        mc::currency currency;  ///< Currency of the amount, must match both accounts
+        std::uint64_t amount;   ///< Amount in smallest currency units
+    };
+
+    /**
+     * @brief Outcome of executing a transfer.
+     */
+    enum class transfer_status : std::uint8_t {
+        executed,            ///< The funds were moved
+        insufficient_funds,  ///< The source balance is lower than the amount
+        unknown_account,     ///< An account was not opened in the ledger
+        currency_mismatch,   ///< The transfer currency differs from an account currency
+        invalid_amount       ///< The amount does not fit into a signed 64-bit balance
+    };
+
+    /**
+     * @brief Executes batches of transfers on a ledger in parallel waves.
+     *
+     * A transfer credits the source account and debits the destination, so
+     * the source balance must cover the amount. Credits to one account
+     * commute, so an account receiving many transfers does not split the
+     * batch into more waves; only debits are ordered.
+     */
+    class transfer_executor {
+        ledger& _ledger;      ///< Ledger holding the account balances
+        std::size_t _threads; ///< Maximum number of threads running a wave
+    public:
+        /**
+         * @brief Constructs an executor for a ledger.
+         * @param book The ledger whose balances the transfers move
+         * @param threads Maximum number of threads running a wave;
+         *                zero selects the number of hardware threads
+         */
+        explicit transfer_executor(ledger& book, std::size_t threads = 0);
+
+        /**
+         * @brief Executes a batch of transfers.
+         * @param transfers Pointer to the first transfer
+         * @param count Number of transfers
+         * @param statuses Receives one status per transfer, must hold count values
+         * @return The number of executed transfers
+         */
+        std::size_t execute(const transfer* transfers, std::size_t count, transfer_status* statuses);
+
+        /**
+         * @brief Executes a batch of transfers.
+         * @param transfers The transfers, in the order they must appear to execute
+         * @param statuses Receives one status per transfer
+         * @return The number of executed transfers
+         */
+        std::size_t execute(const std::vector<transfer>& transfers, std::vector<transfer_status>& statuses);
+    };
+}
+
+#endif /* TRANSFER_EXECUTOR_HPP */